@@ -137,6 +137,13 @@ class GHOST_ISystem {
    */
   static GHOST_TSuccess createSystem();
 
+  /**
+   * Creates the one and only system without display connection, windows and events are
+   * no-ops. Used to run without any graphical environment, e.g. on a server.
+   * \return An indication of success.
+   */
+  static GHOST_TSuccess createSystemBackground();
+
   /**
    * Disposes the one and only system.
    * \return An indication of success.
@@ -26,9 +26,10 @@
  */
 
 #include "GHOST_ISystem.h"
+#include "GHOST_SystemNULL.h"
 
 #if defined(WITH_HEADLESS)
-#  include "GHOST_SystemNULL.h"
+/* Pass. */
 #elif defined(WITH_GHOST_X11) && defined(WITH_GHOST_WAYLAND)
 #  include "GHOST_SystemWayland.h"
 #  include "GHOST_SystemX11.h"
@@ -86,6 +87,22 @@ GHOST_TSuccess GHOST_ISystem::createSystem()
   return success;
 }
 
+GHOST_TSuccess GHOST_ISystem::createSystemBackground()
+{
+  GHOST_TSuccess success;
+  if (!m_system) {
+    m_system = new GHOST_SystemNULL();
+    success = m_system != NULL ? GHOST_kSuccess : GHOST_kFailure;
+  }
+  else {
+    success = GHOST_kFailure;
+  }
+  if (success) {
+    success = m_system->init();
+  }
+  return success;
+}
+
 GHOST_TSuccess GHOST_ISystem::disposeSystem()
 {
   GHOST_TSuccess success = GHOST_kSuccess;
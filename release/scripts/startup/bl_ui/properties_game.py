@@ -511,6 +511,25 @@ class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
         row.active = gs.use_scene_hysteresis
         row.prop(gs, "scene_hysteresis_percentage", text="")
 
+class SCENE_PT_game_performance(SceneButtonsPanel, Panel):
+    bl_label = "Performance"
+    bl_options = {'DEFAULT_CLOSED'}
+    COMPAT_ENGINES = {'BLENDER_EEVEE'}
+
+    @classmethod
+    def poll(cls, context):
+        scene = context.scene
+        return (scene and scene.render.engine in cls.COMPAT_ENGINES)
+
+    def draw(self, context):
+        layout = self.layout
+        gs = context.scene.game_settings
+
+        col = layout.column()
+        col.prop(gs, "use_parallel_scenes")
+        col.prop(gs, "use_isolated_scene")
+        col.prop(gs, "use_threaded_physics")
+
 class SCENE_PT_game_console(SceneButtonsPanel, Panel):
     bl_label = "Game Python Console"
     bl_options = {'DEFAULT_CLOSED'}
@@ -603,6 +622,23 @@ class OBJECT_PT_levels_of_detail(ObjectButtonsPanel, Panel):
         row.menu("OBJECT_MT_lod_tools", text="", icon='TRIA_DOWN')
 
 
+class OBJECT_PT_game_replica_pool(ObjectButtonsPanel, Panel):
+    bl_label = "Replica Pool"
+    bl_options = {'DEFAULT_CLOSED'}
+    COMPAT_ENGINES = {'BLENDER_GAME', 'BLENDER_EEVEE'}
+
+    @classmethod
+    def poll(cls, context):
+        return context.engine in cls.COMPAT_ENGINES and context.object is not None
+
+    def draw(self, context):
+        layout = self.layout
+
+        game = context.object.game
+
+        layout.prop(game, "replica_pool_size", text="Size")
+
+
 classes = (
     PHYSICS_PT_game_physics,
     PHYSICS_PT_game_collision_bounds,
@@ -611,9 +647,11 @@ classes = (
     SCENE_PT_game_physics_obstacles,
     SCENE_PT_game_navmesh,
     SCENE_PT_game_hysteresis,
+    SCENE_PT_game_performance,
     SCENE_PT_game_console,
     OBJECT_MT_lod_tools,
     OBJECT_PT_levels_of_detail,
+    OBJECT_PT_game_replica_pool,
 )
 
 if __name__ == "__main__":  # only for live edit.
@@ -112,6 +112,9 @@ class RENDER_PT_game_debug(RenderButtonsPanel, Panel):
         row = col.row()
         col = row.column()
         col.prop(gs, "use_frame_rate")
+        sub = col.column()
+        sub.active = gs.use_frame_rate
+        sub.prop(gs, "use_interpolation")
 
         row = layout.row()
         row.prop(gs, "vsync")
@@ -408,7 +408,9 @@ typedef struct Object {
 
   short scaflag;    /* ui state for game logic */
   short scavisflag; /* more display settings for game logic */
-  short _pad53[2];
+  /** Hidden copies kept ready for reuse by Add Object. */
+  short replica_pool_size;
+  short _pad53;
 
   /* during realtime */
 
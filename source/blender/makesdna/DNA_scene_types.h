@@ -957,6 +957,10 @@ enum {
 // #define GAME_USE_UI_ANTI_FLICKER (1 << 20) /* deprecated */
 #define GAME_USE_VIEWPORT_RENDER (1 << 21)
 #define GAME_PYTHON_CONSOLE (1 << 22)
+#define GAME_USE_PARALLEL_SCENES (1 << 23)
+#define GAME_SCENE_ISOLATED (1 << 24)
+#define GAME_USE_THREADED_PHYSICS (1 << 25)
+#define GAME_USE_INTERPOLATION (1 << 26)
 /* Note: GameData.flag is now an int (max 32 flags). A short could only take 16 flags */
 
 /* GameData.playerflag */
@@ -2855,6 +2855,15 @@ static void rna_def_object_game_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Obstacle Radius", "Radius of object representation in obstacle simulation");
 
+  prop = RNA_def_property(srna, "replica_pool_size", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "replica_pool_size");
+  RNA_def_property_range(prop, 0, 1024);
+  RNA_def_property_ui_text(prop,
+                           "Replica Pool Size",
+                           "Number of hidden copies created at scene start and reused when this "
+                           "object (or the objects of the collection it instances) is added, "
+                           "instead of copying and freeing the object on each spawn");
+
   prop = RNA_def_property(srna, "friction", PROP_FLOAT, PROP_NONE);
   RNA_def_property_float_sdna(prop, NULL, "friction");
   RNA_def_property_range(prop, 0, 100);
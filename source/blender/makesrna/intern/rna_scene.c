@@ -5687,6 +5687,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
                            "Respect the frame rate from the Physics panel in the world properties "
                            "rather than rendering as many frames as possible");
 
+  prop = RNA_def_property(srna, "use_interpolation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_INTERPOLATION);
+  RNA_def_property_ui_text(prop,
+                           "Interpolation",
+                           "Render as many frames as possible and interpolate the objects "
+                           "between the last two logic frames, with a delay of one logic frame");
+
   prop = RNA_def_property(srna, "use_deprecation_warnings", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "flag", GAME_IGNORE_DEPRECATION_WARNINGS);
   RNA_def_property_ui_text(prop,
@@ -5710,6 +5717,27 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
       "Restrict the number of animation updates to the animation FPS (this is "
       "better for performance, but can cause issues with smooth playback)");
 
+  prop = RNA_def_property(srna, "use_parallel_scenes", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_PARALLEL_SCENES);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Scenes",
+                           "Step the logic and physics of isolated scenes concurrently "
+                           "(read from the starting scene)");
+
+  prop = RNA_def_property(srna, "use_isolated_scene", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_SCENE_ISOLATED);
+  RNA_def_property_ui_text(prop,
+                           "Isolated Scene",
+                           "The scene doesn't run python and doesn't interact with other "
+                           "scenes, it can be stepped in parallel with other isolated scenes");
+
+  prop = RNA_def_property(srna, "use_threaded_physics", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_THREADED_PHYSICS);
+  RNA_def_property_ui_text(prop,
+                           "Threaded Physics",
+                           "Use multiple threads to step the physics, not used when the scene "
+                           "contains soft bodies");
+
   prop = RNA_def_property(srna, "use_python_console", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PYTHON_CONSOLE);
   RNA_def_property_ui_text(prop, "Python Console", "Create a python interpreter console in game");
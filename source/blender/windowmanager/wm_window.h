@@ -94,6 +94,10 @@ void wm_window_ghostwindow_blenderplayer_ensure(struct wmWindowManager *wm,
                                                 void *ghostwin,
                                                 bool first_time_window);
 
+void wm_window_headless_blenderplayer_ensure(struct wmWindowManager *wm,
+                                             struct wmWindow *win,
+                                             bool first_time_window);
+
 void wm_window_ghostwindow_embedded_ensure(struct wmWindowManager *wm, struct wmWindow *win);
 /* End of Game engine transition */
 
@@ -0,0 +1,214 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_Profiler.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "PIL_time.h"
+
+#include "CM_Thread.h"
+
+namespace {
+
+struct Zone {
+  const char *name;
+  double start;
+  double end;
+  unsigned int thread;
+};
+
+/** Ring buffer slot. The sequence is odd while the zone is written and equal to twice the
+ * write index plus two once written, which lets the reader skip slots being overwritten.
+ */
+struct Slot {
+  std::atomic<unsigned long long> sequence;
+  Zone zone;
+};
+
+struct Profiler {
+  std::unique_ptr<Slot[]> slots;
+  unsigned long long mask = 0;
+  std::atomic<unsigned long long> head{0};
+  std::atomic<bool> enabled{false};
+  /// Index of the next thread recording its first zone.
+  std::atomic<unsigned int> numThreads{0};
+
+  CM_ThreadMutex namesLock;
+  std::set<std::string> names;
+};
+
+}  // namespace
+
+static Profiler &get_profiler()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+static unsigned int get_thread_index()
+{
+  static thread_local unsigned int index = get_profiler().numThreads.fetch_add(1);
+  return index;
+}
+
+static void write_json_string(std::ofstream &file, const char *str)
+{
+  file << '"';
+  for (const char *c = str; *c; ++c) {
+    switch (*c) {
+      case '"':
+        file << "\\\"";
+        break;
+      case '\\':
+        file << "\\\\";
+        break;
+      default:
+        // Control characters are not allowed in JSON strings.
+        if ((unsigned char)*c >= 0x20) {
+          file << *c;
+        }
+        break;
+    }
+  }
+  file << '"';
+}
+
+void CM_Profiler::Enable(unsigned int capacity)
+{
+  Profiler &profiler = get_profiler();
+
+  unsigned long long size = 1;
+  while (size < std::max(capacity, 1u)) {
+    size <<= 1;
+  }
+
+  profiler.slots.reset(new Slot[size]);
+  for (unsigned long long i = 0; i < size; ++i) {
+    profiler.slots[i].sequence.store(0, std::memory_order_relaxed);
+  }
+  profiler.mask = size - 1;
+  profiler.head.store(0, std::memory_order_relaxed);
+  profiler.enabled.store(true, std::memory_order_release);
+}
+
+void CM_Profiler::Disable()
+{
+  Profiler &profiler = get_profiler();
+  profiler.enabled.store(false, std::memory_order_release);
+  profiler.slots.reset();
+}
+
+bool CM_Profiler::IsEnabled()
+{
+  return get_profiler().enabled.load(std::memory_order_relaxed);
+}
+
+double CM_Profiler::GetTime()
+{
+  return PIL_check_seconds_timer();
+}
+
+void CM_Profiler::Record(const char *name, double start, double end)
+{
+  Profiler &profiler = get_profiler();
+  if (!profiler.enabled.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  const unsigned long long index = profiler.head.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = profiler.slots[index & profiler.mask];
+
+  slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.zone = {name, start, end, get_thread_index()};
+  slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+const char *CM_Profiler::RegisterName(const std::string &name)
+{
+  Profiler &profiler = get_profiler();
+
+  profiler.namesLock.Lock();
+  const char *str = profiler.names.insert(name).first->c_str();
+  profiler.namesLock.Unlock();
+
+  return str;
+}
+
+bool CM_Profiler::WriteTrace(const std::string &filepath)
+{
+  Profiler &profiler = get_profiler();
+  if (!profiler.slots) {
+    return false;
+  }
+
+  // Copy the written zones, the slots being written are skipped.
+  std::vector<Zone> zones;
+  for (unsigned long long i = 0; i <= profiler.mask; ++i) {
+    const Slot &slot = profiler.slots[i];
+    const unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1)) {
+      continue;
+    }
+
+    const Zone zone = slot.zone;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+      zones.push_back(zone);
+    }
+  }
+
+  std::sort(zones.begin(), zones.end(), [](const Zone &a, const Zone &b) {
+    return a.start < b.start;
+  });
+
+  std::ofstream file(filepath);
+  if (!file) {
+    return false;
+  }
+
+  // Times are in microseconds relative to the first zone.
+  const double origin = zones.empty() ? 0.0 : zones.front().start;
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (unsigned int i = 0, size = zones.size(); i < size; ++i) {
+    const Zone &zone = zones[i];
+    file << ((i == 0) ? "\n" : ",\n") << "{\"name\":";
+    write_json_string(file, zone.name);
+    file << ",\"cat\":\"bge\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.thread
+         << ",\"ts\":" << (zone.start - origin) * 1.0e6
+         << ",\"dur\":" << (zone.end - zone.start) * 1.0e6 << "}";
+  }
+  file << "\n]}\n";
+
+  return file.good();
+}
@@ -0,0 +1,86 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_Profiler.h
+ *  \ingroup common
+ */
+
+#ifndef __CM_PROFILER_H__
+#define __CM_PROFILER_H__
+
+#include <string>
+
+/** Trace recorder of the timing zones of each frame. The zones are recorded from any thread
+ * into a lock-free ring buffer keeping the most recent zones, and exported in the Chrome trace
+ * event JSON format. Zones nest by their time range per thread.
+ */
+class CM_Profiler {
+ public:
+  /** Start recording zones.
+   * \param capacity The number of zones kept in the ring buffer, rounded to a power of two.
+   */
+  static void Enable(unsigned int capacity);
+  /// Stop recording zones and free the ring buffer.
+  static void Disable();
+  static bool IsEnabled();
+
+  /// Return the time in seconds used for the zones.
+  static double GetTime();
+
+  /** Record a zone, does nothing when the profiler is disabled.
+   * \param name The zone name, must outlive the profiler, see RegisterName.
+   */
+  static void Record(const char *name, double start, double end);
+
+  /** Return a copy of name living until the end of the program. Takes a lock, call it once
+   * when the owner of a dynamic name is created and pass the result to CM_ProfileZone.
+   */
+  static const char *RegisterName(const std::string &name);
+
+  /** Write the recorded zones to a file in the Chrome trace event JSON format.
+   * \return False if the file couldn't be written.
+   */
+  static bool WriteTrace(const std::string &filepath);
+};
+
+/// Zone recorded from the construction to the destruction of the object.
+class CM_ProfileZone {
+ private:
+  const char *m_name;
+  double m_start;
+
+ public:
+  CM_ProfileZone(const char *name)
+      : m_name(CM_Profiler::IsEnabled() ? name : nullptr),
+        m_start(m_name ? CM_Profiler::GetTime() : 0.0)
+  {
+  }
+
+  ~CM_ProfileZone()
+  {
+    if (m_name) {
+      CM_Profiler::Record(m_name, m_start, CM_Profiler::GetTime());
+    }
+  }
+};
+
+#endif  // __CM_PROFILER_H__
@@ -133,6 +133,7 @@ bool BL_ActionActuator::Update(double curtime)
       CValue *newval = new CFloatValue(obj->GetActionFrame(m_layer));
       if (oldprop) {
         oldprop->SetValue(newval);
+        obj->NotifyPropertyChange(m_framepropname);
       }
       else {
         obj->SetProperty(m_framepropname, newval);
@@ -44,6 +44,7 @@
 #include "RNA_access.h"
 
 #include "BL_Action.h"
+#include "BL_ActionPoseCache.h"
 #include "BL_BlenderSceneConverter.h"
 #include "KX_Globals.h"
 
@@ -430,8 +431,23 @@ void BL_ArmatureObject::ApplyPose()
   }
 }
 
-void BL_ArmatureObject::SetPoseByAction(bAction *action, AnimationEvalContext *evalCtx)
+void BL_ArmatureObject::SetPoseByAction(bAction *action,
+                                        AnimationEvalContext *evalCtx,
+                                        BL_ActionPoseCache *cache)
 {
+  if (cache) {
+    m_poseChannelArray.clear();
+    for (bPoseChannel *pchan = (bPoseChannel *)m_objArma->pose->chanbase.first; pchan;
+         pchan = pchan->next) {
+      m_poseChannelArray.push_back(pchan);
+    }
+
+    if (cache->SetPose(
+            (bArmature *)m_objArma->data, action, evalCtx->eval_time, m_poseChannelArray)) {
+      return;
+    }
+  }
+
   PointerRNA ptrrna;
   RNA_id_pointer_create(&m_objArma->id, &ptrrna);
 
@@ -37,6 +37,7 @@
 #include "KX_GameObject.h"
 
 struct AnimationEvalContext;
+class BL_ActionPoseCache;
 struct bArmature;
 struct Bone;
 struct bPose;
@@ -67,6 +68,8 @@ class BL_ArmatureObject : public KX_GameObject {
   bool m_drawDebug;
 
   double m_lastapplyframe;
+  /// Pose channels in the order of the pose, used to set the pose from the action pose cache.
+  std::vector<bPoseChannel *> m_poseChannelArray;
 
  public:
   BL_ArmatureObject(void *sgReplicationInfo,
@@ -88,7 +91,13 @@ class BL_ArmatureObject : public KX_GameObject {
   /// Never edit this, only for accessing names.
   bPose *GetPose() const;
   void ApplyPose();
-  void SetPoseByAction(bAction *action, AnimationEvalContext *evalCtx);
+  /** Set the pose from an action.
+   * \param cache The cache sharing the pose with the other armatures, nullptr to always
+   * evaluate the action.
+   */
+  void SetPoseByAction(bAction *action,
+                       AnimationEvalContext *evalCtx,
+                       BL_ActionPoseCache *cache);
   void BlendInPose(bPose *blend_pose, float weight, short mode);
 
   bool UpdateTimestep(double curtime);
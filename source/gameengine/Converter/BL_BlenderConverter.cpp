@@ -67,6 +67,7 @@
 #endif
 
 #ifdef WITH_PYTHON
+#  include "KX_MeshProxy.h"
 #  include "Texture.h"  // For FreeAllTextures.
 #endif                  // WITH_PYTHON
 
@@ -77,7 +78,17 @@ BL_BlenderConverter::SceneSlot::SceneSlot(const BL_BlenderSceneConverter *conver
   Merge(converter);
 }
 
-BL_BlenderConverter::SceneSlot::~SceneSlot() = default;
+BL_BlenderConverter::SceneSlot::~SceneSlot()
+{
+#ifdef WITH_PYTHON
+  // The meshes could have been moved to another slot.
+  for (std::unique_ptr<RAS_MeshObject> &meshobj : m_meshobjects) {
+    if (meshobj) {
+      KX_MeshProxy::InvalidateMesh(meshobj.get());
+    }
+  }
+#endif  // WITH_PYTHON
+}
 
 void BL_BlenderConverter::SceneSlot::Merge(BL_BlenderConverter::SceneSlot &other)
 {
@@ -108,6 +119,11 @@ BL_BlenderConverter::BL_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine)
 {
   BKE_main_id_tag_all(maggie, LIB_TAG_DOIT, false);  // avoid re-tagging later on
   m_threadinfo.m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+
+#ifdef WITH_BULLET
+  // Scenes can be converted from other threads, e.g for asynchronous library loading.
+  CcdPhysicsEnvironment::InitTaskScheduler();
+#endif
 }
 
 BL_BlenderConverter::~BL_BlenderConverter()
@@ -242,6 +258,11 @@ void BL_BlenderConverter::RemoveScene(KX_Scene *scene)
    * from the bucket manager in the scene.
    */
   SceneSlot &sceneSlot = m_sceneSlots[scene];
+#ifdef WITH_PYTHON
+  for (std::unique_ptr<RAS_MeshObject> &meshobj : sceneSlot.m_meshobjects) {
+    KX_MeshProxy::InvalidateMesh(meshobj.get());
+  }
+#endif  // WITH_PYTHON
   sceneSlot.m_meshobjects.clear();
 
   // Delete the scene.
@@ -294,32 +315,30 @@ Main *BL_BlenderConverter::GetMainDynamicPath(const std::string &path) const
   return nullptr;
 }
 
+/// Libload datas shared by the reading and linking stage and the merge on the main thread.
+struct LibLoadData {
+  /// The blend file, nullptr until opened by the loading task for an asynchronous file load.
+  BlendHandle *bpy_openlib;
+  /// The Main receiving the linked datablocks, not known by the converter until the merge.
+  Main *main_newlib;
+  int idcode;
+  short options;
+  /// Scenes converted after linking, merged and deleted in FinishLibLoad.
+  std::vector<KX_Scene *> scenes;
+};
+
 void BL_BlenderConverter::MergeAsyncLoads()
 {
-  std::vector<KX_Scene *> *merge_scenes;
-
-  std::vector<KX_LibLoadStatus *>::iterator mit;
-  std::vector<KX_Scene *>::iterator sit;
+  std::vector<KX_LibLoadStatus *> mergequeue;
 
+  // Don't keep the mutex during the merge, loading tasks are waiting for it.
   m_threadinfo.m_mutex.Lock();
+  mergequeue.swap(m_mergequeue);
+  m_threadinfo.m_mutex.Unlock();
 
-  for (mit = m_mergequeue.begin(); mit != m_mergequeue.end(); ++mit) {
-    merge_scenes = (std::vector<KX_Scene *> *)(*mit)->GetData();
-
-    for (sit = merge_scenes->begin(); sit != merge_scenes->end(); ++sit) {
-      (*mit)->GetMergeScene()->MergeScene(*sit);
-      delete (*sit);
-    }
-
-    delete merge_scenes;
-    (*mit)->SetData(nullptr);
-
-    (*mit)->Finish();
+  for (KX_LibLoadStatus *status : mergequeue) {
+    FinishLibLoad(status);
   }
-
-  m_mergequeue.clear();
-
-  m_threadinfo.m_mutex.Unlock();
 }
 
 void BL_BlenderConverter::FinalizeAsyncLoads()
@@ -337,31 +356,6 @@ void BL_BlenderConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
   m_threadinfo.m_mutex.Unlock();
 }
 
-static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
-{
-  KX_Scene *new_scene = nullptr;
-  KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
-  std::vector<Scene *> *scenes = (std::vector<Scene *> *)status->GetData();
-  std::vector<KX_Scene *> *merge_scenes =
-      new std::vector<KX_Scene *>();  // Deleted in MergeAsyncLoads
-
-  for (unsigned int i = 0; i < scenes->size(); ++i) {
-    new_scene = status->GetEngine()->CreateScene((*scenes)[i], true);
-
-    if (new_scene) {
-      merge_scenes->push_back(new_scene);
-    }
-
-    status->AddProgress((1.0f / scenes->size()) *
-                        0.9f);  // We'll call conversion 90% and merging 10% for now
-  }
-
-  delete scenes;
-  status->SetData(merge_scenes);
-
-  status->GetConverter()->AddScenesToMergeQueue(status);
-}
-
 KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
                                                            int length,
                                                            const char *path,
@@ -371,6 +365,10 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
                                                            short options)
 {
   BlendHandle *bpy_openlib = BLO_blendhandle_from_memory(data, length);
+  // The memory can't be read in the loading task, report the error now.
+  if (!bpy_openlib) {
+    options &= ~LIB_LOAD_ASYNC;
+  }
 
   // Error checking is done in LinkBlendFile
   return LinkBlendFile(bpy_openlib, path, group, scene_merge, err_str, options);
@@ -379,28 +377,120 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFileMemory(void *data,
 KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFilePath(
     const char *filepath, char *group, KX_Scene *scene_merge, char **err_str, short options)
 {
-  BlendHandle *bpy_openlib = BLO_blendhandle_from_file(filepath, nullptr);
+  /* Opening the file reads and decodes it, an asynchronous load does it in the loading task,
+   * see link_blend_file. */
+  BlendHandle *bpy_openlib = (options & LIB_LOAD_ASYNC) ?
+                                 nullptr :
+                                 BLO_blendhandle_from_file(filepath, nullptr);
 
   // Error checking is done in LinkBlendFile
   return LinkBlendFile(bpy_openlib, filepath, group, scene_merge, err_str, options);
 }
 
-static void load_datablocks(Main *main_tmp, BlendHandle *bpy_openlib, const char *path, int idcode)
+/// Link all the datablocks of a type, return the number of datablocks which couldn't be linked.
+static unsigned int load_datablocks(Main *main_tmp,
+                                    BlendHandle *bpy_openlib,
+                                    const struct LibraryLink_Params *liblink_params,
+                                    int idcode)
 {
   LinkNode *names = nullptr;
 
   int totnames_dummy;
   names = BLO_blendhandle_get_datablock_names(bpy_openlib, idcode, &totnames_dummy);
 
-  int i = 0;
+  unsigned int failed = 0;
   LinkNode *n = names;
   while (n) {
-    struct LibraryLink_Params liblink_params;
-    BLO_library_link_named_part(main_tmp, &bpy_openlib, idcode, (char *)n->link, &liblink_params);
+    if (!BLO_library_link_named_part(
+            main_tmp, &bpy_openlib, idcode, (char *)n->link, liblink_params)) {
+      ++failed;
+    }
     n = (LinkNode *)n->next;
-    i++;
   }
   BLI_linklist_free(names, free);  // free linklist *and* each node's data
+
+  return failed;
+}
+
+/** Read and link the datablocks of the library in its own Main, then convert the linked scenes.
+ * Nothing here touches the main database, so it can run on a worker thread.
+ */
+static void link_blend_file(KX_LibLoadStatus *status, LibLoadData *data)
+{
+  const int idcode = data->idcode;
+  const short options = data->options;
+  Main *main_newlib = data->main_newlib;
+
+  // The file of an asynchronous load is opened here.
+  if (!data->bpy_openlib) {
+    data->bpy_openlib = BLO_blendhandle_from_file(main_newlib->name, nullptr);
+    if (!data->bpy_openlib) {
+      status->AddError("could not open the blend file");
+      return;
+    }
+  }
+
+  // created only for linking, then freed
+  struct LibraryLink_Params liblink_params;
+  BLO_library_link_params_init(&liblink_params, main_newlib, 0);
+  Main *main_tmp = BLO_library_link_begin(&data->bpy_openlib, main_newlib->name, &liblink_params);
+  if (!main_tmp) {
+    status->AddError("could not read the blend file");
+    BLO_blendhandle_close(data->bpy_openlib);
+    data->bpy_openlib = nullptr;
+    return;
+  }
+
+  unsigned int failed = load_datablocks(main_tmp, data->bpy_openlib, &liblink_params, idcode);
+
+  if (idcode == ID_SCE && options & BL_BlenderConverter::LIB_LOAD_LOAD_SCRIPTS) {
+    failed += load_datablocks(main_tmp, data->bpy_openlib, &liblink_params, ID_TXT);
+  }
+
+  // now do another round of linking for Scenes so all actions are properly loaded
+  if (idcode == ID_SCE && options & BL_BlenderConverter::LIB_LOAD_LOAD_ACTIONS) {
+    failed += load_datablocks(main_tmp, data->bpy_openlib, &liblink_params, ID_AC);
+  }
+
+  BLO_library_link_end(main_tmp, &data->bpy_openlib, &liblink_params);
+
+  BLO_blendhandle_close(data->bpy_openlib);
+  data->bpy_openlib = nullptr;
+  // done linking
+
+  if (failed > 0) {
+    status->AddError("could not link " + std::to_string(failed) + " datablock(s)");
+  }
+
+  // We'll call reading 50%, conversion 40% and merging 10% for now
+  status->AddProgress(0.5f);
+
+  if (idcode != ID_SCE) {
+    return;
+  }
+
+  const int numScenes = BLI_listbase_count(&main_newlib->scenes);
+  for (ID *scene = (ID *)main_newlib->scenes.first; scene; scene = (ID *)scene->next) {
+    if (options & BL_BlenderConverter::LIB_LOAD_VERBOSE) {
+      CM_Debug("scene name: " << scene->name + 2);
+    }
+
+    KX_Scene *new_scene = status->GetEngine()->CreateScene((Scene *)scene, true);
+    if (new_scene) {
+      data->scenes.push_back(new_scene);
+    }
+
+    status->AddProgress((1.0f / numScenes) * 0.4f);
+  }
+}
+
+static void async_link_blend_file(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  KX_LibLoadStatus *status = (KX_LibLoadStatus *)taskdata;
+
+  link_blend_file(status, (LibLoadData *)status->GetData());
+
+  status->GetConverter()->AddScenesToMergeQueue(status);
 }
 
 KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
@@ -412,7 +502,6 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
 {
   Main *main_newlib;  // stored as a dynamic 'main' until we free it
   const int idcode = BKE_idtype_idcode_from_name(group);
-  ReportList reports;
   static char err_local[255];
 
   KX_LibLoadStatus *status;
@@ -425,50 +514,57 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
     return nullptr;
   }
 
-  if (GetMainDynamicPath(path)) {
+  // A library still loading asynchronously is not yet in the dynamic mains.
+  if (GetMainDynamicPath(path) || m_status_map.count(path)) {
     snprintf(err_local, sizeof(err_local), "blend file already open \"%s\"\n", path);
     *err_str = err_local;
     BLO_blendhandle_close(bpy_openlib);
     return nullptr;
   }
 
-  if (bpy_openlib == nullptr) {
+  // Without handle an asynchronous load opens the file in the loading task.
+  if (bpy_openlib == nullptr && !(options & LIB_LOAD_ASYNC)) {
     snprintf(err_local, sizeof(err_local), "could not open blendfile \"%s\"\n", path);
     *err_str = err_local;
     return nullptr;
   }
 
   main_newlib = BKE_main_new();
-  BKE_reports_init(&reports, RPT_STORE);
+  BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
 
-  //short flag = 0;  // don't need any special options
-  // created only for linking, then freed
-  struct LibraryLink_Params liblink_params;
-  Main *main_tmp = BLO_library_link_begin(&bpy_openlib, (char *)path, &liblink_params);
+  LibLoadData *data = new LibLoadData();  // Deleted in FinishLibLoad
+  data->bpy_openlib = bpy_openlib;
+  data->main_newlib = main_newlib;
+  data->idcode = idcode;
+  data->options = options;
 
-  load_datablocks(main_tmp, bpy_openlib, path, idcode);
+  status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
+  status->SetData(data);
+  m_status_map[main_newlib->name] = status;
 
-  if (idcode == ID_SCE && options & LIB_LOAD_LOAD_SCRIPTS) {
-    load_datablocks(main_tmp, bpy_openlib, path, ID_TXT);
+  if (options & LIB_LOAD_ASYNC) {
+    // The file reading, linking and scene conversion are done by the task, only the merge is left
+    // to MergeAsyncLoads.
+    BLI_task_pool_push(m_threadinfo.m_pool, async_link_blend_file, status, false, nullptr);
   }
-
-  // now do another round of linking for Scenes so all actions are properly loaded
-  if (idcode == ID_SCE && options & LIB_LOAD_LOAD_ACTIONS) {
-    load_datablocks(main_tmp, bpy_openlib, path, ID_AC);
+  else {
+    link_blend_file(status, data);
+    FinishLibLoad(status);
   }
 
-  BLO_library_link_end(main_tmp, &bpy_openlib, &liblink_params);
-
-  BLO_blendhandle_close(bpy_openlib);
+  return status;
+}
 
-  BKE_reports_clear(&reports);
-  // done linking
+void BL_BlenderConverter::FinishLibLoad(KX_LibLoadStatus *status)
+{
+  LibLoadData *data = (LibLoadData *)status->GetData();
+  Main *main_newlib = data->main_newlib;
+  KX_Scene *scene_merge = status->GetMergeScene();
+  const int idcode = data->idcode;
+  const short options = data->options;
 
   // needed for lookups
   m_DynamicMaggie.push_back(main_newlib);
-  BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
-
-  status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, path);
 
   if (idcode == ID_ME) {
     // Convert all new meshes into BGE meshes
@@ -506,34 +602,12 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
   }
   else if (idcode == ID_SCE) {
     // Merge all new linked in scene into the existing one
-    ID *scene;
-    // scenes gets deleted by the thread when it's done using it (look in async_convert())
-    std::vector<Scene *> *scenes = (options & LIB_LOAD_ASYNC) ? new std::vector<Scene *>() :
-                                                                nullptr;
-
-    for (scene = (ID *)main_newlib->scenes.first; scene; scene = (ID *)scene->next) {
-      if (options & LIB_LOAD_VERBOSE) {
-        CM_Debug("scene name: " << scene->name + 2);
-      }
-
-      if (options & LIB_LOAD_ASYNC) {
-        scenes->push_back((Scene *)scene);
-      }
-      else {
-        // merge into the base  scene
-        KX_Scene *other = m_ketsjiEngine->CreateScene((Scene *)scene, true);
-        scene_merge->MergeScene(other);
+    for (KX_Scene *other : data->scenes) {
+      scene_merge->MergeScene(other);
 
-        // RemoveScene(other); // Don't run this, it frees the entire scene converter data, just
-        // delete the scene
-        delete other;
-      }
-    }
-
-    if (options & LIB_LOAD_ASYNC) {
-      status->SetData(scenes);
-      BLI_task_pool_push(
-          m_threadinfo.m_pool, (TaskRunFunction)async_convert, (void *)status, false, NULL);
+      // RemoveScene(other); // Don't run this, it frees the entire scene converter data, just
+      // delete the scene
+      delete other;
     }
 
 #ifdef WITH_PYTHON
@@ -556,12 +630,15 @@ KX_LibLoadStatus *BL_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
     }
   }
 
-  if (!(options & LIB_LOAD_ASYNC)) {
-    status->Finish();
+  delete data;
+  status->SetData(nullptr);
+
+  // Errors of an asynchronous load are only known now, the finish callback can read them.
+  if (!status->GetError().empty()) {
+    CM_Error("library (" << main_newlib->name << ") loaded with errors: " << status->GetError());
   }
 
-  m_status_map[main_newlib->name] = status;
-  return status;
+  status->Finish();
 }
 
 /** Note m_map_*** are all ok and don't need to be freed
@@ -639,6 +716,8 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
           ++it;
         }
       }
+      // The shared poses reference the freed actions and armatures.
+      scene->GetActionPoseCache().Clear();
 
       // removed tagged objects and meshes
       CListValue<KX_GameObject> *obj_lists[] = {
@@ -741,6 +820,9 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
          it != sceneSlot.m_meshobjects.end();) {
       RAS_MeshObject *mesh = (*it).get();
       if (IS_TAGGED(mesh->GetOrigMesh())) {
+#ifdef WITH_PYTHON
+        KX_MeshProxy::InvalidateMesh(mesh);
+#endif  // WITH_PYTHON
         it = sceneSlot.m_meshobjects.erase(it);
       }
       else {
@@ -765,7 +847,16 @@ bool BL_BlenderConverter::FreeBlendFile(Main *maggie)
 
 bool BL_BlenderConverter::FreeBlendFile(const std::string &path)
 {
-  return FreeBlendFile(GetMainDynamicPath(path));
+  Main *maggie = GetMainDynamicPath(path);
+  // A library loaded asynchronously is in the dynamic mains only once merged.
+  if (!maggie && m_status_map.count(path)) {
+    CM_Error("Library (" << path
+                         << ") is currently being loaded asynchronously, and cannot be freed "
+                            "until this process is done");
+    return false;
+  }
+
+  return FreeBlendFile(maggie);
 }
 
 void BL_BlenderConverter::MergeScene(KX_Scene *to, KX_Scene *from)
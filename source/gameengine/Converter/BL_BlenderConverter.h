@@ -137,6 +137,9 @@ class BL_BlenderConverter {
                                         short options);
   KX_LibLoadStatus *LinkBlendFilePath(
       const char *path, char *group, KX_Scene *scene_merge, char **err_str, short options);
+  /** \param bpy_openlib The opened blend file, nullptr for an asynchronous load of the file at
+   * path, opened in the loading task.
+   */
   KX_LibLoadStatus *LinkBlendFile(BlendHandle *bpy_openlib,
                                   const char *path,
                                   char *group,
@@ -154,6 +157,8 @@ class BL_BlenderConverter {
   void MergeAsyncLoads();
   void FinalizeAsyncLoads();
   void AddScenesToMergeQueue(KX_LibLoadStatus *status);
+  /// Convert and merge the linked datablocks of a libload, must be called from the main thread.
+  void FinishLibLoad(KX_LibLoadStatus *status);
 
   void PrintStats();
 
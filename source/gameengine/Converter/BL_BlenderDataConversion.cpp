@@ -67,6 +67,7 @@
 #include "BKE_material.h" /* give_current_material */
 #include "BKE_object.h"
 #include "BKE_scene.h"
+#include "BLI_task.h"
 #include "DEG_depsgraph_query.h"
 #include "DNA_camera_types.h"
 #include "DNA_mesh_types.h"
@@ -96,6 +97,7 @@
 #include "KX_SG_BoneParentNodeRelationship.h"
 #include "KX_SG_NodeRelationships.h"
 #include "RAS_ICanvas.h"
+#include "RAS_IDisplayArray.h"
 #include "RAS_Vertex.h"
 #ifdef WITH_BULLET
 #  include "CcdPhysicsEnvironment.h"
@@ -324,6 +326,162 @@ static RAS_MaterialBucket *BL_material_from_mesh(Material *ma,
   return bucket;
 }
 
+/// Data shared by all the material vertex conversion tasks of a mesh.
+struct BL_MeshConversionData {
+  const MVert *mverts;
+  const MPoly *mpolys;
+  const MLoop *mloops;
+  const float (*normals)[3];
+  const float (*tangent)[4];
+  const RAS_MeshObject::LayerList *layers;
+  unsigned short uvLayers;
+  unsigned short colorLayers;
+  /// Converted vertex index of each loop, written by the task owning the loop polygon.
+  unsigned int *loopVertices;
+};
+
+/// Vertices conversion of a single material, each material is converted by its own task.
+struct BL_MeshMaterialConversion {
+  RAS_MeshMaterial *meshmat;
+  bool visible;
+  bool wire;
+  /// Polygons using this material.
+  std::vector<unsigned int> polys;
+  /// Number of loops of the polygons using this material.
+  unsigned int totloops;
+  BL_MeshConversionData *data;
+};
+
+static inline void bl_hash_combine(unsigned int &hash, const void *value, unsigned int size)
+{
+  const unsigned char *bytes = (const unsigned char *)value;
+  for (unsigned int i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+}
+
+/// Hash all the loop attributes used to share vertices: position, normal, tangent, uv and color.
+static unsigned int bl_loop_hash(const BL_MeshConversionData *data, unsigned int loop)
+{
+  unsigned int hash = 2166136261u;
+  bl_hash_combine(hash, &data->mloops[loop].v, sizeof(unsigned int));
+  bl_hash_combine(hash, data->normals[loop], sizeof(float[3]));
+  if (data->tangent) {
+    bl_hash_combine(hash, data->tangent[loop], sizeof(float[4]));
+  }
+  for (const RAS_MeshObject::Layer &layer : *data->layers) {
+    if (layer.color) {
+      bl_hash_combine(hash, &layer.color[loop], sizeof(MLoopCol));
+    }
+    else if (layer.uv) {
+      bl_hash_combine(hash, layer.uv[loop].uv, sizeof(float[2]));
+    }
+  }
+
+  return hash;
+}
+
+/// Return true if the two loops can share the same vertex.
+static bool bl_loop_equals(const BL_MeshConversionData *data, unsigned int loop1, unsigned int loop2)
+{
+  if (data->mloops[loop1].v != data->mloops[loop2].v ||
+      memcmp(data->normals[loop1], data->normals[loop2], sizeof(float[3])) != 0) {
+    return false;
+  }
+  if (data->tangent &&
+      memcmp(data->tangent[loop1], data->tangent[loop2], sizeof(float[4])) != 0) {
+    return false;
+  }
+  for (const RAS_MeshObject::Layer &layer : *data->layers) {
+    if (layer.color) {
+      if (memcmp(&layer.color[loop1], &layer.color[loop2], sizeof(MLoopCol)) != 0) {
+        return false;
+      }
+    }
+    else if (layer.uv) {
+      if (memcmp(layer.uv[loop1].uv, layer.uv[loop2].uv, sizeof(float[2])) != 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/** Convert the vertices of all the polygons using a material. Loops with equal attributes are
+ * found with an open addressing hash table, the unique vertices are then constructed directly
+ * in the display array.
+ */
+static void bl_convert_material_vertices(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BL_MeshMaterialConversion &conv = ((BL_MeshMaterialConversion *)userdata)[iter];
+  if (conv.polys.empty()) {
+    return;
+  }
+
+  const BL_MeshConversionData *data = conv.data;
+  unsigned int *loopVertices = data->loopVertices;
+
+  const unsigned int tablesize = power_of_2_max_u(conv.totloops * 2);
+  const unsigned int mask = tablesize - 1;
+  const unsigned int emptySlot = -1;
+  // The first loop of each unique vertex, or emptySlot.
+  std::vector<unsigned int> table(tablesize, emptySlot);
+  // The first loop of each unique vertex and the flat state of its polygon, by vertex index.
+  std::vector<std::pair<unsigned int, bool>> uniqueLoops;
+
+  unsigned int numindices = 0;
+  for (unsigned int i : conv.polys) {
+    const MPoly &mpoly = data->mpolys[i];
+    const bool flat = (mpoly.flag & ME_SMOOTH) == 0;
+    const unsigned int lpstart = mpoly.loopstart;
+    const unsigned int totlp = mpoly.totloop;
+
+    for (unsigned int j = lpstart; j < lpstart + totlp; ++j) {
+      unsigned int slot = bl_loop_hash(data, j) & mask;
+      while (table[slot] != emptySlot && !bl_loop_equals(data, table[slot], j)) {
+        slot = (slot + 1) & mask;
+      }
+
+      if (table[slot] == emptySlot) {
+        table[slot] = j;
+        loopVertices[j] = uniqueLoops.size();
+        uniqueLoops.emplace_back(j, flat);
+      }
+      else {
+        loopVertices[j] = loopVertices[table[slot]];
+      }
+    }
+
+    if (conv.visible) {
+      numindices += conv.wire ? totlp * 2 : (totlp - 2) * 3;
+    }
+  }
+
+  RAS_IDisplayArray *darray = conv.meshmat->GetDisplayArray();
+  BLI_assert(darray->GetVertexCount() == 0);
+  darray->Reserve(uniqueLoops.size(), numindices);
+
+  for (const std::pair<unsigned int, bool> &unique : uniqueLoops) {
+    const unsigned int j = unique.first;
+    const unsigned int vertid = data->mloops[j].v;
+
+    const MT_Vector3 pt(data->mverts[vertid].co);
+    const MT_Vector3 no(data->normals[j]);
+    const MT_Vector4 tan = data->tangent ? MT_Vector4(data->tangent[j]) :
+                                           MT_Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+    MT_Vector2 uvs[RAS_Texture::MaxUnits];
+    unsigned int rgba[RAS_Texture::MaxUnits];
+
+    BL_GetUvRgba(*data->layers, j, uvs, rgba, data->uvLayers, data->colorLayers);
+
+    darray->AddVertex(pt, uvs, tan, rgba, no);
+    darray->AddVertexInfo(RAS_VertexInfo(vertid, unique.second));
+  }
+}
+
 /* blenderobj can be nullptr, make sure its checked for */
 RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
                                Object *blenderobj,
@@ -454,6 +612,45 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     mpolyToMface[mfaceToMpoly[i]].push_back(i);
   }
 
+  std::vector<unsigned int> loopVertices(dm->getNumLoops(dm));
+  BL_MeshConversionData data = {mverts,
+                                mpolys,
+                                mloops,
+                                normals,
+                                tangent,
+                                &layersInfo.layers,
+                                uvLayers,
+                                colorLayers,
+                                loopVertices.data()};
+
+  std::vector<BL_MeshMaterialConversion> materialConvs(totmat);
+  for (unsigned short i = 0; i < totmat; ++i) {
+    const ConvertedMaterial &mat = convertedMats[i];
+    materialConvs[i] = {mat.meshmat, mat.visible, mat.wire, {}, 0, &data};
+  }
+
+  for (unsigned int i = 0; i < numpolys; ++i) {
+    BL_MeshMaterialConversion &conv = materialConvs[mpolys[i].mat_nr];
+    conv.polys.push_back(i);
+    conv.totloops += mpolys[i].totloop;
+  }
+
+  // Each material owns its display array, convert the vertices of all the materials in parallel.
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totmat > 1);
+  BLI_task_parallel_range(0, totmat, materialConvs.data(), bl_convert_material_vertices, &settings);
+
+  for (const BL_MeshMaterialConversion &conv : materialConvs) {
+    RAS_IDisplayArray *darray = conv.meshmat->GetDisplayArray();
+    for (unsigned int i = 0, size = darray->GetVertexCount(); i < size; ++i) {
+      const unsigned int origindex = darray->GetVertexInfo(i).getOrigIndex();
+      meshobj->m_sharedvertex_map[origindex].push_back({darray, (int)i});
+    }
+  }
+
+  meshobj->ReservePolygons(totfaces);
+
   // Tracked vertices during a mpoly conversion, should never be used by the next mpoly.
   std::vector<unsigned int> vertices(totverts, -1);
 
@@ -463,26 +660,11 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
     const ConvertedMaterial &mat = convertedMats[mpoly.mat_nr];
     RAS_MeshMaterial *meshmat = mat.meshmat;
 
-    // Mark face as flat, so vertices are split.
-    const bool flat = (mpoly.flag & ME_SMOOTH) == 0;
-
     const unsigned int lpstart = mpoly.loopstart;
     const unsigned int totlp = mpoly.totloop;
     for (unsigned int j = lpstart; j < lpstart + totlp; ++j) {
-      const MLoop &mloop = mloops[j];
-      const unsigned int vertid = mloop.v;
-      const MVert &mvert = mverts[vertid];
-
-      const MT_Vector3 pt(mvert.co);
-      const MT_Vector3 no(normals[j]);
-      const MT_Vector4 tan = tangent ? MT_Vector4(tangent[j]) : MT_Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-      MT_Vector2 uvs[RAS_Texture::MaxUnits];
-      unsigned int rgba[RAS_Texture::MaxUnits];
-
-      BL_GetUvRgba(layersInfo.layers, j, uvs, rgba, uvLayers, colorLayers);
-
       // Add tracked vertices by the mpoly.
-      vertices[vertid] = meshobj->AddVertex(meshmat, pt, uvs, tan, rgba, no, flat, vertid);
+      vertices[mloops[j].v] = loopVertices[j];
     }
 
     // Convert to edges of material is rendering wire.
@@ -1002,6 +1184,7 @@ static void bl_ConvertBlenderObject_Single(BL_BlenderSceneConverter *converter,
 
   if (isInActiveLayer) {
     objectlist->Add(CM_AddRef(gameobj));
+    kxscene->AddTransformSyncObject(gameobj);
     // tf.Add(gameobj->GetSGNode());
 
     gameobj->NodeUpdateGS(0);
@@ -1591,4 +1774,9 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
     kxscene->RemoveObjectSpawn(gameobj);
   }
   spawnlist.clear();
+
+  // Libloaded objects get their pools once merged in the destination scene.
+  if (!libloading) {
+    kxscene->FillReplicaPools();
+  }
 }
@@ -0,0 +1,156 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file EXP_ExpressionProgram.h
+ *  \ingroup expressions
+ */
+
+#ifndef __EXP_EXPRESSIONPROGRAM_H__
+#define __EXP_EXPRESSIONPROGRAM_H__
+
+#include <string>
+#include <vector>
+
+#include "EXP_IntValue.h"
+
+/** Expression compiled by CParser::CompileText into a flat list of instructions working on
+ * unboxed registers. Each register has a type fixed at compile time, so the instructions are
+ * typed and the execution doesn't allocate values. Only the boolean, integer and float
+ * expressions are compiled, with the same semantic as CValue::Calc.
+ */
+class CExpressionProgram {
+ public:
+  enum RegisterType { REGISTER_BOOL = 0, REGISTER_INT, REGISTER_FLOAT };
+
+  CExpressionProgram();
+  ~CExpressionProgram();
+
+  /// Remove all the instructions, registers and inputs.
+  void Clear();
+
+  /** Add an input register, an input is an identifier set before each execution.
+   * \return The register of the input, the same for all the inputs of the same name.
+   */
+  int AddInput(const std::string &name, RegisterType type);
+  int AddBoolConstant(bool value);
+  int AddIntConstant(cInt value);
+  int AddFloatConstant(float value);
+  /** Add an instruction computing an unary operator.
+   * \return The register of the result, -1 if the operator is not valid for the operand.
+   */
+  int AddOperator(VALUE_OPERATOR op, int reg);
+  /** Add an instruction computing a binary operator.
+   * \return The register of the result, -1 if the operator is not valid for the operands.
+   */
+  int AddOperator(VALUE_OPERATOR op, int lhs, int rhs);
+  /** Add an instruction selecting a register from a boolean guard, like CIfExpr.
+   * \return The register of the result, -1 if the guard is not a boolean or the registers
+   * to select have different types.
+   */
+  int AddSelect(int guard, int e1, int e2);
+  /// Set the register holding the result of the expression.
+  void SetResult(int reg);
+
+  unsigned int GetInputCount() const;
+  const std::string &GetInputName(unsigned int index) const;
+  RegisterType GetInputType(unsigned int index) const;
+
+  void SetBoolInput(unsigned int index, bool value);
+  void SetIntInput(unsigned int index, cInt value);
+  void SetFloatInput(unsigned int index, float value);
+
+  /** Run the instructions.
+   * \param result The result of the expression as a number, see CValue::GetNumber.
+   * \param error The error message if the execution failed, the same as CValue::Calc.
+   * \return False if the execution failed, e.g. on a division by zero.
+   */
+  bool Execute(double &result, const char *&error);
+
+ private:
+  enum OpCode {
+    OP_INT_TO_FLOAT,
+    OP_SELECT,
+    OP_NOT_BOOL,
+    OP_AND_BOOL,
+    OP_OR_BOOL,
+    OP_EQL_BOOL,
+    OP_NEQ_BOOL,
+    OP_NEG_INT,
+    OP_NOT_INT,
+    OP_MOD_INT,
+    OP_ADD_INT,
+    OP_SUB_INT,
+    OP_MUL_INT,
+    OP_DIV_INT,
+    OP_EQL_INT,
+    OP_NEQ_INT,
+    OP_GRE_INT,
+    OP_LES_INT,
+    OP_GEQ_INT,
+    OP_LEQ_INT,
+    OP_NEG_FLOAT,
+    OP_NOT_FLOAT,
+    OP_MOD_FLOAT,
+    OP_ADD_FLOAT,
+    OP_SUB_FLOAT,
+    OP_MUL_FLOAT,
+    OP_DIV_FLOAT,
+    OP_EQL_FLOAT,
+    OP_NEQ_FLOAT,
+    OP_GRE_FLOAT,
+    OP_LES_FLOAT,
+    OP_GEQ_FLOAT,
+    OP_LEQ_FLOAT
+  };
+
+  union Register {
+    bool m_bool;
+    cInt m_int;
+    float m_float;
+  };
+
+  struct Instruction {
+    OpCode m_op;
+    /// Destination register.
+    unsigned int m_dst;
+    /// Source registers, m_src[0] is the guard of OP_SELECT.
+    unsigned int m_src[3];
+  };
+
+  struct Input {
+    std::string m_name;
+    unsigned int m_register;
+  };
+
+  std::vector<Instruction> m_instructions;
+  std::vector<Register> m_registers;
+  std::vector<RegisterType> m_registerTypes;
+  std::vector<Input> m_inputs;
+  int m_result;
+
+  int AddRegister(RegisterType type);
+  int AddInstruction(OpCode op, RegisterType type, int src0, int src1 = 0, int src2 = 0);
+  /// Convert an integer register to float, other registers are returned unchanged.
+  int ToFloat(int reg);
+};
+
+#endif  // __EXP_EXPRESSIONPROGRAM_H__
@@ -22,6 +22,7 @@
 #define __EXP_INPUTPARSER_H__
 
 class CParser;
+class CExpressionProgram;
 
 #include "EXP_Expression.h"
 
@@ -31,6 +32,11 @@ class CParser {
   virtual ~CParser();
 
   CExpression *ProcessText(const std::string &intext);
+  /** Compile intext into a program, the identifiers are typed by their value in the context.
+   * \return False if the expression uses values or operators not supported by the program,
+   * the expression must then be processed with ProcessText.
+   */
+  bool CompileText(const std::string &intext, CExpressionProgram &program);
   void SetContext(CValue *context);
 
  private:
@@ -95,6 +101,8 @@ class CParser {
   int Priority(int optor);
   CExpression *Ex(int i);
   CExpression *Expr();
+  int CompileEx(int i, CExpressionProgram &program);
+  int CompileIdentifier(CExpressionProgram &program);
 };
 
 #endif /* __EXP_INPUTPARSER_H__ */
@@ -35,6 +35,7 @@ class CIntValue : public CPropValue {
   virtual int GetValueType();
 
   cInt GetInt();
+  void SetInt(cInt innie);
 
   virtual CValue *Calc(VALUE_OPERATOR op, CValue *val);
   virtual CValue *CalcFinal(VALUE_DATA_TYPE dtype, VALUE_OPERATOR op, CValue *val);
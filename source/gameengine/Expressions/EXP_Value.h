@@ -73,6 +73,26 @@ enum VALUE_DATA_TYPE {
 #  include "object.h"
 #endif
 
+class CValue;
+
+/** Names of the properties of a value and their slot in its property table.
+ * The layout is shared by a value and its replicas: a name keeps the same slot
+ * for all of them, and a shared layout is copied before a new name is appended.
+ * A slot is never reused by an other name.
+ */
+class CPropertyLayout : public CM_RefCount<CPropertyLayout> {
+ public:
+  /// Slot of each property name, sorted by names.
+  std::map<std::string, unsigned int> m_slots;
+};
+
+/// Properties of a value indexed by their slot in the layout, nullptr for removed properties.
+struct CPropertyTable {
+  CPropertyLayout *m_layout;
+  std::vector<CValue *> m_values;
+  unsigned int m_count;
+};
+
 /**
  * Baseclass CValue
  *
@@ -85,7 +105,8 @@ enum VALUE_DATA_TYPE {
  *
  * Features:
  * - Calculations (Calc() / CalcFinal())
- * - Property system (SetProperty() / GetProperty() / FindIdentifier())
+ * - Property system (SetProperty() / GetProperty() / FindIdentifier()), properties can be
+ *   accessed by their slot index (GetPropertySlot() / GetPropertyFromSlot())
  * - Replication (GetReplica())
  * - Flags (IsError())
  *
@@ -142,6 +163,24 @@ class CValue : public PyObjectPlus, public CM_RefCount<CValue> {
   /// Get the amount of properties assiocated with this value.
   virtual int GetPropertyCount();
 
+  /** Get the slot of the property named <inName>, -1 if the name is unknown.
+   * The slot stays valid for this value and its replicas, even if the property is removed.
+   */
+  int GetPropertySlot(const std::string &inName) const;
+  /** Get the slot of the property named <inName>, the name is added without value if unknown.
+   * The replicas created after share the name and can set the property without copying the
+   * layout.
+   */
+  int RegisterPropertySlot(const std::string &inName);
+  /// Get the property at <slot>, nullptr if the slot is invalid or the property removed.
+  inline CValue *GetPropertyFromSlot(int slot) const
+  {
+    if (!m_propertyTable || slot < 0 || slot >= (int)m_propertyTable->m_values.size()) {
+      return nullptr;
+    }
+    return m_propertyTable->m_values[slot];
+  }
+
   virtual CValue *FindIdentifier(const std::string &identifiername);
 
   virtual std::string GetText();
@@ -176,7 +215,7 @@ class CValue : public PyObjectPlus, public CM_RefCount<CValue> {
 
  private:
   /// Properties for user/game etc.
-  std::map<std::string, CValue *> *m_pNamedPropertyArray;
+  CPropertyTable *m_propertyTable;
   bool m_error;
 };
 
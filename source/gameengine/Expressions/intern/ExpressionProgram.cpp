@@ -0,0 +1,471 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Expressions/intern/ExpressionProgram.cpp
+ *  \ingroup expressions
+ */
+
+#include "EXP_ExpressionProgram.h"
+
+#include <cmath>
+
+#include "BLI_utildefines.h"
+
+CExpressionProgram::CExpressionProgram() : m_result(-1)
+{
+}
+
+CExpressionProgram::~CExpressionProgram()
+{
+}
+
+void CExpressionProgram::Clear()
+{
+  m_instructions.clear();
+  m_registers.clear();
+  m_registerTypes.clear();
+  m_inputs.clear();
+  m_result = -1;
+}
+
+int CExpressionProgram::AddRegister(RegisterType type)
+{
+  m_registers.push_back(Register());
+  m_registerTypes.push_back(type);
+  return m_registers.size() - 1;
+}
+
+int CExpressionProgram::AddInstruction(
+    OpCode op, RegisterType type, int src0, int src1, int src2)
+{
+  const int dst = AddRegister(type);
+  const Instruction instruction = {
+      op, (unsigned int)dst, {(unsigned int)src0, (unsigned int)src1, (unsigned int)src2}};
+  m_instructions.push_back(instruction);
+  return dst;
+}
+
+int CExpressionProgram::ToFloat(int reg)
+{
+  if (m_registerTypes[reg] != REGISTER_INT) {
+    return reg;
+  }
+  return AddInstruction(OP_INT_TO_FLOAT, REGISTER_FLOAT, reg);
+}
+
+int CExpressionProgram::AddInput(const std::string &name, RegisterType type)
+{
+  for (const Input &input : m_inputs) {
+    if (input.m_name == name) {
+      return input.m_register;
+    }
+  }
+
+  const int reg = AddRegister(type);
+  m_inputs.push_back({name, (unsigned int)reg});
+  return reg;
+}
+
+int CExpressionProgram::AddBoolConstant(bool value)
+{
+  const int reg = AddRegister(REGISTER_BOOL);
+  m_registers[reg].m_bool = value;
+  return reg;
+}
+
+int CExpressionProgram::AddIntConstant(cInt value)
+{
+  const int reg = AddRegister(REGISTER_INT);
+  m_registers[reg].m_int = value;
+  return reg;
+}
+
+int CExpressionProgram::AddFloatConstant(float value)
+{
+  const int reg = AddRegister(REGISTER_FLOAT);
+  m_registers[reg].m_float = value;
+  return reg;
+}
+
+int CExpressionProgram::AddOperator(VALUE_OPERATOR op, int reg)
+{
+  if (reg == -1) {
+    return -1;
+  }
+
+  switch (m_registerTypes[reg]) {
+    case REGISTER_BOOL: {
+      if (op == VALUE_NOT_OPERATOR) {
+        return AddInstruction(OP_NOT_BOOL, REGISTER_BOOL, reg);
+      }
+      break;
+    }
+    case REGISTER_INT: {
+      switch (op) {
+        case VALUE_POS_OPERATOR: {
+          return reg;
+        }
+        case VALUE_NEG_OPERATOR: {
+          return AddInstruction(OP_NEG_INT, REGISTER_INT, reg);
+        }
+        case VALUE_NOT_OPERATOR: {
+          return AddInstruction(OP_NOT_INT, REGISTER_BOOL, reg);
+        }
+        default: {
+          break;
+        }
+      }
+      break;
+    }
+    case REGISTER_FLOAT: {
+      switch (op) {
+        case VALUE_POS_OPERATOR: {
+          return reg;
+        }
+        case VALUE_NEG_OPERATOR: {
+          return AddInstruction(OP_NEG_FLOAT, REGISTER_FLOAT, reg);
+        }
+        case VALUE_NOT_OPERATOR: {
+          return AddInstruction(OP_NOT_FLOAT, REGISTER_BOOL, reg);
+        }
+        default: {
+          break;
+        }
+      }
+      break;
+    }
+  }
+
+  return -1;
+}
+
+int CExpressionProgram::AddOperator(VALUE_OPERATOR op, int lhs, int rhs)
+{
+  if (lhs == -1 || rhs == -1) {
+    return -1;
+  }
+
+  const RegisterType ltype = m_registerTypes[lhs];
+  const RegisterType rtype = m_registerTypes[rhs];
+
+  // Booleans are only combined with booleans.
+  if (ltype == REGISTER_BOOL || rtype == REGISTER_BOOL) {
+    if (ltype != rtype) {
+      return -1;
+    }
+    switch (op) {
+      case VALUE_AND_OPERATOR: {
+        return AddInstruction(OP_AND_BOOL, REGISTER_BOOL, lhs, rhs);
+      }
+      case VALUE_OR_OPERATOR: {
+        return AddInstruction(OP_OR_BOOL, REGISTER_BOOL, lhs, rhs);
+      }
+      case VALUE_EQL_OPERATOR: {
+        return AddInstruction(OP_EQL_BOOL, REGISTER_BOOL, lhs, rhs);
+      }
+      case VALUE_NEQ_OPERATOR: {
+        return AddInstruction(OP_NEQ_BOOL, REGISTER_BOOL, lhs, rhs);
+      }
+      default: {
+        return -1;
+      }
+    }
+  }
+
+  // Integers are promoted to float when mixed with a float, as in CIntValue::CalcFinal.
+  const bool isint = (ltype == REGISTER_INT && rtype == REGISTER_INT);
+  if (!isint) {
+    lhs = ToFloat(lhs);
+    rhs = ToFloat(rhs);
+  }
+  const RegisterType type = isint ? REGISTER_INT : REGISTER_FLOAT;
+
+  switch (op) {
+    case VALUE_MOD_OPERATOR: {
+      return AddInstruction(isint ? OP_MOD_INT : OP_MOD_FLOAT, type, lhs, rhs);
+    }
+    case VALUE_ADD_OPERATOR: {
+      return AddInstruction(isint ? OP_ADD_INT : OP_ADD_FLOAT, type, lhs, rhs);
+    }
+    case VALUE_SUB_OPERATOR: {
+      return AddInstruction(isint ? OP_SUB_INT : OP_SUB_FLOAT, type, lhs, rhs);
+    }
+    case VALUE_MUL_OPERATOR: {
+      return AddInstruction(isint ? OP_MUL_INT : OP_MUL_FLOAT, type, lhs, rhs);
+    }
+    case VALUE_DIV_OPERATOR: {
+      return AddInstruction(isint ? OP_DIV_INT : OP_DIV_FLOAT, type, lhs, rhs);
+    }
+    case VALUE_EQL_OPERATOR: {
+      return AddInstruction(isint ? OP_EQL_INT : OP_EQL_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    case VALUE_NEQ_OPERATOR: {
+      return AddInstruction(isint ? OP_NEQ_INT : OP_NEQ_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    case VALUE_GRE_OPERATOR: {
+      return AddInstruction(isint ? OP_GRE_INT : OP_GRE_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    case VALUE_LES_OPERATOR: {
+      return AddInstruction(isint ? OP_LES_INT : OP_LES_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    case VALUE_GEQ_OPERATOR: {
+      return AddInstruction(isint ? OP_GEQ_INT : OP_GEQ_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    case VALUE_LEQ_OPERATOR: {
+      return AddInstruction(isint ? OP_LEQ_INT : OP_LEQ_FLOAT, REGISTER_BOOL, lhs, rhs);
+    }
+    default: {
+      return -1;
+    }
+  }
+}
+
+int CExpressionProgram::AddSelect(int guard, int e1, int e2)
+{
+  if (guard == -1 || e1 == -1 || e2 == -1 || m_registerTypes[guard] != REGISTER_BOOL ||
+      m_registerTypes[e1] != m_registerTypes[e2]) {
+    return -1;
+  }
+
+  return AddInstruction(OP_SELECT, m_registerTypes[e1], guard, e1, e2);
+}
+
+void CExpressionProgram::SetResult(int reg)
+{
+  m_result = reg;
+}
+
+unsigned int CExpressionProgram::GetInputCount() const
+{
+  return m_inputs.size();
+}
+
+const std::string &CExpressionProgram::GetInputName(unsigned int index) const
+{
+  return m_inputs[index].m_name;
+}
+
+CExpressionProgram::RegisterType CExpressionProgram::GetInputType(unsigned int index) const
+{
+  return m_registerTypes[m_inputs[index].m_register];
+}
+
+void CExpressionProgram::SetBoolInput(unsigned int index, bool value)
+{
+  m_registers[m_inputs[index].m_register].m_bool = value;
+}
+
+void CExpressionProgram::SetIntInput(unsigned int index, cInt value)
+{
+  m_registers[m_inputs[index].m_register].m_int = value;
+}
+
+void CExpressionProgram::SetFloatInput(unsigned int index, float value)
+{
+  m_registers[m_inputs[index].m_register].m_float = value;
+}
+
+bool CExpressionProgram::Execute(double &result, const char *&error)
+{
+  if (m_result == -1) {
+    error = "Invalid expression";
+    return false;
+  }
+
+  Register *regs = m_registers.data();
+
+  for (const Instruction &instruction : m_instructions) {
+    Register &dst = regs[instruction.m_dst];
+    const Register &a = regs[instruction.m_src[0]];
+    const Register &b = regs[instruction.m_src[1]];
+
+    switch (instruction.m_op) {
+      case OP_INT_TO_FLOAT: {
+        dst.m_float = (float)a.m_int;
+        break;
+      }
+      case OP_SELECT: {
+        dst = a.m_bool ? b : regs[instruction.m_src[2]];
+        break;
+      }
+      case OP_NOT_BOOL: {
+        dst.m_bool = !a.m_bool;
+        break;
+      }
+      case OP_AND_BOOL: {
+        dst.m_bool = a.m_bool && b.m_bool;
+        break;
+      }
+      case OP_OR_BOOL: {
+        dst.m_bool = a.m_bool || b.m_bool;
+        break;
+      }
+      case OP_EQL_BOOL: {
+        dst.m_bool = (a.m_bool == b.m_bool);
+        break;
+      }
+      case OP_NEQ_BOOL: {
+        dst.m_bool = (a.m_bool != b.m_bool);
+        break;
+      }
+      case OP_NEG_INT: {
+        dst.m_int = -a.m_int;
+        break;
+      }
+      case OP_NOT_INT: {
+        dst.m_bool = (a.m_int == 0);
+        break;
+      }
+      case OP_MOD_INT: {
+        if (b.m_int == 0) {
+          error = "Division by zero";
+          return false;
+        }
+        dst.m_int = a.m_int % b.m_int;
+        break;
+      }
+      case OP_ADD_INT: {
+        dst.m_int = a.m_int + b.m_int;
+        break;
+      }
+      case OP_SUB_INT: {
+        dst.m_int = a.m_int - b.m_int;
+        break;
+      }
+      case OP_MUL_INT: {
+        dst.m_int = a.m_int * b.m_int;
+        break;
+      }
+      case OP_DIV_INT: {
+        if (b.m_int == 0) {
+          error = (a.m_int == 0) ? "Not a Number" : "Division by zero";
+          return false;
+        }
+        dst.m_int = a.m_int / b.m_int;
+        break;
+      }
+      case OP_EQL_INT: {
+        dst.m_bool = (a.m_int == b.m_int);
+        break;
+      }
+      case OP_NEQ_INT: {
+        dst.m_bool = (a.m_int != b.m_int);
+        break;
+      }
+      case OP_GRE_INT: {
+        dst.m_bool = (a.m_int > b.m_int);
+        break;
+      }
+      case OP_LES_INT: {
+        dst.m_bool = (a.m_int < b.m_int);
+        break;
+      }
+      case OP_GEQ_INT: {
+        dst.m_bool = (a.m_int >= b.m_int);
+        break;
+      }
+      case OP_LEQ_INT: {
+        dst.m_bool = (a.m_int <= b.m_int);
+        break;
+      }
+      case OP_NEG_FLOAT: {
+        dst.m_float = -a.m_float;
+        break;
+      }
+      case OP_NOT_FLOAT: {
+        dst.m_bool = (a.m_float == 0.0f);
+        break;
+      }
+      case OP_MOD_FLOAT: {
+        dst.m_float = fmod(a.m_float, b.m_float);
+        break;
+      }
+      case OP_ADD_FLOAT: {
+        dst.m_float = a.m_float + b.m_float;
+        break;
+      }
+      case OP_SUB_FLOAT: {
+        dst.m_float = a.m_float - b.m_float;
+        break;
+      }
+      case OP_MUL_FLOAT: {
+        dst.m_float = a.m_float * b.m_float;
+        break;
+      }
+      case OP_DIV_FLOAT: {
+        if (b.m_float == 0.0f) {
+          error = "Division by zero";
+          return false;
+        }
+        dst.m_float = a.m_float / b.m_float;
+        break;
+      }
+      case OP_EQL_FLOAT: {
+        dst.m_bool = (a.m_float == b.m_float);
+        break;
+      }
+      case OP_NEQ_FLOAT: {
+        dst.m_bool = (a.m_float != b.m_float);
+        break;
+      }
+      case OP_GRE_FLOAT: {
+        dst.m_bool = (a.m_float > b.m_float);
+        break;
+      }
+      case OP_LES_FLOAT: {
+        dst.m_bool = (a.m_float < b.m_float);
+        break;
+      }
+      case OP_GEQ_FLOAT: {
+        dst.m_bool = (a.m_float >= b.m_float);
+        break;
+      }
+      case OP_LEQ_FLOAT: {
+        dst.m_bool = (a.m_float <= b.m_float);
+        break;
+      }
+      default: {
+        BLI_assert(false);
+        error = "Invalid expression";
+        return false;
+      }
+    }
+  }
+
+  const Register &reg = regs[m_result];
+  switch (m_registerTypes[m_result]) {
+    case REGISTER_BOOL: {
+      result = (double)reg.m_bool;
+      break;
+    }
+    case REGISTER_INT: {
+      result = (double)reg.m_int;
+      break;
+    }
+    case REGISTER_FLOAT: {
+      result = (double)reg.m_float;
+      break;
+    }
+  }
+
+  return true;
+}
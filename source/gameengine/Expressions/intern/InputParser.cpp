@@ -26,6 +26,7 @@
 #include "EXP_ConstExpr.h"
 #include "EXP_EmptyValue.h"
 #include "EXP_ErrorValue.h"
+#include "EXP_ExpressionProgram.h"
 #include "EXP_FloatValue.h"
 #include "EXP_IdentifierExpr.h"
 #include "EXP_IntValue.h"
@@ -623,6 +624,194 @@ CExpression *CParser::Ex(int i)
   return e1;
 }
 
+int CParser::CompileIdentifier(CExpressionProgram &program)
+{
+  /* Adds the current identifier as an input of the program, typed by its value
+   * in the context. Sub-contexts (names with a dot) are not compiled.
+   */
+  if (!m_identifierContext || const_as_string.find('.') != std::string::npos) {
+    return -1;
+  }
+
+  CValue *value = m_identifierContext->FindIdentifier(const_as_string);
+  if (!value) {
+    return -1;
+  }
+
+  int reg = -1;
+  switch (value->GetValueType()) {
+    case VALUE_BOOL_TYPE: {
+      reg = program.AddInput(const_as_string, CExpressionProgram::REGISTER_BOOL);
+      break;
+    }
+    case VALUE_INT_TYPE: {
+      reg = program.AddInput(const_as_string, CExpressionProgram::REGISTER_INT);
+      break;
+    }
+    case VALUE_FLOAT_TYPE: {
+      reg = program.AddInput(const_as_string, CExpressionProgram::REGISTER_FLOAT);
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  value->Release();
+
+  return reg;
+}
+
+int CParser::CompileEx(int i, CExpressionProgram &program)
+{
+  /* Compiles an expression in the input, starting at priority i, the same way Ex parses it.
+   * Returns the register holding the result, or -1 if the expression can't be compiled.
+   */
+  int r1 = -1;
+
+  if (i < NUM_PRIORITY) {
+    r1 = CompileEx(i + 1, program);
+    while ((r1 != -1) && (sym == opsym) && (Priority(opkind) == i)) {
+      int opkind2 = opkind;
+      NextSym();
+      const int r2 = CompileEx(i + 1, program);
+      VALUE_OPERATOR op;
+      switch (opkind2) {
+        case OPmodulus: {
+          op = VALUE_MOD_OPERATOR;
+        } break;
+        case OPplus: {
+          op = VALUE_ADD_OPERATOR;
+        } break;
+        case OPminus: {
+          op = VALUE_SUB_OPERATOR;
+        } break;
+        case OPtimes: {
+          op = VALUE_MUL_OPERATOR;
+        } break;
+        case OPdivide: {
+          op = VALUE_DIV_OPERATOR;
+        } break;
+        case OPand: {
+          op = VALUE_AND_OPERATOR;
+        } break;
+        case OPor: {
+          op = VALUE_OR_OPERATOR;
+        } break;
+        case OPequal: {
+          op = VALUE_EQL_OPERATOR;
+        } break;
+        case OPunequal: {
+          op = VALUE_NEQ_OPERATOR;
+        } break;
+        case OPgreater: {
+          op = VALUE_GRE_OPERATOR;
+        } break;
+        case OPless: {
+          op = VALUE_LES_OPERATOR;
+        } break;
+        case OPgreaterequal: {
+          op = VALUE_GEQ_OPERATOR;
+        } break;
+        case OPlessequal: {
+          op = VALUE_LEQ_OPERATOR;
+        } break;
+        default: {
+          return -1;
+        }
+      }
+      r1 = program.AddOperator(op, r1, r2);
+    }
+  }
+  else if (i == NUM_PRIORITY) {
+    if ((sym == opsym) && ((opkind == OPminus) || (opkind == OPnot) || (opkind == OPplus))) {
+      NextSym();
+      switch (opkind) {
+        case OPplus: {
+          r1 = program.AddOperator(VALUE_POS_OPERATOR, CompileEx(NUM_PRIORITY, program));
+        } break;
+        case OPminus: {
+          r1 = program.AddOperator(VALUE_NEG_OPERATOR, CompileEx(NUM_PRIORITY, program));
+        } break;
+        case OPnot: {
+          r1 = program.AddOperator(VALUE_NOT_OPERATOR, CompileEx(NUM_PRIORITY, program));
+        } break;
+        default: {
+          return -1;
+        }
+      }
+    }
+    else {
+      switch (sym) {
+        case constsym: {
+          switch (constkind) {
+            case booltype: {
+              r1 = program.AddBoolConstant(boolvalue);
+              break;
+            }
+            case inttype: {
+              r1 = program.AddIntConstant(std::stol(const_as_string, nullptr, 10));
+              break;
+            }
+            case floattype: {
+              r1 = program.AddFloatConstant(std::stof(const_as_string));
+              break;
+            }
+            default: {
+              // Strings are not compiled.
+              return -1;
+            }
+          }
+          NextSym();
+          break;
+        }
+        case lbracksym: {
+          NextSym();
+          r1 = CompileEx(1, program);
+          if (sym != rbracksym) {
+            return -1;
+          }
+          NextSym();
+          break;
+        }
+        case ifsym: {
+          NextSym();
+          if (sym != lbracksym) {
+            return -1;
+          }
+          NextSym();
+          const int guard = CompileEx(1, program);
+          if (sym != commasym) {
+            return -1;
+          }
+          NextSym();
+          const int r2 = CompileEx(1, program);
+          // Without a third expression the result is an empty value, it is not compiled.
+          if (sym != commasym) {
+            return -1;
+          }
+          NextSym();
+          const int r3 = CompileEx(1, program);
+          if (sym != rbracksym) {
+            return -1;
+          }
+          NextSym();
+          r1 = program.AddSelect(guard, r2, r3);
+          break;
+        }
+        case idsym: {
+          r1 = CompileIdentifier(program);
+          NextSym();
+          break;
+        }
+        default: {
+          return -1;
+        }
+      }
+    }
+  }
+  return r1;
+}
+
 CExpression *CParser::Expr()
 {
   // parses an expression in the imput, and
@@ -668,6 +857,33 @@ CExpression *CParser::ProcessText(const std::string &intext)
   return expr;
 }
 
+bool CParser::CompileText(const std::string &intext, CExpressionProgram &program)
+{
+  program.Clear();
+
+  text = intext;
+  chcount = 0;
+  if (text.empty()) {
+    return false;
+  }
+
+  ch = text[0];
+  NextSym();
+  const int reg = CompileEx(1, program);
+  if (errmsg) {
+    errmsg->Release();
+    errmsg = nullptr;
+  }
+
+  if (reg == -1 || sym != eolsym) {
+    program.Clear();
+    return false;
+  }
+
+  program.SetResult(reg);
+  return true;
+}
+
 void CParser::SetContext(CValue *context)
 {
   if (m_identifierContext) {
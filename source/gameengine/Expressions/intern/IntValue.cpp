@@ -78,7 +78,12 @@ CValue *CIntValue::CalcFinal(VALUE_DATA_TYPE dtype, VALUE_OPERATOR op, CValue *v
     case VALUE_INT_TYPE: {
       switch (op) {
         case VALUE_MOD_OPERATOR: {
-          ret = new CIntValue(((CIntValue *)val)->GetInt() % m_int);
+          if (m_int == 0) {
+            ret = new CErrorValue("Division by zero");
+          }
+          else {
+            ret = new CIntValue(((CIntValue *)val)->GetInt() % m_int);
+          }
           break;
         }
         case VALUE_ADD_OPERATOR: {
@@ -280,6 +285,11 @@ CValue *CIntValue::GetReplica()
   return replica;
 }
 
+void CIntValue::SetInt(cInt innie)
+{
+  m_int = innie;
+}
+
 void CIntValue::SetValue(CValue *newval)
 {
   m_int = (cInt)newval->GetNumber();
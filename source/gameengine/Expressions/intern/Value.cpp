@@ -71,7 +71,7 @@ PyMethodDef CValue::Methods[] = {
 };
 #endif  // WITH_PYTHON
 
-CValue::CValue() : m_pNamedPropertyArray(nullptr), m_error(false)
+CValue::CValue() : m_propertyTable(nullptr), m_error(false)
 {
 }
 
@@ -154,33 +154,26 @@ void CValue::SetProperty(const std::string &name, CValue *ioProperty)
     return;
   }
 
-  // Try to replace property (if so -> exit as soon as we replaced it).
-  if (m_pNamedPropertyArray) {
-    CValue *oldval = (*m_pNamedPropertyArray)[name];
-    if (oldval) {
-      oldval->Release();
-    }
+  // Also creates the property table if needed.
+  const int slot = RegisterPropertySlot(name);
+
+  // Try to replace property.
+  CValue *&value = m_propertyTable->m_values[slot];
+  if (value) {
+    value->Release();
   }
-  // Make sure we have a property array.
   else {
-    m_pNamedPropertyArray = new std::map<std::string, CValue *>;
+    ++m_propertyTable->m_count;
   }
 
-  // Add property at end of array.
-  (*m_pNamedPropertyArray)[name] = ioProperty->AddRef();
+  value = ioProperty->AddRef();
 }
 
 /// Get pointer to a property with name <inName>, returns nullptr if there is no property named
 /// <inName>.
 CValue *CValue::GetProperty(const std::string &inName)
 {
-  if (m_pNamedPropertyArray) {
-    std::map<std::string, CValue *>::iterator it = m_pNamedPropertyArray->find(inName);
-    if (it != m_pNamedPropertyArray->end()) {
-      return (*it).second;
-    }
-  }
-  return nullptr;
+  return GetPropertyFromSlot(GetPropertySlot(inName));
 }
 
 /// Get text description of property with name <inName>, returns an empty string if there is no
@@ -211,14 +204,16 @@ float CValue::GetPropertyNumber(const std::string &inName, float defnumber)
 /// if property was not found or could not be removed.
 bool CValue::RemoveProperty(const std::string &inName)
 {
+  const int slot = GetPropertySlot(inName);
+  CValue *property = GetPropertyFromSlot(slot);
   // Check if there are properties at all which can be removed.
-  if (m_pNamedPropertyArray) {
-    std::map<std::string, CValue *>::iterator it = m_pNamedPropertyArray->find(inName);
-    if (it != m_pNamedPropertyArray->end()) {
-      ((*it).second)->Release();
-      m_pNamedPropertyArray->erase(it);
-      return true;
-    }
+  if (property) {
+    /* Keep the name in the layout, its slot can be used by replicas and logic bricks, and is
+     * reused when the property is set again. */
+    property->Release();
+    m_propertyTable->m_values[slot] = nullptr;
+    --m_propertyTable->m_count;
+    return true;
   }
 
   return false;
@@ -228,14 +223,16 @@ bool CValue::RemoveProperty(const std::string &inName)
 std::vector<std::string> CValue::GetPropertyNames()
 {
   std::vector<std::string> result;
-  if (!m_pNamedPropertyArray) {
+  if (!m_propertyTable) {
     return result;
   }
-  result.reserve(m_pNamedPropertyArray->size());
+  result.reserve(m_propertyTable->m_count);
 
-  std::map<std::string, CValue *>::iterator it;
-  for (it = m_pNamedPropertyArray->begin(); (it != m_pNamedPropertyArray->end()); it++) {
-    result.push_back((*it).first);
+  for (const std::pair<const std::string, unsigned int> &pair :
+       m_propertyTable->m_layout->m_slots) {
+    if (m_propertyTable->m_values[pair.second]) {
+      result.push_back(pair.first);
+    }
   }
   return result;
 }
@@ -244,20 +241,21 @@ std::vector<std::string> CValue::GetPropertyNames()
 void CValue::ClearProperties()
 {
   // Check if we have any properties.
-  if (m_pNamedPropertyArray == nullptr) {
+  if (m_propertyTable == nullptr) {
     return;
   }
 
   // Remove all properties.
-  std::map<std::string, CValue *>::iterator it;
-  for (it = m_pNamedPropertyArray->begin(); (it != m_pNamedPropertyArray->end()); it++) {
-    CValue *tmpval = (*it).second;
-    tmpval->Release();
+  for (CValue *value : m_propertyTable->m_values) {
+    if (value) {
+      value->Release();
+    }
   }
 
-  // Delete property array.
-  delete m_pNamedPropertyArray;
-  m_pNamedPropertyArray = nullptr;
+  // Delete property table.
+  m_propertyTable->m_layout->Release();
+  delete m_propertyTable;
+  m_propertyTable = nullptr;
 }
 
 /// Get property number <inIndex>.
@@ -266,11 +264,12 @@ CValue *CValue::GetProperty(int inIndex)
   int count = 0;
   CValue *result = nullptr;
 
-  if (m_pNamedPropertyArray) {
-    std::map<std::string, CValue *>::iterator it;
-    for (it = m_pNamedPropertyArray->begin(); (it != m_pNamedPropertyArray->end()); it++) {
-      if (count++ == inIndex) {
-        result = (*it).second;
+  if (m_propertyTable) {
+    for (const std::pair<const std::string, unsigned int> &pair :
+         m_propertyTable->m_layout->m_slots) {
+      CValue *value = m_propertyTable->m_values[pair.second];
+      if (value && count++ == inIndex) {
+        result = value;
         break;
       }
     }
@@ -281,14 +280,54 @@ CValue *CValue::GetProperty(int inIndex)
 /// Get the amount of properties assiocated with this value.
 int CValue::GetPropertyCount()
 {
-  if (m_pNamedPropertyArray) {
-    return m_pNamedPropertyArray->size();
+  if (m_propertyTable) {
+    return m_propertyTable->m_count;
   }
   else {
     return 0;
   }
 }
 
+int CValue::RegisterPropertySlot(const std::string &inName)
+{
+  // Make sure we have a property table.
+  if (!m_propertyTable) {
+    m_propertyTable = new CPropertyTable();
+    m_propertyTable->m_layout = new CPropertyLayout();
+    m_propertyTable->m_count = 0;
+  }
+
+  CPropertyLayout *layout = m_propertyTable->m_layout;
+  std::map<std::string, unsigned int>::const_iterator it = layout->m_slots.find(inName);
+  if (it != layout->m_slots.end()) {
+    return it->second;
+  }
+
+  // The layout is shared with replicas, copy it before adding the name.
+  if (layout->GetRefCount() > 1) {
+    CPropertyLayout *newLayout = new CPropertyLayout(*layout);
+    layout->Release();
+    layout = m_propertyTable->m_layout = newLayout;
+  }
+  const unsigned int slot = m_propertyTable->m_values.size();
+  layout->m_slots[inName] = slot;
+  m_propertyTable->m_values.push_back(nullptr);
+
+  return slot;
+}
+
+int CValue::GetPropertySlot(const std::string &inName) const
+{
+  if (m_propertyTable) {
+    const std::map<std::string, unsigned int> &slots = m_propertyTable->m_layout->m_slots;
+    std::map<std::string, unsigned int>::const_iterator it = slots.find(inName);
+    if (it != slots.end()) {
+      return it->second;
+    }
+  }
+  return -1;
+}
+
 void CValue::DestructFromPython()
 {
 #ifdef WITH_PYTHON
@@ -302,15 +341,14 @@ void CValue::ProcessReplica()
 {
   PyObjectPlus::ProcessReplica();
 
-  // Copy all props.
-  if (m_pNamedPropertyArray) {
-    std::map<std::string, CValue *> *pOldArray = m_pNamedPropertyArray;
-    m_pNamedPropertyArray = nullptr;
-    std::map<std::string, CValue *>::iterator it;
-    for (it = pOldArray->begin(); (it != pOldArray->end()); it++) {
-      CValue *val = (*it).second->GetReplica();
-      SetProperty((*it).first, val);
-      val->Release();
+  // Copy all props, the replica shares the layout of the original.
+  if (m_propertyTable) {
+    m_propertyTable = new CPropertyTable(*m_propertyTable);
+    m_propertyTable->m_layout->AddRef();
+    for (CValue *&value : m_propertyTable->m_values) {
+      if (value) {
+        value = value->GetReplica();
+      }
     }
   }
 }
@@ -411,13 +449,15 @@ CValue *CValue::ConvertPythonToValue(PyObject *pyobj,
 
 PyObject *CValue::ConvertKeysToPython(void)
 {
-  if (m_pNamedPropertyArray) {
-    PyObject *pylist = PyList_New(m_pNamedPropertyArray->size());
+  if (m_propertyTable) {
+    PyObject *pylist = PyList_New(m_propertyTable->m_count);
     Py_ssize_t i = 0;
 
-    std::map<std::string, CValue *>::iterator it;
-    for (it = m_pNamedPropertyArray->begin(); (it != m_pNamedPropertyArray->end()); it++) {
-      PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString((*it).first));
+    for (const std::pair<const std::string, unsigned int> &pair :
+         m_propertyTable->m_layout->m_slots) {
+      if (m_propertyTable->m_values[pair.second]) {
+        PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(pair.first));
+      }
     }
 
     return pylist;
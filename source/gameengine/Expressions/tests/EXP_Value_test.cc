@@ -0,0 +1,60 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "EXP_IntValue.h"
+
+/* Removing and setting again a property must reuse its slot, the property table of a value
+ * doesn't grow with properties set and removed each frame. */
+TEST(ge_expressions, PropertySlotReusedAfterRemove)
+{
+  CIntValue *value = new CIntValue(0);
+  CIntValue *property = new CIntValue(1);
+
+  value->SetProperty("tmp", property);
+  const int slot = value->GetPropertySlot("tmp");
+  EXPECT_EQ(slot, 0);
+
+  for (unsigned int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(value->RemoveProperty("tmp"));
+    EXPECT_EQ(value->GetProperty("tmp"), nullptr);
+    EXPECT_EQ(value->GetPropertyCount(), 0);
+
+    value->SetProperty("tmp", property);
+    EXPECT_EQ(value->GetPropertySlot("tmp"), slot);
+    EXPECT_EQ(value->GetProperty("tmp"), property);
+  }
+
+  // A new name takes the next slot: the table still has a single slot.
+  EXPECT_EQ(value->RegisterPropertySlot("other"), 1);
+
+  property->Release();
+  value->Release();
+}
+
+/* A replica shares the layout of its original, removing and setting again a property in the
+ * replica keeps its slot. */
+TEST(ge_expressions, PropertySlotSharedByReplica)
+{
+  CIntValue *value = new CIntValue(0);
+  CIntValue *property = new CIntValue(1);
+
+  value->SetProperty("tmp", property);
+  CValue *replica = value->GetReplica();
+  const int slot = replica->GetPropertySlot("tmp");
+  EXPECT_EQ(slot, value->GetPropertySlot("tmp"));
+
+  for (unsigned int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(replica->RemoveProperty("tmp"));
+    replica->SetProperty("tmp", property);
+    EXPECT_EQ(replica->GetPropertySlot("tmp"), slot);
+  }
+  EXPECT_EQ(replica->RegisterPropertySlot("other"), 1);
+
+  // The original is not affected by the replica.
+  EXPECT_NE(value->GetProperty("tmp"), nullptr);
+
+  replica->Release();
+  property->Release();
+  value->Release();
+}
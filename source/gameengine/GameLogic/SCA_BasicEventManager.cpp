@@ -35,10 +35,12 @@
 
 #include "SCA_BasicEventManager.h"
 
+#include <algorithm>
+
 #include "SCA_ISensor.h"
 
 SCA_BasicEventManager::SCA_BasicEventManager(class SCA_LogicManager *logicmgr)
-    : SCA_EventManager(logicmgr, BASIC_EVENTMGR)
+    : SCA_EventManager(logicmgr, BASIC_EVENTMGR), m_frame(0)
 {
 }
 
@@ -46,9 +48,89 @@ SCA_BasicEventManager::~SCA_BasicEventManager()
 {
 }
 
+void SCA_BasicEventManager::PlanActivation(SCA_ISensor *sensor, unsigned int frame)
+{
+  if (sensor->m_nextActivationFrame != 0) {
+    if (sensor->m_nextActivationFrame <= frame) {
+      return;
+    }
+    CancelActivation(sensor);
+  }
+
+  sensor->m_nextActivationFrame = frame;
+  m_activationWheel[frame % ACTIVATION_WHEEL_SIZE].push_back(sensor);
+}
+
+void SCA_BasicEventManager::CancelActivation(SCA_ISensor *sensor)
+{
+  std::vector<SCA_ISensor *> &slot =
+      m_activationWheel[sensor->m_nextActivationFrame % ACTIVATION_WHEEL_SIZE];
+  slot.erase(std::find(slot.begin(), slot.end(), sensor));
+  sensor->m_nextActivationFrame = 0;
+}
+
+bool SCA_BasicEventManager::RegisterSensor(SCA_ISensor *sensor)
+{
+  if (!sensor->IsEventDriven()) {
+    return SCA_EventManager::RegisterSensor(sensor);
+  }
+
+  // A registered sensor is activated at the next frame as a polled sensor.
+  sensor->m_activationFrame = m_frame;
+  PlanActivation(sensor, m_frame + 1);
+  return true;
+}
+
+bool SCA_BasicEventManager::RemoveSensor(SCA_ISensor *sensor)
+{
+  if (!sensor->IsEventDriven()) {
+    return SCA_EventManager::RemoveSensor(sensor);
+  }
+
+  if (sensor->m_nextActivationFrame != 0) {
+    CancelActivation(sensor);
+  }
+  return true;
+}
+
+void SCA_BasicEventManager::WakeSensor(SCA_ISensor *sensor)
+{
+  if (sensor->IsEventDriven()) {
+    PlanActivation(sensor, m_frame + 1);
+  }
+}
+
 void SCA_BasicEventManager::NextFrame()
 {
   for (SCA_ISensor *sensor : m_sensors) {
     sensor->Activate(m_logicmgr);
   }
+
+  ++m_frame;
+
+  // Extract the sensors of the current frame from the slot.
+  std::vector<SCA_ISensor *> &slot = m_activationWheel[m_frame % ACTIVATION_WHEEL_SIZE];
+  unsigned int size = 0;
+  for (SCA_ISensor *sensor : slot) {
+    if (sensor->m_nextActivationFrame == m_frame) {
+      sensor->m_nextActivationFrame = 0;
+      m_activatedSensors.push_back(sensor);
+    }
+    else {
+      slot[size++] = sensor;
+    }
+  }
+  slot.resize(size);
+
+  for (SCA_ISensor *sensor : m_activatedSensors) {
+    sensor->SkipFrames(m_frame - sensor->m_activationFrame - 1);
+    sensor->m_activationFrame = m_frame;
+    sensor->Activate(m_logicmgr);
+
+    const int delay = sensor->GetActivationDelay();
+    if (delay > 0) {
+      PlanActivation(sensor, m_frame + delay);
+    }
+  }
+  m_activatedSensors.clear();
 }
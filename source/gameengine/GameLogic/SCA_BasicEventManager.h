@@ -37,11 +37,33 @@
 
 #include "SCA_EventManager.h"
 
+/** Activate the sensors polled every frame and the event driven sensors when their inputs
+ * changed or when a pulse is expected, see SCA_ISensor::IsEventDriven.
+ */
 class SCA_BasicEventManager : public SCA_EventManager {
+ private:
+  enum { ACTIVATION_WHEEL_SIZE = 64 };
+
+  /** Event driven sensors planned for activation, indexed by their activation frame modulo
+   * the wheel size. A sensor is in at most one slot, sensors planned for a later turn of the
+   * wheel stay in their slot until their frame.
+   */
+  std::vector<SCA_ISensor *> m_activationWheel[ACTIVATION_WHEEL_SIZE];
+  /// Sensors activated in the current frame, kept to reuse the allocation.
+  std::vector<SCA_ISensor *> m_activatedSensors;
+  /// Number of frames since the creation of the manager.
+  unsigned int m_frame;
+
+  void PlanActivation(SCA_ISensor *sensor, unsigned int frame);
+  void CancelActivation(SCA_ISensor *sensor);
+
  public:
   SCA_BasicEventManager(class SCA_LogicManager *logicmgr);
   ~SCA_BasicEventManager();
 
+  virtual bool RegisterSensor(SCA_ISensor *sensor);
+  virtual bool RemoveSensor(SCA_ISensor *sensor);
+  virtual void WakeSensor(SCA_ISensor *sensor);
   virtual void NextFrame();
 };
 
@@ -70,6 +70,8 @@ class SCA_EventManager {
   virtual void UpdateFrame();
   virtual void EndFrame();
   virtual bool RegisterSensor(class SCA_ISensor *sensor);
+  /// Request the activation at the next frame of a sensor waiting for its inputs.
+  virtual void WakeSensor(class SCA_ISensor *sensor);
   int GetType();
   // SG_DList &GetSensors() { return m_sensors; }
 
@@ -35,6 +35,8 @@
 #include "SCA_ExpressionController.h"
 
 #include "CM_Message.h"
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
 #include "EXP_InputParser.h"
 #include "SCA_ISensor.h"
 #include "SCA_LogicManager.h"
@@ -45,7 +47,11 @@
 
 SCA_ExpressionController::SCA_ExpressionController(SCA_IObject *gameobj,
                                                    const std::string &exprtext)
-    : SCA_IController(gameobj), m_exprText(exprtext), m_exprCache(nullptr)
+    : SCA_IController(gameobj),
+      m_exprText(exprtext),
+      m_exprCache(nullptr),
+      m_programState(PROGRAM_NONE),
+      m_boundPropertyTypes(0)
 {
 }
 
@@ -60,6 +66,10 @@ CValue *SCA_ExpressionController::GetReplica()
   SCA_ExpressionController *replica = new SCA_ExpressionController(*this);
   replica->m_exprText = m_exprText;
   replica->m_exprCache = nullptr;
+  replica->m_program.Clear();
+  replica->m_programState = PROGRAM_NONE;
+  replica->m_bindings.clear();
+  replica->m_boundSensors.clear();
   // this will copy properties and so on...
   replica->ProcessReplica();
 
@@ -77,9 +87,97 @@ void SCA_ExpressionController::Delete()
   Release();
 }
 
-void SCA_ExpressionController::Trigger(SCA_LogicManager *logicmgr)
+void SCA_ExpressionController::CompileProgram()
+{
+  m_programState = PROGRAM_UNSUPPORTED;
+  m_bindings.clear();
+  m_boundSensors = m_linkedsensors;
+  m_boundPropertyTypes = GetParent()->GetPropertyTypesRevision();
+
+  CParser parser;
+  parser.SetContext(this->AddRef());
+  if (!parser.CompileText(m_exprText, m_program)) {
+    return;
+  }
+
+  SCA_IObject *parent = GetParent();
+  for (unsigned int i = 0, size = m_program.GetInputCount(); i < size; ++i) {
+    const std::string &name = m_program.GetInputName(i);
+    InputBinding binding = {nullptr, -1};
+
+    // Sensors are found before properties as in FindIdentifier.
+    for (SCA_ISensor *sensor : m_linkedsensors) {
+      if (sensor->GetName() == name) {
+        binding.m_sensor = sensor;
+        break;
+      }
+    }
+
+    if (!binding.m_sensor) {
+      binding.m_propslot = parent->GetPropertySlot(name);
+      if (binding.m_propslot == -1) {
+        m_bindings.clear();
+        return;
+      }
+    }
+
+    m_bindings.push_back(binding);
+  }
+
+  m_programState = PROGRAM_VALID;
+}
+
+bool SCA_ExpressionController::LoadInputs()
 {
+  SCA_IObject *parent = GetParent();
+  for (unsigned int i = 0, size = m_bindings.size(); i < size; ++i) {
+    const InputBinding &binding = m_bindings[i];
+    if (binding.m_sensor) {
+      m_program.SetBoolInput(i, binding.m_sensor->GetState());
+      continue;
+    }
+
+    CValue *prop = parent->GetPropertyFromSlot(binding.m_propslot);
+    // The property was removed or replaced by a value of an other type, compile again.
+    if (!prop) {
+      m_programState = PROGRAM_NONE;
+      return false;
+    }
+
+    const int type = prop->GetValueType();
+    switch (m_program.GetInputType(i)) {
+      case CExpressionProgram::REGISTER_BOOL: {
+        if (type != VALUE_BOOL_TYPE) {
+          m_programState = PROGRAM_NONE;
+          return false;
+        }
+        m_program.SetBoolInput(i, static_cast<CBoolValue *>(prop)->GetBool());
+        break;
+      }
+      case CExpressionProgram::REGISTER_INT: {
+        if (type != VALUE_INT_TYPE) {
+          m_programState = PROGRAM_NONE;
+          return false;
+        }
+        m_program.SetIntInput(i, static_cast<CIntValue *>(prop)->GetInt());
+        break;
+      }
+      case CExpressionProgram::REGISTER_FLOAT: {
+        if (type != VALUE_FLOAT_TYPE) {
+          m_programState = PROGRAM_NONE;
+          return false;
+        }
+        m_program.SetFloatInput(i, static_cast<CFloatValue *>(prop)->GetFloat());
+        break;
+      }
+    }
+  }
 
+  return true;
+}
+
+bool SCA_ExpressionController::CalculateExpression()
+{
   bool expressionresult = false;
   if (!m_exprCache) {
     CParser parser;
@@ -100,6 +198,34 @@ void SCA_ExpressionController::Trigger(SCA_LogicManager *logicmgr)
     }
   }
 
+  return expressionresult;
+}
+
+void SCA_ExpressionController::Trigger(SCA_LogicManager *logicmgr)
+{
+  /* An unsupported program can become valid when an identifier becomes a linked sensor or
+   * a property of a supported type. */
+  if (m_programState == PROGRAM_NONE || m_boundSensors != m_linkedsensors ||
+      (m_programState == PROGRAM_UNSUPPORTED &&
+       m_boundPropertyTypes != GetParent()->GetPropertyTypesRevision())) {
+    CompileProgram();
+  }
+
+  bool expressionresult = false;
+  if (m_programState == PROGRAM_VALID && LoadInputs()) {
+    double result;
+    const char *error;
+    if (m_program.Execute(result, error)) {
+      expressionresult = !MT_fuzzyZero((float)result);
+    }
+    else {
+      CM_LogicBrickError(this, "[" << error << "]");
+    }
+  }
+  else {
+    expressionresult = CalculateExpression();
+  }
+
   for (std::vector<SCA_IActuator *>::const_iterator i = m_linkedactuators.begin();
        !(i == m_linkedactuators.end());
        i++) {
@@ -35,6 +35,7 @@
 #ifndef __SCA_EXPRESSIONCONTROLLER_H__
 #define __SCA_EXPRESSIONCONTROLLER_H__
 
+#include "EXP_ExpressionProgram.h"
 #include "SCA_IController.h"
 
 class CExpression;
@@ -44,6 +45,31 @@ class SCA_ExpressionController : public SCA_IController {
   std::string m_exprText;
   CExpression *m_exprCache;
 
+  enum ProgramState { PROGRAM_NONE = 0, PROGRAM_VALID, PROGRAM_UNSUPPORTED };
+
+  /// Source of a program input, a linked sensor or else a property slot of the parent.
+  struct InputBinding {
+    SCA_ISensor *m_sensor;
+    int m_propslot;
+  };
+
+  /// The expression compiled once, used instead of m_exprCache when valid.
+  CExpressionProgram m_program;
+  ProgramState m_programState;
+  /// Binding of each program input.
+  std::vector<InputBinding> m_bindings;
+  /// The linked sensors at the time of the binding, to detect link changes.
+  std::vector<SCA_ISensor *> m_boundSensors;
+  /// The parent property types revision at the time of the binding.
+  unsigned int m_boundPropertyTypes;
+
+  /// Compile the expression into m_program and bind its inputs.
+  void CompileProgram();
+  /// Copy the sensor states and properties into the program inputs.
+  bool LoadInputs();
+  /// Calculate the expression with m_exprCache, slow path used when the program is invalid.
+  bool CalculateExpression();
+
  public:
   SCA_ExpressionController(SCA_IObject *gameobj, const std::string &exprtext);
 
@@ -59,6 +59,33 @@ void SCA_ILogicBrick::SetUeberExecutePriority(int execute_Priority)
   m_Execute_Ueber_Priority = execute_Priority;
 }
 
+CValue *SCA_ILogicBrick::FindParentProperty(const std::string &name, int &slot)
+{
+  CValue *prop = m_gameobj->GetPropertyFromSlot(slot);
+  if (prop) {
+    return prop;
+  }
+
+  slot = m_gameobj->GetPropertySlot(name);
+  if (slot != -1) {
+    return m_gameobj->GetPropertyFromSlot(slot);
+  }
+
+  // Sub properties, see CValue::FindIdentifier.
+  prop = m_gameobj;
+  size_t start = 0;
+  size_t pos;
+  while ((pos = name.find('.', start)) != std::string::npos) {
+    prop = prop->GetProperty(name.substr(start, pos - start));
+    if (!prop) {
+      return nullptr;
+    }
+    start = pos + 1;
+  }
+
+  return (start > 0) ? prop->GetProperty(name.substr(start)) : nullptr;
+}
+
 void SCA_ILogicBrick::ReParent(SCA_IObject *parent)
 {
   m_gameobj = parent;
@@ -74,6 +101,15 @@ std::string SCA_ILogicBrick::GetName()
   return m_name;
 }
 
+const char *SCA_ILogicBrick::GetProfileName()
+{
+#ifdef WITH_PYTHON
+  return GetType()->tp_name;
+#else
+  return "SCA_ILogicBrick";
+#endif
+}
+
 void SCA_ILogicBrick::SetName(const std::string &name)
 {
   m_name = name;
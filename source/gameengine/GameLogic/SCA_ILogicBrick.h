@@ -64,6 +64,12 @@ class SCA_ILogicBrick : public CValue, public SG_QList {
     return m_gameobj;
   }
 
+  /** Return the property of the parent named <name> without adding a reference.
+   * \param slot The cached slot of the property in the parent, resolved if the property
+   * isn't found at this slot. Names of sub properties (e.g "prop.sub") are never cached.
+   */
+  CValue *FindParentProperty(const std::string &name, int &slot);
+
   virtual void ReParent(SCA_IObject *parent);
   virtual void Relink(std::map<SCA_IObject *, SCA_IObject *> &obj_map);
   virtual void Delete()
@@ -74,6 +80,9 @@ class SCA_ILogicBrick : public CValue, public SG_QList {
   virtual std::string GetName();
   virtual void SetName(const std::string &name);
 
+  /// Return the name of the brick type used by the profiler zones.
+  const char *GetProfileName();
+
   bool IsActive()
   {
     return m_bActive;
@@ -38,7 +38,8 @@
 MT_Vector3 SCA_IObject::m_sDummy = MT_Vector3(0, 0, 0);
 SG_QList SCA_IObject::m_activeBookmarkedControllers;
 
-SCA_IObject::SCA_IObject() : CValue(), m_initState(0), m_state(0), m_firstState(nullptr)
+SCA_IObject::SCA_IObject()
+    : CValue(), m_initState(0), m_state(0), m_firstState(nullptr), m_propertyTypesRevision(0)
 {
   m_suspended = false;
 }
@@ -202,6 +203,33 @@ SCA_IActuator *SCA_IObject::FindActuator(const std::string &actuatorname)
   return nullptr;
 }
 
+void SCA_IObject::SetProperty(const std::string &name, CValue *ioProperty)
+{
+  CValue *oldProperty = GetProperty(name);
+  if (!oldProperty || oldProperty->GetValueType() != ioProperty->GetValueType()) {
+    ++m_propertyTypesRevision;
+  }
+  CValue::SetProperty(name, ioProperty);
+  NotifyPropertyChange(name);
+}
+
+bool SCA_IObject::RemoveProperty(const std::string &inName)
+{
+  if (CValue::RemoveProperty(inName)) {
+    ++m_propertyTypesRevision;
+    NotifyPropertyChange(inName);
+    return true;
+  }
+  return false;
+}
+
+void SCA_IObject::NotifyPropertyChange(const std::string &name)
+{
+  for (SCA_ISensor *sensor : m_sensors) {
+    sensor->NotifyPropertyChange(name);
+  }
+}
+
 void SCA_IObject::SuspendSensors()
 {
   if ((!m_ignore_activity_culling) && (!m_suspended)) {
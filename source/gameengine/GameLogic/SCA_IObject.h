@@ -109,6 +109,9 @@ class SCA_IObject : public CValue {
    */
   SG_QList *m_firstState;
 
+  /// Incremented when a property is added, removed or replaced by a value of an other type.
+  unsigned int m_propertyTypesRevision;
+
  public:
   SCA_IObject();
   virtual ~SCA_IObject();
@@ -158,6 +161,19 @@ class SCA_IObject : public CValue {
 
   virtual void ReParentLogic();
 
+  virtual void SetProperty(const std::string &name, CValue *ioProperty);
+  virtual bool RemoveProperty(const std::string &inName);
+  /** Inform the sensors that the property named <name> was changed in place, the property
+   * changes done with SetProperty and RemoveProperty are notified automatically.
+   * The sensors watching a sub property of <name> are informed too.
+   */
+  void NotifyPropertyChange(const std::string &name);
+  /// Return a counter changing when the names or the types of the properties change.
+  unsigned int GetPropertyTypesRevision() const
+  {
+    return m_propertyTypesRevision;
+  }
+
   /**
    * Set whether or not to ignore activity culling requests
    */
@@ -34,6 +34,8 @@
 
 #include "SCA_ISensor.h"
 
+#include <algorithm>
+
 #include "CM_Message.h"
 #include "SCA_PythonController.h"
 
@@ -57,7 +59,9 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
       m_suspended(false),
       m_links(0),
       m_state(false),
-      m_prev_state(false)
+      m_prev_state(false),
+      m_activationFrame(0),
+      m_nextActivationFrame(0)
 {
 }
 
@@ -69,6 +73,8 @@ void SCA_ISensor::ProcessReplica()
 {
   SCA_ILogicBrick::ProcessReplica();
   m_linkedcontrollers.clear();
+  // The replica is not planned for activation until registered.
+  m_nextActivationFrame = 0;
 }
 
 bool SCA_ISensor::IsPositiveTrigger()
@@ -130,6 +136,7 @@ bool SCA_ISensor::IsSuspended()
 void SCA_ISensor::Resume()
 {
   m_suspended = false;
+  WakeUp();
 }
 
 bool SCA_ISensor::GetState()
@@ -152,6 +159,57 @@ int SCA_ISensor::GetNegTicks()
   return m_neg_ticks;
 }
 
+bool SCA_ISensor::IsEventDriven()
+{
+  return false;
+}
+
+int SCA_ISensor::GetActivationDelay()
+{
+  // A suspended sensor is woken up when resumed.
+  if (m_suspended) {
+    return 0;
+  }
+
+  /* The level mode triggers the controllers just activated and the previous state must be
+   * updated the frame after a change of state, both don't depend on the inputs. */
+  if (m_level || m_state != m_prev_state) {
+    return 1;
+  }
+
+  // Frames until the next pulse.
+  if (m_pos_pulsemode && m_state) {
+    return std::max(m_skipped_ticks + 1 - m_pos_ticks, 1);
+  }
+  if (m_neg_pulsemode && !m_tap && !m_state) {
+    return std::max(m_skipped_ticks + 1 - m_neg_ticks, 1);
+  }
+
+  return 0;
+}
+
+void SCA_ISensor::SkipFrames(int frames)
+{
+  // Without input change the counters only loop, see Activate.
+  if (m_pos_pulsemode) {
+    m_pos_ticks = (m_pos_ticks + frames) % (m_skipped_ticks + 1);
+  }
+  if (m_neg_pulsemode && !m_tap) {
+    m_neg_ticks = (m_neg_ticks + frames) % (m_skipped_ticks + 1);
+  }
+}
+
+void SCA_ISensor::WakeUp()
+{
+  if (m_links) {
+    m_eventmgr->WakeSensor(this);
+  }
+}
+
+void SCA_ISensor::NotifyPropertyChange(const std::string &name)
+{
+}
+
 void SCA_ISensor::ClrLink()
 {
   m_links = 0;
@@ -341,6 +399,7 @@ KX_PYMETHODDEF_DOC_NOARGS(
 {
   Init();
   m_prev_state = false;
+  WakeUp();
   Py_RETURN_NONE;
 }
 
@@ -391,10 +450,13 @@ PyMethodDef SCA_ISensor::Methods[] = {
 };
 
 PyAttributeDef SCA_ISensor::Attributes[] = {
-    KX_PYATTRIBUTE_BOOL_RW("usePosPulseMode", SCA_ISensor, m_pos_pulsemode),
-    KX_PYATTRIBUTE_BOOL_RW("useNegPulseMode", SCA_ISensor, m_neg_pulsemode),
-    KX_PYATTRIBUTE_INT_RW("skippedTicks", 0, 100000, true, SCA_ISensor, m_skipped_ticks),
-    KX_PYATTRIBUTE_BOOL_RW("invert", SCA_ISensor, m_invert),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK(
+        "usePosPulseMode", SCA_ISensor, m_pos_pulsemode, pyattr_check_pulse),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK(
+        "useNegPulseMode", SCA_ISensor, m_neg_pulsemode, pyattr_check_pulse),
+    KX_PYATTRIBUTE_INT_RW_CHECK(
+        "skippedTicks", 0, 100000, true, SCA_ISensor, m_skipped_ticks, pyattr_check_pulse),
+    KX_PYATTRIBUTE_BOOL_RW_CHECK("invert", SCA_ISensor, m_invert, pyattr_check_pulse),
     KX_PYATTRIBUTE_BOOL_RW_CHECK("level", SCA_ISensor, m_level, pyattr_check_level),
     KX_PYATTRIBUTE_BOOL_RW_CHECK("tap", SCA_ISensor, m_tap, pyattr_check_tap),
     KX_PYATTRIBUTE_RO_FUNCTION("triggered", SCA_ISensor, pyattr_get_triggered),
@@ -460,6 +522,7 @@ int SCA_ISensor::pyattr_check_level(PyObjectPlus *self_v, const KX_PYATTRIBUTE_D
   if (self->m_level) {
     self->m_tap = false;
   }
+  self->WakeUp();
   return 0;
 }
 
@@ -469,6 +532,15 @@ int SCA_ISensor::pyattr_check_tap(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF
   if (self->m_tap) {
     self->m_level = false;
   }
+  self->WakeUp();
+  return 0;
+}
+
+int SCA_ISensor::pyattr_check_pulse(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  SCA_ISensor *self = static_cast<SCA_ISensor *>(self_v);
+  // The next pulse or the output of the sensor changed.
+  self->WakeUp();
   return 0;
 }
 
@@ -488,6 +560,7 @@ int SCA_ISensor::pyattr_set_frequency(PyObjectPlus *self_v,
   ShowDeprecationWarning("SCA_ISensor.frequency", "SCA_ISensor.skippedTicks");
   if (PyLong_Check(value)) {
     self->m_skipped_ticks = PyLong_AsLong(value);
+    self->WakeUp();
     return PY_SET_ATTR_SUCCESS;
   }
   else {
@@ -47,7 +47,10 @@ class SCA_EventManager;
 class SCA_ISensor : public SCA_ILogicBrick {
   Py_Header
 
-      protected : SCA_EventManager *m_eventmgr;
+      friend class SCA_BasicEventManager;
+
+ protected:
+  SCA_EventManager *m_eventmgr;
 
   /// Pulse positive  pulses?
   bool m_pos_pulsemode;
@@ -88,6 +91,11 @@ class SCA_ISensor : public SCA_ILogicBrick {
   /// Previous state (for tap option).
   bool m_prev_state;
 
+  /// Frame of the last activation of an event driven sensor, see SCA_BasicEventManager.
+  unsigned int m_activationFrame;
+  /// Frame of the next planned activation of an event driven sensor, 0 if none.
+  unsigned int m_nextActivationFrame;
+
   std::vector<SCA_IController *> m_linkedcontrollers;
 
  public:
@@ -113,6 +121,21 @@ class SCA_ISensor : public SCA_ILogicBrick {
   virtual bool IsPositiveTrigger();
   virtual void Init();
 
+  /** Return true if the sensor is activated only after a change of its inputs and for its
+   * pulses instead of every frame, see SCA_BasicEventManager.
+   */
+  virtual bool IsEventDriven();
+  /** Return the number of frames until the output of an event driven sensor can change
+   * without a change of its inputs, 0 if it can wait for an input change.
+   */
+  virtual int GetActivationDelay();
+  /// Update the pulse counters of an event driven sensor skipped during some frames.
+  void SkipFrames(int frames);
+  /// Request the activation of an event driven sensor after a change of its inputs.
+  void WakeUp();
+  /// Called when the property named <name> of the parent object changed.
+  virtual void NotifyPropertyChange(const std::string &name);
+
   virtual CValue *GetReplica() = 0;
 
   /** Set parameters for the pulsing behavior.
@@ -183,6 +206,7 @@ class SCA_ISensor : public SCA_ILogicBrick {
 
   static int pyattr_check_level(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_check_tap(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_check_pulse(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 
   enum SensorStatus {
     KX_SENSOR_INACTIVE = 0,
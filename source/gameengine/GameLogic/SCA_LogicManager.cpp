@@ -32,10 +32,26 @@
 
 #include "SCA_LogicManager.h"
 
-
+#include "CM_Profiler.h"
 #include "SCA_ISensor.h"
 #include "SCA_PythonController.h"
 
+/// Profiler zone names of the event managers indexed by their type.
+static const char *eventManagerZoneNames[] = {
+    "Keyboard Sensors",  // KEYBOARD_EVENTMGR
+    "Mouse Sensors",     // MOUSE_EVENTMGR
+    "Always Sensors",    // ALWAYS_EVENTMGR
+    "Touch Sensors",     // TOUCH_EVENTMGR
+    "Property Sensors",  // PROPERTY_EVENTMGR
+    "Time Sensors",      // TIME_EVENTMGR
+    "Random Sensors",    // RANDOM_EVENTMGR
+    "Ray Sensors",       // RAY_EVENTMGR
+    "Network Sensors",   // NETWORK_EVENTMGR
+    "Joystick Sensors",  // JOY_EVENTMGR
+    "Actuator Sensors",  // ACTUATOR_EVENTMGR
+    "Basic Sensors"      // BASIC_EVENTMGR
+};
+
 SCA_LogicManager::SCA_LogicManager()
 {
 }
@@ -113,6 +129,7 @@ void SCA_LogicManager::RemoveController(SCA_IController *controller)
   controller->UnlinkAllSensors();
   controller->UnlinkAllActuators();
   controller->Deactivate();
+  m_pythonControllers.erase(controller);
 }
 
 void SCA_LogicManager::RemoveActuator(SCA_IActuator *actuator)
@@ -126,6 +143,10 @@ void SCA_LogicManager::RegisterToSensor(SCA_IController *controller, SCA_ISensor
 {
   sensor->LinkToController(controller);
   controller->LinkToSensor(sensor);
+
+  if (dynamic_cast<SCA_PythonController *>(controller)) {
+    m_pythonControllers.insert(controller);
+  }
 }
 
 void SCA_LogicManager::RegisterToActuator(SCA_IController *controller, SCA_IActuator *actua)
@@ -134,17 +155,25 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController *controller, SCA_IActu
   controller->LinkToActuator(actua);
 }
 
+bool SCA_LogicManager::HasPythonControllers() const
+{
+  return !m_pythonControllers.empty();
+}
+
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
   for (std::vector<SCA_EventManager *>::const_iterator ie = m_eventmanagers.begin();
        !(ie == m_eventmanagers.end());
-       ie++)
+       ie++) {
+    CM_ProfileZone zone(eventManagerZoneNames[(*ie)->GetType()]);
     (*ie)->NextFrame(curtime, fixedtime);
+  }
 
   for (SG_QList *obj = (SG_QList *)m_triggeredControllerSet.Remove(); obj != nullptr;
        obj = (SG_QList *)m_triggeredControllerSet.Remove()) {
     for (SCA_IController *contr = (SCA_IController *)obj->QRemove(); contr != nullptr;
          contr = (SCA_IController *)obj->QRemove()) {
+      CM_ProfileZone zone(contr->GetProfileName());
       contr->Trigger(this);
       contr->ClrJustActivated();
     }
@@ -168,7 +197,12 @@ void SCA_LogicManager::UpdateFrame(double curtime)
       SCA_IActuator *actua = *ia;
       // increment first to allow removal of inactive actuators.
       ++ia;
-      if (!actua->Update(curtime)) {
+      bool active;
+      {
+        CM_ProfileZone zone(actua->GetProfileName());
+        active = actua->Update(curtime);
+      }
+      if (!active) {
         // this actuator is not active anymore, remove
         actua->QDelink();
         actua->SetActive(false);
@@ -37,6 +37,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,9 @@ class SCA_LogicManager {
   std::map<std::string, void *> m_map_gamemeshname_to_blendobj;
   std::map<void *, CValue *> m_map_blendobj_to_gameobj;
 
+  /// Python controllers linked to a sensor, they need the GIL when triggered.
+  std::set<SCA_IController *> m_pythonControllers;
+
  public:
   SCA_LogicManager();
   virtual ~SCA_LogicManager();
@@ -90,6 +94,8 @@ class SCA_LogicManager {
   void RegisterEventManager(SCA_EventManager *eventmgr);
   void RegisterToSensor(SCA_IController *controller, class SCA_ISensor *sensor);
   void RegisterToActuator(SCA_IController *controller, class SCA_IActuator *actuator);
+  /// Return true if a python controller can be triggered.
+  bool HasPythonControllers() const;
 
   void BeginFrame(double curtime, double fixedtime);
   void UpdateFrame(double curtime);
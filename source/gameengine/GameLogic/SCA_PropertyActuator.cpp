@@ -34,8 +34,11 @@
 
 #include "SCA_PropertyActuator.h"
 
+#include <sstream>
+
 
 #include "EXP_ConstExpr.h"
+#include "EXP_FloatValue.h"
 #include "EXP_InputParser.h"
 #include "EXP_Operator2Expr.h"
 
@@ -52,8 +55,11 @@ SCA_PropertyActuator::SCA_PropertyActuator(SCA_IObject *gameobj,
       m_type(acttype),
       m_propname(propname),
       m_exprtxt(expr),
-      m_sourceObj(sourceObj)
+      m_sourceObj(sourceObj),
+      m_propslot(gameobj->GetPropertySlot(propname))
 {
+  ParseConstant();
+
   // protect ourselves against someone else deleting the source object
   // don't protect against ourselves: it would create a dead lock
   if (m_sourceObj)
@@ -77,15 +83,22 @@ bool SCA_PropertyActuator::Update()
   if (bNegativeEvent) {
     if (m_type == KX_ACT_PROP_LEVEL) {
       CValue *newval = new CBoolValue(false);
-      CValue *oldprop = propowner->GetProperty(m_propname);
+      CValue *oldprop = FindParentProperty(m_propname, m_propslot);
       if (oldprop) {
         oldprop->SetValue(newval);
+        GetParent()->NotifyPropertyChange(m_propname);
       }
       newval->Release();
     }
     return false;
   }
 
+  if (ELEM(m_type, KX_ACT_PROP_ASSIGN, KX_ACT_PROP_ADD) &&
+      ApplyConstant(FindParentProperty(m_propname, m_propslot))) {
+    GetParent()->NotifyPropertyChange(m_propname);
+    return false;
+  }
+
   CParser parser;
   parser.SetContext(propowner->AddRef());
 
@@ -94,7 +107,7 @@ bool SCA_PropertyActuator::Update()
   if (m_type == KX_ACT_PROP_TOGGLE) {
     /* don't use */
     CValue *newval;
-    CValue *oldprop = propowner->GetProperty(m_propname);
+    CValue *oldprop = FindParentProperty(m_propname, m_propslot);
     if (oldprop) {
       newval = new CBoolValue((oldprop->GetNumber() == 0.0) ? true : false);
       oldprop->SetValue(newval);
@@ -107,7 +120,7 @@ bool SCA_PropertyActuator::Update()
   }
   else if (m_type == KX_ACT_PROP_LEVEL) {
     CValue *newval = new CBoolValue(true);
-    CValue *oldprop = propowner->GetProperty(m_propname);
+    CValue *oldprop = FindParentProperty(m_propname, m_propslot);
     if (oldprop) {
       oldprop->SetValue(newval);
     }
@@ -122,7 +135,7 @@ bool SCA_PropertyActuator::Update()
       case KX_ACT_PROP_ASSIGN: {
 
         CValue *newval = userexpr->Calculate();
-        CValue *oldprop = propowner->GetProperty(m_propname);
+        CValue *oldprop = FindParentProperty(m_propname, m_propslot);
         if (oldprop) {
           oldprop->SetValue(newval);
         }
@@ -133,7 +146,7 @@ bool SCA_PropertyActuator::Update()
         break;
       }
       case KX_ACT_PROP_ADD: {
-        CValue *oldprop = propowner->GetProperty(m_propname);
+        CValue *oldprop = FindParentProperty(m_propname, m_propslot);
         if (oldprop) {
           // int waarde = (int)oldprop->GetNumber();  /*unused*/
           CExpression *expr = new COperator2Expr(
@@ -166,6 +179,9 @@ bool SCA_PropertyActuator::Update()
     userexpr->Release();
   }
 
+  // Most of the changes above are done in place, inform the property sensors.
+  GetParent()->NotifyPropertyChange(m_propname);
+
   return result;
 }
 
@@ -182,6 +198,64 @@ SCA_PropertyActuator::
   return replica;
 };
 
+void SCA_PropertyActuator::ParseConstant()
+{
+  m_constType = CONSTANT_NONE;
+
+  // Only digits, the parser could read anything else differently.
+  if (m_exprtxt.empty() || m_exprtxt.find_first_not_of("0123456789+-. ") != std::string::npos) {
+    return;
+  }
+
+  std::stringstream intstream(m_exprtxt);
+  if ((intstream >> m_constInt) && (intstream >> std::ws).eof()) {
+    m_constType = CONSTANT_INT;
+    return;
+  }
+
+  std::stringstream floatstream(m_exprtxt);
+  if ((floatstream >> m_constFloat) && (floatstream >> std::ws).eof()) {
+    m_constType = CONSTANT_FLOAT;
+  }
+}
+
+bool SCA_PropertyActuator::ApplyConstant(CValue *prop)
+{
+  if (!prop || m_constType == CONSTANT_NONE) {
+    return false;
+  }
+
+  switch (prop->GetValueType()) {
+    case VALUE_INT_TYPE: {
+      CIntValue *intprop = static_cast<CIntValue *>(prop);
+      if (m_type == KX_ACT_PROP_ASSIGN) {
+        intprop->SetInt((m_constType == CONSTANT_INT) ? m_constInt : (cInt)m_constFloat);
+        return true;
+      }
+      // The sum of an integer and a float is a float truncated later, let the expression do it.
+      else if (m_constType == CONSTANT_INT) {
+        intprop->SetInt(intprop->GetInt() + m_constInt);
+        return true;
+      }
+      break;
+    }
+    case VALUE_FLOAT_TYPE: {
+      CFloatValue *floatprop = static_cast<CFloatValue *>(prop);
+      const float value = (m_constType == CONSTANT_INT) ? (float)m_constInt : m_constFloat;
+      floatprop->SetFloat((m_type == KX_ACT_PROP_ASSIGN) ? value : floatprop->GetFloat() + value);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void SCA_PropertyActuator::ReParent(SCA_IObject *parent)
+{
+  SCA_IActuator::ReParent(parent);
+  m_propslot = parent->GetPropertySlot(m_propname);
+}
+
 void SCA_PropertyActuator::ProcessReplica()
 {
   // no need to check for self reference like in the constructor:
@@ -258,14 +332,32 @@ PyTypeObject SCA_PropertyActuator::Type = {
     0,
     py_base_new};
 
+int SCA_PropertyActuator::CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  if (CheckProperty(self, attrdef) != 0) {
+    return 1;
+  }
+
+  SCA_PropertyActuator *actuator = static_cast<SCA_PropertyActuator *>(self);
+  actuator->m_propslot = actuator->GetParent()->GetPropertySlot(actuator->m_propname);
+  return 0;
+}
+
+int SCA_PropertyActuator::CheckValue(PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  static_cast<SCA_PropertyActuator *>(self)->ParseConstant();
+  return 0;
+}
+
 PyMethodDef SCA_PropertyActuator::Methods[] = {
     {nullptr, nullptr}  // Sentinel
 };
 
 PyAttributeDef SCA_PropertyActuator::Attributes[] = {
     KX_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertyActuator, m_propname, CheckProperty),
-    KX_PYATTRIBUTE_STRING_RW("value", 0, 100, false, SCA_PropertyActuator, m_exprtxt),
+        "propName", 0, MAX_PROP_NAME, false, SCA_PropertyActuator, m_propname, CheckPropertyName),
+    KX_PYATTRIBUTE_STRING_RW_CHECK(
+        "value", 0, 100, false, SCA_PropertyActuator, m_exprtxt, CheckValue),
     KX_PYATTRIBUTE_INT_RW("mode",
                           KX_ACT_PROP_NODEF + 1,
                           KX_ACT_PROP_MAX - 1,
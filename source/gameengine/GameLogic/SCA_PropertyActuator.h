@@ -32,6 +32,7 @@
 #ifndef __SCA_PROPERTYACTUATOR_H__
 #define __SCA_PROPERTYACTUATOR_H__
 
+#include "EXP_IntValue.h"
 #include "SCA_IActuator.h"
 
 class SCA_PropertyActuator : public SCA_IActuator {
@@ -51,6 +52,18 @@ class SCA_PropertyActuator : public SCA_IActuator {
   std::string m_propname;
   std::string m_exprtxt;
   SCA_IObject *m_sourceObj;  // for copy property actuator
+  /// Cached slot of the property in the parent.
+  int m_propslot;
+
+  /// The expression parsed once when it is a numerical constant.
+  enum ConstantType { CONSTANT_NONE = 0, CONSTANT_INT, CONSTANT_FLOAT } m_constType;
+  cInt m_constInt;
+  float m_constFloat;
+
+  /** Assign or add the constant expression to a numerical property without
+   * evaluating the expression, return false if it's not possible.
+   */
+  bool ApplyConstant(CValue *prop);
 
  public:
   SCA_PropertyActuator(SCA_IObject *gameobj,
@@ -64,11 +77,20 @@ class SCA_PropertyActuator : public SCA_IActuator {
   CValue *GetReplica();
 
   virtual void ProcessReplica();
+  virtual void ReParent(SCA_IObject *parent);
   virtual bool UnlinkObject(SCA_IObject *clientobj);
   virtual void Relink(std::map<SCA_IObject *, SCA_IObject *> &obj_map);
 
   virtual bool Update();
 
+  /// Parse the expression to detect numerical constants.
+  void ParseConstant();
+
+#ifdef WITH_PYTHON
+  static int CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef);
+  static int CheckValue(PyObjectPlus *self, const PyAttributeDef *attrdef);
+#endif
+
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
   /* --------------------------------------------------------------------- */
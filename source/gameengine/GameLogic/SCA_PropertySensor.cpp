@@ -35,10 +35,12 @@
 #include "SCA_PropertySensor.h"
 
 #include <boost/algorithm/string.hpp>
+#include <sstream>
 
 
 #include "CM_Format.h"
 #include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
 
 SCA_PropertySensor::SCA_PropertySensor(SCA_EventManager *eventmgr,
                                        SCA_IObject *gameobj,
@@ -50,21 +52,54 @@ SCA_PropertySensor::SCA_PropertySensor(SCA_EventManager *eventmgr,
       m_checktype(checktype),
       m_checkpropval(propval),
       m_checkpropmaxval(propmaxval),
-      m_checkpropname(propname)
+      m_checkpropname(propname),
+      m_checkpropslot(-1),
+      m_previousnumber(0.0),
+      m_checkproptimer(false)
 {
   // CParser pars;
   // pars.SetContext(this->AddRef());
   // CValue* resultval = m_rightexpr->Calculate();
 
-  CValue *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-  if (!orgprop->IsError()) {
+  CValue *orgprop = FindParentProperty(m_checkpropname, m_checkpropslot);
+  if (orgprop) {
     m_previoustext = orgprop->GetText();
+    m_previousnumber = orgprop->GetNumber();
   }
-  orgprop->Release();
 
+  ParseCheckValues();
   Init();
 }
 
+void SCA_PropertySensor::ParseCheckValues()
+{
+  m_checkvalue = 0.0f;
+  m_checkmaxvalue = 0.0f;
+  m_checkvalueValid = CM_StringTo(m_checkpropval, m_checkvalue);
+  CM_StringTo(m_checkpropmaxval, m_checkmaxvalue);
+
+  // Integer properties were compared as text, the value must be an integer only.
+  std::stringstream stream(m_checkpropval);
+  m_checkintValid = (stream >> m_checkint) && stream.eof();
+
+  const std::string upperval = boost::to_upper_copy(m_checkpropval);
+  if (upperval == CBoolValue::sTrueString) {
+    m_checkbool = 1;
+  }
+  else if (upperval == CBoolValue::sFalseString) {
+    m_checkbool = 0;
+  }
+  else {
+    m_checkbool = -1;
+  }
+}
+
+void SCA_PropertySensor::ReParent(SCA_IObject *parent)
+{
+  SCA_ISensor::ReParent(parent);
+  m_checkpropslot = parent->GetPropertySlot(m_checkpropname);
+}
+
 void SCA_PropertySensor::Init()
 {
   m_recentresult = false;
@@ -91,6 +126,27 @@ bool SCA_PropertySensor::IsPositiveTrigger()
   return result;
 }
 
+bool SCA_PropertySensor::IsEventDriven()
+{
+  return true;
+}
+
+int SCA_PropertySensor::GetActivationDelay()
+{
+  if (m_checkproptimer && !m_suspended) {
+    return 1;
+  }
+  return SCA_ISensor::GetActivationDelay();
+}
+
+void SCA_PropertySensor::NotifyPropertyChange(const std::string &name)
+{
+  // A sub property ("a.b") changes with its root property ("a"), compare only the root names.
+  if (m_checkpropname.compare(0, m_checkpropname.find('.'), name, 0, name.find('.')) == 0) {
+    WakeUp();
+  }
+}
+
 SCA_PropertySensor::~SCA_PropertySensor()
 {
 }
@@ -113,35 +169,43 @@ bool SCA_PropertySensor::CheckPropertyCondition()
   m_recentresult = false;
   bool result = false;
   bool reverse = false;
+
+  CValue *orgprop = FindParentProperty(m_checkpropname, m_checkpropslot);
+  m_checkproptimer = (orgprop && orgprop->GetProperty("timer"));
+  if (!orgprop) {
+    // A missing property is never equal.
+    m_recentresult = (m_checktype == KX_PROPSENSOR_NOTEQUAL);
+    return m_recentresult;
+  }
+
+  const int valuetype = orgprop->GetValueType();
   switch (m_checktype) {
     case KX_PROPSENSOR_NOTEQUAL:
       reverse = true;
       ATTR_FALLTHROUGH;
     case KX_PROPSENSOR_EQUAL: {
-      CValue *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
-        const std::string &testprop = orgprop->GetText();
-        // Force strings to upper case, to avoid confusion in
-        // bool tests. It's stupid the prop's identity is lost
-        // on the way here...
-        if ((testprop == CBoolValue::sTrueString) || (testprop == CBoolValue::sFalseString)) {
-          boost::to_upper(m_checkpropval);
+      switch (valuetype) {
+        case VALUE_BOOL_TYPE: {
+          result = (m_checkbool != -1) && ((orgprop->GetNumber() != 0.0) == (m_checkbool == 1));
+          break;
         }
-        result = (testprop == m_checkpropval);
-
-        /* Patch: floating point values cant use strings usefully since you can have "0.0" ==
-         * "0.0000" this could be made into a generic Value class function for comparing values
-         * with a string.
-         */
-        if (result == false && (orgprop->GetValueType() == VALUE_FLOAT_TYPE)) {
-          float f;
-          if (CM_StringTo(m_checkpropval, f)) {
-            result = (f == ((CFloatValue *)orgprop)->GetFloat());
-          }
+        case VALUE_INT_TYPE: {
+          const cInt val = static_cast<CIntValue *>(orgprop)->GetInt();
+          result = m_checkintValid && (val == m_checkint);
+          break;
+        }
+        case VALUE_FLOAT_TYPE: {
+          /* Floating point values cant use strings usefully since you can have "0.0" ==
+           * "0.0000", compare the numbers. */
+          result = m_checkvalueValid &&
+                   (static_cast<CFloatValue *>(orgprop)->GetFloat() == m_checkvalue);
+          break;
+        }
+        default: {
+          result = (orgprop->GetText() == m_checkpropval);
+          break;
         }
-        /* end patch */
       }
-      orgprop->Release();
 
       if (reverse)
         result = !result;
@@ -152,37 +216,33 @@ bool SCA_PropertySensor::CheckPropertyCondition()
       break;
     }
     case KX_PROPSENSOR_INTERVAL: {
-      CValue *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
-        float min;
-        float max;
-        float val;
-        CM_StringTo(m_checkpropval, min);
-        CM_StringTo(m_checkpropmaxval, max);
-
-        if (orgprop->GetValueType() == VALUE_STRING_TYPE) {
-          CM_StringTo(orgprop->GetText(), val);
-        }
-        else {
-          val = orgprop->GetNumber();
-        }
-
-        result = (min <= val) && (val <= max);
+      float val;
+      if (valuetype == VALUE_STRING_TYPE) {
+        CM_StringTo(orgprop->GetText(), val);
       }
-      orgprop->Release();
+      else {
+        val = orgprop->GetNumber();
+      }
+
+      result = (m_checkvalue <= val) && (val <= m_checkmaxvalue);
 
       break;
     }
     case KX_PROPSENSOR_CHANGED: {
-      CValue *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-
-      if (!orgprop->IsError()) {
-        if (m_previoustext != orgprop->GetText()) {
-          m_previoustext = orgprop->GetText();
+      if (ELEM(valuetype, VALUE_BOOL_TYPE, VALUE_INT_TYPE, VALUE_FLOAT_TYPE)) {
+        const double number = orgprop->GetNumber();
+        if (m_previousnumber != number) {
+          m_previousnumber = number;
+          result = true;
+        }
+      }
+      else {
+        const std::string text = orgprop->GetText();
+        if (m_previoustext != text) {
+          m_previoustext = text;
           result = true;
         }
       }
-      orgprop->Release();
 
       break;
     }
@@ -190,27 +250,20 @@ bool SCA_PropertySensor::CheckPropertyCondition()
       reverse = true;
       ATTR_FALLTHROUGH;
     case KX_PROPSENSOR_GREATERTHAN: {
-      CValue *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
-        float ref;
-        CM_StringTo(m_checkpropval, ref);
-        float val;
-
-        if (orgprop->GetValueType() == VALUE_STRING_TYPE) {
-          CM_StringTo(orgprop->GetText(), val);
-        }
-        else {
-          val = orgprop->GetNumber();
-        }
+      float val;
+      if (valuetype == VALUE_STRING_TYPE) {
+        CM_StringTo(orgprop->GetText(), val);
+      }
+      else {
+        val = orgprop->GetNumber();
+      }
 
-        if (reverse) {
-          result = val < ref;
-        }
-        else {
-          result = val > ref;
-        }
+      if (reverse) {
+        result = val < m_checkvalue;
+      }
+      else {
+        result = val > m_checkvalue;
       }
-      orgprop->Release();
 
       break;
     }
@@ -242,6 +295,28 @@ int SCA_PropertySensor::validValueForProperty(PyObjectPlus *self, const PyAttrib
    * function directly */
 
   /*  There is no type checking at this moment, unfortunately...           */
+  SCA_PropertySensor *sensor = static_cast<SCA_PropertySensor *>(self);
+  sensor->ParseCheckValues();
+  sensor->WakeUp();
+  return 0;
+}
+
+int SCA_PropertySensor::CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  if (CheckProperty(self, attrdef) != 0) {
+    return 1;
+  }
+
+  SCA_PropertySensor *sensor = static_cast<SCA_PropertySensor *>(self);
+  sensor->m_checkpropslot = sensor->GetParent()->GetPropertySlot(sensor->m_checkpropname);
+  sensor->WakeUp();
+  return 0;
+}
+
+int SCA_PropertySensor::CheckMode(PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  SCA_PropertySensor *sensor = static_cast<SCA_PropertySensor *>(self);
+  sensor->WakeUp();
   return 0;
 }
 
@@ -289,14 +364,20 @@ PyMethodDef SCA_PropertySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_PropertySensor::Attributes[] = {
-    KX_PYATTRIBUTE_INT_RW("mode",
-                          KX_PROPSENSOR_NODEF,
-                          KX_PROPSENSOR_MAX - 1,
-                          false,
-                          SCA_PropertySensor,
-                          m_checktype),
-    KX_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertySensor, m_checkpropname, CheckProperty),
+    KX_PYATTRIBUTE_INT_RW_CHECK("mode",
+                                KX_PROPSENSOR_NODEF,
+                                KX_PROPSENSOR_MAX - 1,
+                                false,
+                                SCA_PropertySensor,
+                                m_checktype,
+                                CheckMode),
+    KX_PYATTRIBUTE_STRING_RW_CHECK("propName",
+                                   0,
+                                   MAX_PROP_NAME,
+                                   false,
+                                   SCA_PropertySensor,
+                                   m_checkpropname,
+                                   CheckPropertyName),
     KX_PYATTRIBUTE_STRING_RW_CHECK(
         "value", 0, 100, false, SCA_PropertySensor, m_checkpropval, validValueForProperty),
     KX_PYATTRIBUTE_STRING_RW_CHECK(
@@ -33,6 +33,7 @@
 #ifndef __SCA_PROPERTYSENSOR_H__
 #define __SCA_PROPERTYSENSOR_H__
 
+#include "EXP_IntValue.h"
 #include "SCA_ISensor.h"
 
 class SCA_PropertySensor : public SCA_ISensor {
@@ -42,9 +43,22 @@ class SCA_PropertySensor : public SCA_ISensor {
   std::string m_checkpropval;
   std::string m_checkpropmaxval;
   std::string m_checkpropname;
+  /// Cached slot of the checked property in the parent.
+  int m_checkpropslot;
+  /// m_checkpropval and m_checkpropmaxval parsed once for numerical properties.
+  float m_checkvalue;
+  float m_checkmaxvalue;
+  bool m_checkvalueValid;
+  cInt m_checkint;
+  bool m_checkintValid;
+  /// 1 for true, 0 for false and -1 if m_checkpropval isn't a boolean.
+  int m_checkbool;
   std::string m_previoustext;
+  double m_previousnumber;
   bool m_lastresult;
   bool m_recentresult;
+  /// The checked property is a timer, changed every frame without notification.
+  bool m_checkproptimer;
 
  protected:
  public:
@@ -72,10 +86,16 @@ class SCA_PropertySensor : public SCA_ISensor {
   virtual ~SCA_PropertySensor();
   virtual CValue *GetReplica();
   virtual void Init();
+  virtual void ReParent(SCA_IObject *parent);
+  /// Parse the values to compare the property with.
+  void ParseCheckValues();
   bool CheckPropertyCondition();
 
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool IsEventDriven();
+  virtual int GetActivationDelay();
+  virtual void NotifyPropertyChange(const std::string &name);
   virtual CValue *FindIdentifier(const std::string &identifiername);
 
 #ifdef WITH_PYTHON
@@ -88,6 +108,8 @@ class SCA_PropertySensor : public SCA_ISensor {
    * Test whether this is a sensible value (type check)
    */
   static int validValueForProperty(PyObjectPlus *self, const PyAttributeDef *);
+  static int CheckPropertyName(PyObjectPlus *self, const PyAttributeDef *attrdef);
+  static int CheckMode(PyObjectPlus *self, const PyAttributeDef *attrdef);
 
 #endif
 };
@@ -226,6 +226,7 @@ bool SCA_RandomActuator::Update()
   CValue *prop = GetParent()->GetProperty(m_propname);
   if (prop) {
     prop->SetValue(tmpval);
+    GetParent()->NotifyPropertyChange(m_propname);
   }
   tmpval->Release();
 
@@ -35,6 +35,9 @@
 
 #include "SCA_SoundActuator.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef WITH_AUDASPACE
 typedef float sample_t;
 #  include <AUD_Device.h>
@@ -47,6 +50,8 @@ typedef float sample_t;
 
 #include "KX_Camera.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "SCA_VoiceManager.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -65,6 +70,7 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject *gameobj,
 #ifdef WITH_AUDASPACE
   m_sound = sound ? AUD_Sound_copy(sound) : nullptr;
   m_handle = nullptr;
+  m_soundInfoValid = false;
 #endif  // WITH_AUDASPACE
   m_volume = volume;
   m_pitch = pitch;
@@ -72,15 +78,22 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject *gameobj,
   m_3d = settings;
   m_type = type;
   m_isplaying = false;
+  m_voiceManager = &KX_GetActiveEngine()->GetVoiceManager();
+  m_category = 0;
+  m_virtual = false;
+  m_loop = false;
+  m_virtualPosition = 0.0f;
+  m_virtualTime = 0.0;
+  m_location = MT_Vector3(0.0f, 0.0f, 0.0f);
+  m_velocity = MT_Vector3(0.0f, 0.0f, 0.0f);
+  m_orientation = MT_Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
 SCA_SoundActuator::~SCA_SoundActuator()
 {
-#ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-  }
+  StopVoice();
 
+#ifdef WITH_AUDASPACE
   if (m_sound) {
     AUD_Sound_free(m_sound);
   }
@@ -90,34 +103,97 @@ SCA_SoundActuator::~SCA_SoundActuator()
 void SCA_SoundActuator::play()
 {
 #ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-    m_handle = nullptr;
-  }
+  StopVoice();
 
   if (!m_sound)
     return;
 
-  // this is the sound that will be played and not deleted afterwards
-  AUD_Sound *sound = m_sound;
-
-  bool loop = false;
-
   switch (m_type) {
     case KX_SOUNDACT_LOOPBIDIRECTIONAL:
     case KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP:
-      sound = AUD_Sound_pingpong(sound);
-      ATTR_FALLTHROUGH;
     case KX_SOUNDACT_LOOPEND:
     case KX_SOUNDACT_LOOPSTOP:
-      loop = true;
+      m_loop = true;
       break;
     case KX_SOUNDACT_PLAYSTOP:
     case KX_SOUNDACT_PLAYEND:
     default:
+      m_loop = false;
       break;
   }
 
+  /* Decide if the voice is real now, a burst of triggers over the limit doesn't open a device
+   * handle closed at the next voice manager update. */
+  UpdateVoiceLocation();
+  AUD_Device *device = AUD_Device_getCurrent();
+  const float gain = device ? GetVoiceGain(AUD_Device_getDistanceModel(device)) : m_volume;
+  AUD_Device_free(device);
+
+  if (m_voiceManager->AddVoice(this, gain)) {
+    PlayHandle(0.0f);
+  }
+  else {
+    m_virtual = true;
+    m_virtualPosition = 0.0f;
+    m_virtualTime = m_voiceManager->GetTime();
+  }
+
+  m_isplaying = true;
+#endif  // WITH_AUDASPACE
+}
+
+void SCA_SoundActuator::StopVoice()
+{
+#ifdef WITH_AUDASPACE
+  if (m_handle) {
+    AUD_Handle_stop(m_handle);
+    m_handle = nullptr;
+  }
+#endif  // WITH_AUDASPACE
+
+  m_virtual = false;
+  m_voiceManager->RemoveVoice(this);
+}
+
+void SCA_SoundActuator::UpdateVoiceLocation()
+{
+  if (!m_is3d) {
+    return;
+  }
+
+  KX_Camera *cam = KX_GetActiveScene()->GetActiveCamera();
+  if (!cam) {
+    return;
+  }
+
+  KX_GameObject *obj = (KX_GameObject *)this->GetParent();
+  const MT_Matrix3x3 Mo = cam->NodeGetWorldOrientation().inverse();
+  m_location = Mo * (obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition());
+  m_velocity = Mo * (obj->GetLinearVelocity() - cam->GetLinearVelocity());
+  m_orientation = (Mo * obj->NodeGetWorldOrientation()).getRotation();
+}
+
+#ifdef WITH_AUDASPACE
+void SCA_SoundActuator::ApplyVoiceLocation()
+{
+  float data[4];
+  m_location.getValue(data);
+  AUD_Handle_setLocation(m_handle, data);
+  m_velocity.getValue(data);
+  AUD_Handle_setVelocity(m_handle, data);
+  m_orientation.getValue(data);
+  AUD_Handle_setOrientation(m_handle, data);
+}
+
+void SCA_SoundActuator::PlayHandle(float position)
+{
+  // this is the sound that will be played and not deleted afterwards
+  AUD_Sound *sound = m_sound;
+
+  if (ELEM(m_type, KX_SOUNDACT_LOOPBIDIRECTIONAL, KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP)) {
+    sound = AUD_Sound_pingpong(sound);
+  }
+
   AUD_Device *device = AUD_Device_getCurrent();
   m_handle = AUD_Device_play(device, sound, false);
   AUD_Device_free(device);
@@ -137,16 +213,167 @@ void SCA_SoundActuator::play()
       AUD_Handle_setConeAngleInner(m_handle, m_3d.cone_inner_angle);
       AUD_Handle_setConeAngleOuter(m_handle, m_3d.cone_outer_angle);
       AUD_Handle_setConeVolumeOuter(m_handle, m_3d.cone_outer_gain);
+      ApplyVoiceLocation();
     }
 
-    if (loop)
+    if (m_loop)
       AUD_Handle_setLoopCount(m_handle, -1);
     AUD_Handle_setPitch(m_handle, m_pitch);
     AUD_Handle_setVolume(m_handle, m_volume);
+    if (position > 0.0f)
+      AUD_Handle_setPosition(m_handle, position);
   }
+}
 
-  m_isplaying = true;
+const AUD_SoundInfo &SCA_SoundActuator::GetSoundInfo()
+{
+  if (!m_soundInfoValid) {
+    // Creates a reader, for a file it means opening it.
+    m_soundInfo = AUD_getInfo(m_sound);
+    m_soundInfoValid = true;
+  }
+  return m_soundInfo;
+}
+
+float SCA_SoundActuator::GetPlayLength()
+{
+  const float length = GetSoundInfo().length;
+  if (ELEM(m_type, KX_SOUNDACT_LOOPBIDIRECTIONAL, KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP)) {
+    return length * 2.0f;
+  }
+  return length;
+}
+
+float SCA_SoundActuator::GetVoicePosition(double time)
+{
+  if (!m_virtual) {
+    return m_handle ? AUD_Handle_getPosition(m_handle) : 0.0f;
+  }
+
+  // The doppler effect is ignored, it doesn't change the playback time on average.
+  float position = m_virtualPosition + float(time - m_virtualTime) * m_pitch;
+  if (m_loop) {
+    const float length = GetPlayLength();
+    if (length > 0.0f) {
+      position = fmodf(position, length);
+    }
+  }
+  return position;
+}
+
+bool SCA_SoundActuator::IsVoicePlaying()
+{
+  if (m_virtual) {
+    if (m_loop) {
+      return true;
+    }
+    // A sound of unknown length plays until it's stopped.
+    const float length = GetPlayLength();
+    return (length <= 0.0f || GetVoicePosition(m_voiceManager->GetTime()) < length);
+  }
+
+  return m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+}
+#endif  // WITH_AUDASPACE
+
+int SCA_SoundActuator::GetVoiceCategory() const
+{
+  return m_category;
+}
+
+bool SCA_SoundActuator::IsVoicePaused() const
+{
+#ifdef WITH_AUDASPACE
+  return m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PAUSED) : false;
+#else
+  return false;
+#endif  // WITH_AUDASPACE
+}
+
+#ifdef WITH_AUDASPACE
+float SCA_SoundActuator::GetVoiceGain(AUD_DistanceModel model)
+{
+  // The device only spatializes the mono sounds.
+  if (!m_is3d || GetSoundInfo().specs.channels != AUD_CHANNELS_MONO) {
+    return m_volume;
+  }
+
+  const float reference = m_3d.reference_distance;
+  float distance = m_location.length();
+  float gain = 1.0f;
+
+  if (distance > 0.0f) {
+    if (ELEM(model,
+             AUD_DISTANCE_MODEL_INVERSE_CLAMPED,
+             AUD_DISTANCE_MODEL_LINEAR_CLAMPED,
+             AUD_DISTANCE_MODEL_EXPONENT_CLAMPED)) {
+      distance = std::max(std::min(m_3d.max_distance, distance), reference);
+    }
+
+    switch (model) {
+      case AUD_DISTANCE_MODEL_INVERSE:
+      case AUD_DISTANCE_MODEL_INVERSE_CLAMPED: {
+        gain = reference / (reference + m_3d.rolloff_factor * (distance - reference));
+        break;
+      }
+      case AUD_DISTANCE_MODEL_LINEAR:
+      case AUD_DISTANCE_MODEL_LINEAR_CLAMPED: {
+        const float range = m_3d.max_distance - reference;
+        if (range == 0.0f) {
+          gain = (distance > reference) ? 0.0f : 1.0f;
+        }
+        else {
+          gain = 1.0f - m_3d.rolloff_factor * (distance - reference) / range;
+        }
+        break;
+      }
+      case AUD_DISTANCE_MODEL_EXPONENT:
+      case AUD_DISTANCE_MODEL_EXPONENT_CLAMPED: {
+        gain = (reference == 0.0f) ? 0.0f : powf(distance / reference, -m_3d.rolloff_factor);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  gain = std::max(std::min(gain, m_3d.max_gain), m_3d.min_gain);
+
+  return gain * m_volume;
+}
 #endif  // WITH_AUDASPACE
+
+bool SCA_SoundActuator::SetVoiceVirtual(bool virt, double time)
+{
+#ifdef WITH_AUDASPACE
+  if (virt == m_virtual) {
+    return m_virtual;
+  }
+
+  if (virt) {
+    // A handle which just ended is left to the logic.
+    if (!m_handle || AUD_Handle_getStatus(m_handle) != AUD_STATUS_PLAYING) {
+      return false;
+    }
+
+    m_virtualPosition = AUD_Handle_getPosition(m_handle);
+    m_virtualTime = time;
+    AUD_Handle_stop(m_handle);
+    m_handle = nullptr;
+    m_virtual = true;
+  }
+  else {
+    if (!IsVoicePlaying()) {
+      return true;
+    }
+
+    const float position = GetVoicePosition(time);
+    m_virtual = false;
+    PlayHandle(position);
+  }
+#endif  // WITH_AUDASPACE
+
+  return m_virtual;
 }
 
 CValue *SCA_SoundActuator::GetReplica()
@@ -163,6 +390,7 @@ void SCA_SoundActuator::ProcessReplica()
   m_handle = nullptr;
   m_sound = m_sound ? AUD_Sound_copy(m_sound) : nullptr;
 #endif  // WITH_AUDASPACE
+  m_virtual = false;
 }
 
 bool SCA_SoundActuator::Update(double curtime)
@@ -182,7 +410,7 @@ bool SCA_SoundActuator::Update(double curtime)
     return false;
 
   // actual audio device playing state
-  bool isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  bool isplaying = IsVoicePlaying();
 
   if (bNegativeEvent) {
     // here must be a check if it is still playing
@@ -192,10 +420,7 @@ bool SCA_SoundActuator::Update(double curtime)
         case KX_SOUNDACT_LOOPSTOP:
         case KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP: {
           // stop immediately
-          if (m_handle) {
-            AUD_Handle_stop(m_handle);
-            m_handle = nullptr;
-          }
+          StopVoice();
           break;
         }
         case KX_SOUNDACT_PLAYEND: {
@@ -207,6 +432,13 @@ bool SCA_SoundActuator::Update(double curtime)
           // stop the looping so that the sound stops when it finished
           if (m_handle)
             AUD_Handle_setLoopCount(m_handle, 0);
+          else if (m_virtual) {
+            // finish the current loop
+            const double time = m_voiceManager->GetTime();
+            m_virtualPosition = GetVoicePosition(time);
+            m_virtualTime = time;
+          }
+          m_loop = false;
           break;
         }
         default:
@@ -233,35 +465,23 @@ bool SCA_SoundActuator::Update(double curtime)
       play();
   }
   // verify that the sound is still playing
-  isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+  isplaying = IsVoicePlaying();
 
   if (isplaying) {
-    if (m_is3d) {
-      KX_Camera *cam = KX_GetActiveScene()->GetActiveCamera();
-      if (cam) {
-        KX_GameObject *obj = (KX_GameObject *)this->GetParent();
-        MT_Vector3 p;
-        MT_Matrix3x3 Mo;
-        float data[4];
-
-        Mo = cam->NodeGetWorldOrientation().inverse();
-        p = (obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setLocation(m_handle, data);
-        p = (obj->GetLinearVelocity() - cam->GetLinearVelocity());
-        p = Mo * p;
-        p.getValue(data);
-        AUD_Handle_setVelocity(m_handle, data);
-        (Mo * obj->NodeGetWorldOrientation()).getRotation().getValue(data);
-        AUD_Handle_setOrientation(m_handle, data);
-      }
+    UpdateVoiceLocation();
+    // a virtual voice only needs its location to estimate its gain
+    if (m_is3d && m_handle) {
+      ApplyVoiceLocation();
     }
     result = true;
   }
   else {
     m_isplaying = false;
     result = false;
+    // a paused sound can still be resumed by startSound
+    if (!IsVoicePaused()) {
+      StopVoice();
+    }
   }
 #endif  // WITH_AUDASPACE
 
@@ -350,6 +570,9 @@ PyAttributeDef SCA_SoundActuator::Attributes[] = {
                            false,
                            SCA_SoundActuator,
                            m_type),
+    KX_PYATTRIBUTE_INT_RW(
+        "category", 0, SCA_VoiceManager::NUM_CATEGORIES - 1, true, SCA_SoundActuator, m_category),
+    KX_PYATTRIBUTE_BOOL_RO("isVirtual", SCA_SoundActuator, m_virtual),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -360,7 +583,9 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                           "\tStarts the sound.\n")
 {
 #  ifdef WITH_AUDASPACE
-  switch (m_handle ? AUD_Handle_getStatus(m_handle) : AUD_STATUS_INVALID) {
+  // a virtual voice is playing for the user
+  switch (m_virtual ? AUD_STATUS_PLAYING :
+                      (m_handle ? AUD_Handle_getStatus(m_handle) : AUD_STATUS_INVALID)) {
     case AUD_STATUS_PLAYING:
       break;
     case AUD_STATUS_PAUSED:
@@ -380,6 +605,8 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                           "\tPauses the sound.\n")
 {
 #  ifdef WITH_AUDASPACE
+  // a paused voice keeps its handle to resume exactly
+  SetVoiceVirtual(false, m_voiceManager->GetTime());
   if (m_handle)
     AUD_Handle_pause(m_handle);
 #  endif  // WITH_AUDASPACE
@@ -392,12 +619,7 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator,
                           "stopSound()\n"
                           "\tStops the sound.\n")
 {
-#  ifdef WITH_AUDASPACE
-  if (m_handle) {
-    AUD_Handle_stop(m_handle);
-    m_handle = nullptr;
-  }
-#  endif  // WITH_AUDASPACE
+  StopVoice();
 
   Py_RETURN_NONE;
 }
@@ -450,8 +672,7 @@ PyObject *SCA_SoundActuator::pyattr_get_audposition(PyObjectPlus *self,
 #  ifdef WITH_AUDASPACE
   SCA_SoundActuator *actuator = static_cast<SCA_SoundActuator *>(self);
 
-  if (actuator->m_handle)
-    position = AUD_Handle_getPosition(actuator->m_handle);
+  position = actuator->GetVoicePosition(actuator->m_voiceManager->GetTime());
 #  endif  // WITH_AUDASPACE
 
   PyObject *result = PyFloat_FromDouble(position);
@@ -585,6 +806,10 @@ int SCA_SoundActuator::pyattr_set_audposition(PyObjectPlus *self,
 
   if (actuator->m_handle)
     AUD_Handle_setPosition(actuator->m_handle, position);
+  else if (actuator->m_virtual) {
+    actuator->m_virtualPosition = position;
+    actuator->m_virtualTime = actuator->m_voiceManager->GetTime();
+  }
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
@@ -618,6 +843,15 @@ int SCA_SoundActuator::pyattr_set_pitch(PyObjectPlus *self,
   if (!PyArg_Parse(value, "f", &pitch))
     return PY_SET_ATTR_FAIL;
 
+#  ifdef WITH_AUDASPACE
+  // the virtual playback time advances at the previous pitch until now
+  if (actuator->m_virtual) {
+    const double time = actuator->m_voiceManager->GetTime();
+    actuator->m_virtualPosition = actuator->GetVoicePosition(time);
+    actuator->m_virtualTime = time;
+  }
+#  endif  // WITH_AUDASPACE
+
   actuator->m_pitch = pitch;
 
 #  ifdef WITH_AUDASPACE
@@ -647,6 +881,7 @@ int SCA_SoundActuator::pyattr_set_sound(PyObjectPlus *self,
 
   AUD_Sound_free(actuator->m_sound);
   actuator->m_sound = snd;
+  actuator->m_soundInfoValid = false;
 #  endif  // WITH_AUDASPACE
 
   return PY_SET_ATTR_SUCCESS;
@@ -36,11 +36,17 @@
 
 #include "SCA_IActuator.h"
 
+#include "MT_Quaternion.h"
+#include "MT_Vector3.h"
+
 #ifdef WITH_AUDASPACE
+#  include <AUD_Device.h>
 #  include <AUD_Handle.h>
 #  include <AUD_Sound.h>
 #endif
 
+class SCA_VoiceManager;
+
 typedef struct KX_3DSoundSettings {
   float min_gain;
   float max_gain;
@@ -57,13 +63,46 @@ class SCA_SoundActuator : public SCA_IActuator {
 #ifdef WITH_AUDASPACE
   AUD_Sound *m_sound;
   AUD_Handle *m_handle;
+  /// Specs and length of the sound, read the first time they are needed.
+  AUD_SoundInfo m_soundInfo;
+  bool m_soundInfoValid;
 #endif  // WITH_AUDASPACE
   float m_volume;
   float m_pitch;
   bool m_is3d;
   KX_3DSoundSettings m_3d;
 
+  SCA_VoiceManager *m_voiceManager;
+  /// Category ranking the voice in the voice manager.
+  int m_category;
+  /// True when the sound is playing without device handle.
+  bool m_virtual;
+  /// True when the played sound loops.
+  bool m_loop;
+  /// Playback time of the virtual voice at m_virtualTime.
+  float m_virtualPosition;
+  double m_virtualTime;
+  /// Location, velocity and orientation of the sound relative to the active camera.
+  MT_Vector3 m_location;
+  MT_Vector3 m_velocity;
+  MT_Quaternion m_orientation;
+
   void play();
+  /// Stop the sound and unregister the voice.
+  void StopVoice();
+  /// Compute the location of a 3D sound relative to the active camera.
+  void UpdateVoiceLocation();
+#ifdef WITH_AUDASPACE
+  /// Create the device handle playing the sound from a playback time.
+  void PlayHandle(float position);
+  /// Set the location of a 3D sound to the device handle.
+  void ApplyVoiceLocation();
+  const AUD_SoundInfo &GetSoundInfo();
+  /// Length of the played sound, twice the sound for the bidirectional loops.
+  float GetPlayLength();
+  /// Playback time, for a virtual voice it's advanced by the real time elapsed.
+  float GetVoicePosition(double time);
+#endif  // WITH_AUDASPACE
 
  public:
   enum KX_SOUNDACT_TYPE {
@@ -96,6 +135,22 @@ class SCA_SoundActuator : public SCA_IActuator {
   CValue *GetReplica();
   void ProcessReplica();
 
+  int GetVoiceCategory() const;
+  bool IsVoicePaused() const;
+#ifdef WITH_AUDASPACE
+  /// Return true while the sound is played by the device or virtually.
+  bool IsVoicePlaying();
+  /** Estimate the gain of the sound at the listener like the device does, the cone is
+   * ignored so the gain is never under the mixed one.
+   */
+  float GetVoiceGain(AUD_DistanceModel model);
+#endif  // WITH_AUDASPACE
+  /** Stop the device handle keeping the playback time, or play the sound again from the
+   * playback time.
+   * \return True if the voice is virtual.
+   */
+  bool SetVoiceVirtual(bool virt, double time);
+
 #ifdef WITH_PYTHON
 
   /* -------------------------------------------------------------------- */
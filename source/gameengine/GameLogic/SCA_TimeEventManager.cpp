@@ -69,16 +69,27 @@ void SCA_TimeEventManager::NextFrame(double curtime, double fixedtime)
     return;
   }
 
-  CFloatValue *floatval = new CFloatValue(curtime);
+  CFloatValue *floatval = nullptr;
 
   // update sensors, but ... need deltatime !
   for (CValue *prop : m_timevalues) {
     float newtime = prop->GetNumber() + fixedtime;
-    floatval->SetFloat(newtime);
-    prop->SetValue(floatval);
+    // Timer properties are floats, other types are converted by SetValue.
+    if (prop->GetValueType() == VALUE_FLOAT_TYPE) {
+      static_cast<CFloatValue *>(prop)->SetFloat(newtime);
+    }
+    else {
+      if (!floatval) {
+        floatval = new CFloatValue(newtime);
+      }
+      floatval->SetFloat(newtime);
+      prop->SetValue(floatval);
+    }
   }
 
-  floatval->Release();
+  if (floatval) {
+    floatval->Release();
+  }
 }
 
 void SCA_TimeEventManager::AddTimeProperty(CValue *timeval)
@@ -0,0 +1,202 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_VoiceManager.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_VoiceManager.h"
+
+#include <algorithm>
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Device.h>
+#endif
+
+#include "SCA_SoundActuator.h"
+
+#define DEFAULT_VOICE_LIMIT 64
+// -60 dB, a voice under this gain is covered by any other sound.
+#define DEFAULT_MINIMUM_GAIN 0.001f
+
+SCA_VoiceManager::SCA_VoiceManager()
+    : m_voiceLimit(DEFAULT_VOICE_LIMIT),
+      m_minimumGain(DEFAULT_MINIMUM_GAIN),
+      m_time(0.0),
+      m_numActiveVoices(0),
+      m_numVirtualVoices(0),
+      m_numRealVoices(0)
+{
+  std::fill(m_categoryPriorities, m_categoryPriorities + NUM_CATEGORIES, 0);
+}
+
+SCA_VoiceManager::~SCA_VoiceManager()
+{
+}
+
+bool SCA_VoiceManager::AddVoice(SCA_SoundActuator *voice, float gain)
+{
+  m_mutex.Lock();
+  m_voices.push_back(voice);
+  // The voices are ranked at the next update, until then the limit is first come first served.
+  const bool real = (gain > m_minimumGain) &&
+                    (m_voiceLimit == 0 || m_numRealVoices < (unsigned int)m_voiceLimit);
+  if (real) {
+    ++m_numRealVoices;
+  }
+  m_mutex.Unlock();
+
+  return real;
+}
+
+void SCA_VoiceManager::RemoveVoice(SCA_SoundActuator *voice)
+{
+  m_mutex.Lock();
+  std::vector<SCA_SoundActuator *>::iterator it = std::find(
+      m_voices.begin(), m_voices.end(), voice);
+  if (it != m_voices.end()) {
+    *it = m_voices.back();
+    m_voices.pop_back();
+  }
+  m_mutex.Unlock();
+}
+
+int SCA_VoiceManager::GetVoiceLimit() const
+{
+  return m_voiceLimit;
+}
+
+void SCA_VoiceManager::SetVoiceLimit(int limit)
+{
+  m_voiceLimit = std::max(limit, 0);
+}
+
+float SCA_VoiceManager::GetMinimumGain() const
+{
+  return m_minimumGain;
+}
+
+void SCA_VoiceManager::SetMinimumGain(float gain)
+{
+  m_minimumGain = std::max(gain, 0.0f);
+}
+
+int SCA_VoiceManager::GetCategoryPriority(int category) const
+{
+  return m_categoryPriorities[category];
+}
+
+void SCA_VoiceManager::SetCategoryPriority(int category, int priority)
+{
+  m_categoryPriorities[category] = priority;
+}
+
+double SCA_VoiceManager::GetTime() const
+{
+  return m_time;
+}
+
+void SCA_VoiceManager::Update(double time)
+{
+  m_time = time;
+  m_numActiveVoices = 0;
+  m_numVirtualVoices = 0;
+  m_numRealVoices = 0;
+
+#ifdef WITH_AUDASPACE
+  if (m_voices.empty()) {
+    return;
+  }
+
+  AUD_Device *device = AUD_Device_getCurrent();
+  if (!device) {
+    return;
+  }
+  const AUD_DistanceModel model = AUD_Device_getDistanceModel(device);
+  AUD_Device_free(device);
+
+  m_mutex.Lock();
+
+  m_ranks.clear();
+  for (unsigned int i = 0; i < m_voices.size();) {
+    SCA_SoundActuator *voice = m_voices[i];
+    // A paused voice is not mixed and resumes where it was paused.
+    if (voice->IsVoicePaused()) {
+      ++i;
+      continue;
+    }
+
+    // A finished voice is stopped by its actuator at the next logic frame.
+    if (!voice->IsVoicePlaying()) {
+      m_voices[i] = m_voices.back();
+      m_voices.pop_back();
+      continue;
+    }
+    ++i;
+
+    const float gain = voice->GetVoiceGain(model);
+    if (gain <= m_minimumGain) {
+      if (voice->SetVoiceVirtual(true, time)) {
+        ++m_numVirtualVoices;
+      }
+      continue;
+    }
+
+    m_ranks.push_back({voice, m_categoryPriorities[voice->GetVoiceCategory()], gain});
+  }
+
+  // Only sort the audible voices over the limit, the common case is to play them all.
+  unsigned int numReal = m_ranks.size();
+  if (m_voiceLimit > 0 && numReal > (unsigned int)m_voiceLimit) {
+    numReal = m_voiceLimit;
+    std::nth_element(m_ranks.begin(),
+                     m_ranks.begin() + numReal,
+                     m_ranks.end(),
+                     [](const VoiceRank &r1, const VoiceRank &r2) {
+                       return (r1.m_priority > r2.m_priority) ||
+                              (r1.m_priority == r2.m_priority && r1.m_gain > r2.m_gain);
+                     });
+  }
+
+  for (unsigned int i = 0, size = m_ranks.size(); i < size; ++i) {
+    if (m_ranks[i].m_voice->SetVoiceVirtual(i >= numReal, time)) {
+      ++m_numVirtualVoices;
+    }
+    else {
+      ++m_numActiveVoices;
+    }
+  }
+  m_numRealVoices = m_numActiveVoices;
+
+  m_mutex.Unlock();
+#endif  // WITH_AUDASPACE
+}
+
+unsigned int SCA_VoiceManager::GetNumActiveVoices() const
+{
+  return m_numActiveVoices;
+}
+
+unsigned int SCA_VoiceManager::GetNumVirtualVoices() const
+{
+  return m_numVirtualVoices;
+}
@@ -0,0 +1,100 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_VoiceManager.h
+ *  \ingroup gamelogic
+ */
+
+#ifndef __SCA_VOICEMANAGER_H__
+#define __SCA_VOICEMANAGER_H__
+
+#include <vector>
+
+#include "CM_Thread.h"
+
+class SCA_SoundActuator;
+
+/** Choose which playing sound actuators own a handle of the audio device.
+ * The voices are ranked by the priority of their category and their estimated gain at the
+ * listener, only the first voices up to the limit are played by the device. The others and
+ * the inaudible voices are virtual, they keep their playback time without being decoded or
+ * mixed and are played again from this time when they are chosen.
+ */
+class SCA_VoiceManager {
+ public:
+  enum { NUM_CATEGORIES = 16 };
+
+  SCA_VoiceManager();
+  ~SCA_VoiceManager();
+
+  /** Register a playing voice, called from the logic of any scene.
+   * \param gain The estimated gain of the voice at the listener.
+   * \return True if the voice can be played by the device until the next update, false if it
+   * starts virtual.
+   */
+  bool AddVoice(SCA_SoundActuator *voice, float gain);
+  void RemoveVoice(SCA_SoundActuator *voice);
+
+  /// Maximum number of voices played by the device, 0 for no limit.
+  int GetVoiceLimit() const;
+  void SetVoiceLimit(int limit);
+  /// Gain at the listener under which a voice is virtual.
+  float GetMinimumGain() const;
+  void SetMinimumGain(float gain);
+  /// Priority of the voices of a category, the higher voices are played first.
+  int GetCategoryPriority(int category) const;
+  void SetCategoryPriority(int category, int priority);
+
+  /// Real time of the last update, used to track the playback time of the virtual voices.
+  double GetTime() const;
+
+  /// Make the voices real or virtual, called once per frame after the logic.
+  void Update(double time);
+
+  unsigned int GetNumActiveVoices() const;
+  unsigned int GetNumVirtualVoices() const;
+
+ private:
+  struct VoiceRank {
+    SCA_SoundActuator *m_voice;
+    int m_priority;
+    float m_gain;
+  };
+
+  std::vector<SCA_SoundActuator *> m_voices;
+  /// Protect the voices list, isolated scenes can start sounds in parallel.
+  CM_ThreadMutex m_mutex;
+  /// Voices sorted by rank during the update.
+  std::vector<VoiceRank> m_ranks;
+
+  int m_voiceLimit;
+  float m_minimumGain;
+  int m_categoryPriorities[NUM_CATEGORIES];
+  double m_time;
+
+  unsigned int m_numActiveVoices;
+  unsigned int m_numVirtualVoices;
+  /// Voices played by the device, the active voices of the last update plus the voices added.
+  unsigned int m_numRealVoices;
+};
+
+#endif  // __SCA_VOICEMANAGER_H__
@@ -79,6 +79,11 @@ void GPG_Canvas::Resize(int width, int height)
 
 void GPG_Canvas::MakeScreenShot(const std::string &filename)
 {
+  // Nothing is drawn without window.
+  if (!m_window) {
+    return;
+  }
+
   // copy image data
   unsigned int dumpsx = GetWidth();
   unsigned int dumpsy = GetHeight();
@@ -165,6 +170,12 @@ bool GPG_Canvas::GetSwapInterval(int &intervalOut)
 
 void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 {
+  if (!m_window) {
+    width = GetWidth();
+    height = GetHeight();
+    return;
+  }
+
   unsigned int uiwidth;
   unsigned int uiheight;
 
@@ -177,6 +188,11 @@ void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 
 void GPG_Canvas::ResizeWindow(int width, int height)
 {
+  if (!m_window) {
+    Resize(width, height);
+    return;
+  }
+
   if (m_window->getState() == GHOST_kWindowStateFullScreen) {
     GHOST_ISystem *system = GHOST_ISystem::getSystem();
     GHOST_DisplaySetting setting;
@@ -196,6 +212,10 @@ void GPG_Canvas::ResizeWindow(int width, int height)
 
 void GPG_Canvas::SetFullScreen(bool enable)
 {
+  if (!m_window) {
+    return;
+  }
+
   if (enable) {
     m_window->setState(GHOST_kWindowStateFullScreen);
   }
@@ -206,12 +226,18 @@ void GPG_Canvas::SetFullScreen(bool enable)
 
 bool GPG_Canvas::GetFullScreen()
 {
-  return (m_window->getState() == GHOST_kWindowStateFullScreen);
+  return (m_window && m_window->getState() == GHOST_kWindowStateFullScreen);
 }
 
 void GPG_Canvas::ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool UNUSED(screen))
 {
-  m_window->screenToClient(x, y, r_x, r_y);
+  if (m_window) {
+    m_window->screenToClient(x, y, r_x, r_y);
+  }
+  else {
+    r_x = x;
+    r_y = y;
+  }
 }
 
 bool GPG_Canvas::IsBlenderPlayer()
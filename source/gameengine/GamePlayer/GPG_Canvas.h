@@ -47,7 +47,7 @@ struct Scene;
 
 class GPG_Canvas : public RAS_ICanvas {
  protected:
-  /// GHOST window.
+  /// GHOST window, nullptr for the headless player.
   GHOST_IWindow *m_window;
   /// Width of the context.
   int m_width;
@@ -453,7 +453,7 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   }
   CM_Message(std::endl)
       CM_Message("usage:   " << program << " [--options] " << example_filename << std::endl);
-  CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] "
+  CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] [-headless] "
              << consoleoption << "[-g gamengineoptions] "
              << "[-s stereomode] [-m aasamples]");
   CM_Message("Optional parameters must be passed in order.");
@@ -479,6 +479,9 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   CM_Message("       Note: To define 'fw'' or 'fh'', both must be used.");
   CM_Message("       Example: -f  or  -f 1024 768  or  -f 0 0 16  or  -f 1024 728 16 30"
              << std::endl);
+  CM_Message("  -headless: run only the logic and physics, without window nor GPU context");
+  CM_Message("       The frames are paced by the logic tic rate, e.g. for a game server."
+             << std::endl);
   CM_Message("  -s: start player in stereoscopy mode (requires 3D capable hardware)");
   CM_Message(
       "       stereomode: nostereo         (default unless stereo is set in the blend file)");
@@ -507,6 +510,8 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   CM_Message("       show_framerate                 0         Show the frame rate");
   CM_Message("       show_properties                0         Show debug properties");
   CM_Message("       show_profile                   0         Show profiling information");
+  CM_Message("       profile_trace                            Write a Chrome trace of the frames");
+  CM_Message("       profile_trace_size             1048576   Number of recorded trace zones");
   CM_Message("       show_bounding_box              0         Show debug bounding box volume");
   CM_Message("       show_armatures                 0         Show debug armatures");
   CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
@@ -1085,6 +1090,12 @@ int main(int argc,
         }
         case 'h':  // display help
         {
+          if (strcmp(argv[i], "-headless") == 0) {
+            i++;
+            SYS_WriteCommandLineInt(syshandle, "headless", 1);
+            break;
+          }
+
           usage(argv[0], isBlenderPlayer);
           return 0;
           break;
@@ -1219,13 +1230,19 @@ int main(int argc,
     usage(argv[0], isBlenderPlayer);
     return 0;
   }
+
+  // No window, GPU context nor rendering, only the logic and physics run.
+  const bool headless = (SYS_GetCommandLineInt(syshandle, "headless", 0) != 0);
+
   GHOST_ISystem *system = nullptr;
 #ifdef WIN32
   if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
   {
     // Create the system
-    if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+    const GHOST_TSuccess success = headless ? GHOST_ISystem::createSystemBackground() :
+                                              GHOST_ISystem::createSystem();
+    if (success == GHOST_kSuccess) {
       system = GHOST_ISystem::getSystem();
       BLI_assert(system);
 
@@ -1438,7 +1455,10 @@ int main(int argc,
             if (firstTimeRunning) {
               firstTimeRunning = false;
 
-              if (fullScreen) {
+              if (headless) {
+                // No window to open.
+              }
+              else if (fullScreen) {
 #ifdef WIN32
                 if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER) {
                   window = startScreenSaverFullScreen(system,
@@ -1529,8 +1549,13 @@ int main(int argc,
             CTX_wm_manager_set(C, wm);
             CTX_wm_window_set(C, win);
             InitBlenderContextVariables(C, wm, bfd->curscene);
-            wm_window_ghostwindow_blenderplayer_ensure(wm, win, window, first_time_window);
-            if (first_time_window) {
+            if (headless) {
+              wm_window_headless_blenderplayer_ensure(wm, win, first_time_window);
+            }
+            else {
+              wm_window_ghostwindow_blenderplayer_ensure(wm, win, window, first_time_window);
+            }
+            if (first_time_window && !headless) {
               /* We need to have first an ogl context bound and it's done
                * in wm_window_ghostwindow_blenderplayer_ensure.
                */
@@ -1691,11 +1716,13 @@ int main(int argc,
 
   BLF_exit();
 
-  DRW_opengl_context_enable_ex(false);
-  GPU_pass_cache_free();
-  GPU_exit();
-  DRW_opengl_context_disable_ex(false);
-  DRW_opengl_context_destroy();
+  if (!headless) {
+    DRW_opengl_context_enable_ex(false);
+    GPU_pass_cache_free();
+    GPU_exit();
+    DRW_opengl_context_disable_ex(false);
+    DRW_opengl_context_destroy();
+  }
 
   if (window) {
     system->disposeWindow(window);
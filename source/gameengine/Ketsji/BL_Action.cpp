@@ -375,19 +375,19 @@ void BL_Action::Update(float curtime, bool applyToObject)
                                                                                  m_localframe);
 
   if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
-    DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+    /* The action can be updated from a task in parallel with other armatures,
+     * depsgraph tags are collected by the scene and applied after. */
+    scene->AppendToIdsToUpdate(&ob->id, ID_RECALC_TRANSFORM);
 
     // BKE_object_where_is_calc_time(depsgraph, sc, ob, m_localframe);
 
-    scene->ResetTaaSamples();
-
     BL_ArmatureObject *obj = (BL_ArmatureObject *)m_obj;
 
     if (m_layer_weight >= 0)
       obj->GetPose(&m_blendpose);
 
     // Extract the pose from the action
-    obj->SetPoseByAction(m_action, &animEvalContext);
+    obj->SetPoseByAction(m_action, &animEvalContext, &scene->GetActionPoseCache());
 
     m_obj->ForceIgnoreParentTx();
 
@@ -421,11 +421,10 @@ void BL_Action::Update(float curtime, bool applyToObject)
       // TODO: We need to find the good notifier per action
       if (!BKE_modifier_is_non_geometrical(md) && ob->adt &&
           ob->adt->action->id.name == m_action->id.name) {
-        DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+        scene->AppendToIdsToUpdate(&ob->id, ID_RECALC_GEOMETRY);
         PointerRNA ptrrna;
         RNA_id_pointer_create(&ob->id, &ptrrna);
         animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-        scene->ResetTaaSamples();
         break;
       }
       /* HERE we can add other modifier action types,
@@ -439,14 +438,12 @@ void BL_Action::Update(float curtime, bool applyToObject)
           if (!m_obj->OrigObCanBeTransformedInRealtime(ob)) {
             break;
           }
-          DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+          scene->AppendToIdsToUpdate(&ob->id, ID_RECALC_TRANSFORM);
           PointerRNA ptrrna;
           RNA_id_pointer_create(&ob->id, &ptrrna);
           animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
 
           m_obj->ForceIgnoreParentTx();
-
-          scene->ResetTaaSamples();
           break;
         }
         /* HERE we can add other constraint action types,
@@ -461,11 +458,10 @@ void BL_Action::Update(float curtime, bool applyToObject)
         if (ma->use_nodes && ma->nodetree) {
           bNodeTree *node_tree = ma->nodetree;
           if (node_tree->adt && node_tree->adt->action->id.name == m_action->id.name) {
-            DEG_id_tag_update(&ma->id, ID_RECALC_SHADING);
+            scene->AppendToIdsToUpdate(&ma->id, ID_RECALC_SHADING);
             PointerRNA ptrrna;
             RNA_id_pointer_create(&node_tree->id, &ptrrna);
             animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-            scene->ResetTaaSamples();
             break;
           }
         }
@@ -476,7 +472,7 @@ void BL_Action::Update(float curtime, bool applyToObject)
     if (ob->type == OB_MESH && me) {
       const bool bHasShapeKey = me->key && me->key->type == KEY_RELATIVE;
       if (bHasShapeKey && me->key->adt && me->key->adt->action->id.name == m_action->id.name) {
-        DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+        scene->AppendToIdsToUpdate(&me->id, ID_RECALC_GEOMETRY);
         Key *key = me->key;
 
         PointerRNA ptrrna;
@@ -506,8 +502,6 @@ void BL_Action::Update(float curtime, bool applyToObject)
         //}
 
         // shape_deformer->SetLastFrame(curtime);
-
-        scene->ResetTaaSamples();
       }
     }
     // TEST World Background actions
@@ -515,11 +509,10 @@ void BL_Action::Update(float curtime, bool applyToObject)
     if (world && world->use_nodes && world->nodetree) {
       bNodeTree *node_tree = world->nodetree;
       if (node_tree->adt && node_tree->adt->action->id.name == m_action->id.name) {
-        DEG_id_tag_update(&world->id, ID_RECALC_SHADING);
+        scene->AppendToIdsToUpdate(&world->id, ID_RECALC_SHADING);
         PointerRNA ptrrna;
         RNA_id_pointer_create(&node_tree->id, &ptrrna);
         animsys_evaluate_action(&ptrrna, m_action, &animEvalContext, false);
-        scene->ResetTaaSamples();
       }
     }
   }
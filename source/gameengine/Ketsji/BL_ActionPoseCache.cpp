@@ -0,0 +1,345 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/BL_ActionPoseCache.cpp
+ *  \ingroup ketsji
+ */
+
+#include "BL_ActionPoseCache.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+#include "BKE_fcurve.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_string.h"
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "MEM_guardedalloc.h"
+
+#define DEFAULT_MAX_POSES 1024
+
+#define CHANNEL_OFFSET(member) (offsetof(bPoseChannel, member) / sizeof(float))
+
+/** Resolve the pose channel and the float member written by a F-Curve.
+ * Only the transform of the pose channels is supported, any other path is evaluated by the
+ * animation system.
+ */
+static bool resolve_fcurve_target(const FCurve *fcu,
+                                  const std::map<std::string, unsigned int> &channelIndices,
+                                  unsigned int &channel,
+                                  unsigned int &offset)
+{
+  static const char *prefix = "pose.bones[";
+
+  if (!fcu->rna_path || strncmp(fcu->rna_path, prefix, strlen(prefix)) != 0) {
+    return false;
+  }
+
+  const char *prop = strrchr(fcu->rna_path, '.');
+  if (!prop) {
+    return false;
+  }
+  ++prop;
+
+  char *name = BLI_str_quoted_substrN(fcu->rna_path, prefix);
+  // The path must be exactly a property of the bone, not of a constraint for example.
+  const bool direct = (strlen(prefix) + 1 + strlen(name) + 3 + strlen(prop) ==
+                       strlen(fcu->rna_path));
+  const std::map<std::string, unsigned int>::const_iterator it = channelIndices.find(name);
+  MEM_freeN(name);
+
+  if (!direct || it == channelIndices.end()) {
+    return false;
+  }
+  channel = it->second;
+
+  const int index = fcu->array_index;
+  if (STREQ(prop, "location") && index >= 0 && index < 3) {
+    offset = CHANNEL_OFFSET(loc) + index;
+  }
+  else if (STREQ(prop, "scale") && index >= 0 && index < 3) {
+    offset = CHANNEL_OFFSET(size) + index;
+  }
+  else if (STREQ(prop, "rotation_euler") && index >= 0 && index < 3) {
+    offset = CHANNEL_OFFSET(eul) + index;
+  }
+  else if (STREQ(prop, "rotation_quaternion") && index >= 0 && index < 4) {
+    offset = CHANNEL_OFFSET(quat) + index;
+  }
+  else if (STREQ(prop, "rotation_axis_angle") && index >= 0 && index < 4) {
+    // The angle is the first value of the RNA property.
+    offset = (index == 0) ? CHANNEL_OFFSET(rotAngle) : CHANNEL_OFFSET(rotAxis) + index - 1;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+template<class T> static void checksum_add(BLI_HashMurmur2A &mm2, const T &value)
+{
+  BLI_hash_mm2a_add(&mm2, (const unsigned char *)&value, sizeof(T));
+}
+
+/** Compute a checksum of the F-Curves of an action with the keyframes and settings read by their
+ * evaluation, to detect the F-Curves added, removed or edited.
+ */
+static unsigned int action_checksum(const bAction *action)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  for (const FCurve *fcu = (const FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+    checksum_add(mm2, fcu);
+    checksum_add(mm2, fcu->driver);
+    checksum_add(mm2, fcu->grp ? (fcu->grp->flag & AGRP_MUTED) : 0);
+    checksum_add(mm2, fcu->flag);
+    checksum_add(mm2, fcu->extend);
+    checksum_add(mm2, fcu->array_index);
+    if (fcu->rna_path) {
+      BLI_hash_mm2a_add(&mm2, (const unsigned char *)fcu->rna_path, strlen(fcu->rna_path));
+    }
+
+    checksum_add(mm2, fcu->totvert);
+    if (fcu->bezt) {
+      BLI_hash_mm2a_add(&mm2, (const unsigned char *)fcu->bezt, sizeof(BezTriple) * fcu->totvert);
+    }
+    else if (fcu->fpt) {
+      BLI_hash_mm2a_add(&mm2, (const unsigned char *)fcu->fpt, sizeof(FPoint) * fcu->totvert);
+    }
+
+    for (const FModifier *fcm = (const FModifier *)fcu->modifiers.first; fcm; fcm = fcm->next) {
+      checksum_add(mm2, fcm->type);
+      checksum_add(mm2, fcm->flag);
+      checksum_add(mm2, fcm->influence);
+      checksum_add(mm2, fcm->sfra);
+      checksum_add(mm2, fcm->efra);
+      checksum_add(mm2, fcm->blendin);
+      checksum_add(mm2, fcm->blendout);
+      const FModifierTypeInfo *fmi = fmodifier_get_typeinfo(fcm);
+      if (fmi && fcm->data) {
+        BLI_hash_mm2a_add(&mm2, (const unsigned char *)fcm->data, fmi->size);
+      }
+    }
+  }
+
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+BL_ActionPoseCache::BL_ActionPoseCache()
+    : m_maxPoses(DEFAULT_MAX_POSES), m_frameStep(0.0f), m_frame(0)
+{
+}
+
+BL_ActionPoseCache::~BL_ActionPoseCache()
+{
+}
+
+void BL_ActionPoseCache::CheckAction(bAction *action)
+{
+  std::map<bAction *, ActionState>::iterator it = m_actions.find(action);
+  if (it != m_actions.end() && it->second.m_lastCheck == m_frame) {
+    return;
+  }
+
+  const unsigned int checksum = action_checksum(action);
+  if (it == m_actions.end()) {
+    m_actions[action] = {checksum, m_frame};
+    return;
+  }
+
+  ActionState &state = it->second;
+  state.m_lastCheck = m_frame;
+  if (state.m_checksum == checksum) {
+    return;
+  }
+  state.m_checksum = checksum;
+
+  /* The bindings can point to removed F-Curves and the poses are outdated. No other armature
+   * uses them during this frame as it is the first use of the action. */
+  for (std::map<BindingKey, Binding>::iterator bit = m_bindings.begin();
+       bit != m_bindings.end();) {
+    bit = (bit->first.second == action) ? m_bindings.erase(bit) : std::next(bit);
+  }
+  for (std::map<PoseKey, Pose>::iterator pit = m_poses.begin(); pit != m_poses.end();) {
+    pit = (std::get<1>(pit->first) == action) ? m_poses.erase(pit) : std::next(pit);
+  }
+}
+
+const BL_ActionPoseCache::Binding &BL_ActionPoseCache::GetBinding(
+    bArmature *armature, bAction *action, const std::vector<bPoseChannel *> &channels)
+{
+  const BindingKey key(armature, action);
+  std::map<BindingKey, Binding>::const_iterator it = m_bindings.find(key);
+  if (it != m_bindings.end()) {
+    return it->second;
+  }
+
+  Binding &binding = m_bindings[key];
+  binding.m_valid = true;
+  binding.m_numChannels = channels.size();
+
+  std::map<std::string, unsigned int> channelIndices;
+  for (unsigned int i = 0, size = channels.size(); i < size; ++i) {
+    channelIndices[channels[i]->name] = i;
+  }
+
+  for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+    // Same curves as skipped by the animation system.
+    if ((fcu->grp && (fcu->grp->flag & AGRP_MUTED)) ||
+        (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) || BKE_fcurve_is_empty(fcu)) {
+      continue;
+    }
+
+    Target target;
+    target.m_fcurve = fcu;
+    if (fcu->driver ||
+        !resolve_fcurve_target(fcu, channelIndices, target.m_channel, target.m_offset)) {
+      binding.m_valid = false;
+      binding.m_targets.clear();
+      break;
+    }
+    binding.m_targets.push_back(target);
+  }
+
+  return binding;
+}
+
+void BL_ActionPoseCache::WritePose(const Binding &binding,
+                                   const std::vector<float> &values,
+                                   const std::vector<bPoseChannel *> &channels)
+{
+  for (unsigned int i = 0, size = binding.m_targets.size(); i < size; ++i) {
+    const Target &target = binding.m_targets[i];
+    float *data = (float *)channels[target.m_channel];
+    data[target.m_offset] = values[i];
+  }
+}
+
+bool BL_ActionPoseCache::SetPose(bArmature *armature,
+                                 bAction *action,
+                                 float frame,
+                                 const std::vector<bPoseChannel *> &channels)
+{
+  if (m_maxPoses == 0 || !armature || !action) {
+    return false;
+  }
+
+  if (m_frameStep > 0.0f) {
+    frame = roundf(frame / m_frameStep) * m_frameStep;
+  }
+
+  m_mutex.Lock();
+
+  CheckAction(action);
+  const Binding &binding = GetBinding(armature, action, channels);
+  if (!binding.m_valid || binding.m_numChannels != channels.size()) {
+    m_mutex.Unlock();
+    return false;
+  }
+
+  const PoseKey key(armature, action, frame);
+  std::map<PoseKey, Pose>::iterator it = m_poses.find(key);
+  if (it != m_poses.end()) {
+    Pose &pose = it->second;
+    pose.m_lastUse = m_frame;
+    WritePose(binding, pose.m_values, channels);
+    m_mutex.Unlock();
+    return true;
+  }
+
+  m_mutex.Unlock();
+
+  /* Evaluate without lock, the bindings are only freed outside of the animations update or at
+   * the first use of the action in a frame. */
+  std::vector<float> values(binding.m_targets.size());
+  for (unsigned int i = 0, size = values.size(); i < size; ++i) {
+    values[i] = evaluate_fcurve(binding.m_targets[i].m_fcurve, frame);
+  }
+  WritePose(binding, values, channels);
+
+  m_mutex.Lock();
+  // The same pose could have been evaluated in parallel, keep the first one.
+  Pose &pose = m_poses[key];
+  if (pose.m_values.empty()) {
+    pose.m_values = std::move(values);
+  }
+  pose.m_lastUse = m_frame;
+  m_mutex.Unlock();
+
+  return true;
+}
+
+unsigned int BL_ActionPoseCache::GetMaxPoses() const
+{
+  return m_maxPoses;
+}
+
+void BL_ActionPoseCache::SetMaxPoses(unsigned int maxPoses)
+{
+  m_maxPoses = maxPoses;
+}
+
+float BL_ActionPoseCache::GetFrameStep() const
+{
+  return m_frameStep;
+}
+
+void BL_ActionPoseCache::SetFrameStep(float step)
+{
+  m_frameStep = std::fmax(step, 0.0f);
+}
+
+void BL_ActionPoseCache::EndFrame()
+{
+  const unsigned int frame = m_frame++;
+
+  if (m_poses.size() <= m_maxPoses) {
+    return;
+  }
+
+  for (std::map<PoseKey, Pose>::iterator it = m_poses.begin(); it != m_poses.end();) {
+    if (it->second.m_lastUse != frame) {
+      it = m_poses.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  // Even the poses of the last frame are over the limit.
+  while (m_poses.size() > m_maxPoses) {
+    m_poses.erase(m_poses.begin());
+  }
+}
+
+void BL_ActionPoseCache::Clear()
+{
+  m_poses.clear();
+  m_bindings.clear();
+  m_actions.clear();
+}
@@ -0,0 +1,132 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionPoseCache.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __BL_ACTIONPOSECACHE_H__
+#define __BL_ACTIONPOSECACHE_H__
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "CM_Thread.h"
+
+struct bAction;
+struct bArmature;
+struct bPoseChannel;
+struct FCurve;
+
+/** Share the pose channels evaluated from an action between the armatures using the same
+ * armature data and playing the same action at the same frame, e.g a crowd of replicas.
+ * The frame can be quantized to share more poses. The action is evaluated before any blending,
+ * the blending of each armature is applied on the shared pose.
+ * The F-Curves of an action are checked once per frame, the bindings and poses of an action
+ * edited e.g from Python are freed.
+ */
+class BL_ActionPoseCache {
+ public:
+  BL_ActionPoseCache();
+  ~BL_ActionPoseCache();
+
+  /** Set the channels animated by the action at a frame.
+   * \param channels The pose channels of the armature in the order of the pose.
+   * \return False if the cache is disabled or the action animates more than the pose channel
+   * transforms, the action must then be evaluated by the animation system.
+   */
+  bool SetPose(bArmature *armature,
+               bAction *action,
+               float frame,
+               const std::vector<bPoseChannel *> &channels);
+
+  /// Maximum number of poses kept between two frames, 0 disables the cache.
+  unsigned int GetMaxPoses() const;
+  void SetMaxPoses(unsigned int maxPoses);
+  /// Step the frames are rounded to, 0 to share only the poses at the exact same frame.
+  float GetFrameStep() const;
+  void SetFrameStep(float step);
+
+  /** Release the poses over the limit, the poses not used during the frame first. Called after
+   * the animations update.
+   */
+  void EndFrame();
+  /// Free all the poses and bindings, called when actions or armatures can be freed.
+  void Clear();
+
+ private:
+  /// Pose channel member written by a F-Curve.
+  struct Target {
+    FCurve *m_fcurve;
+    unsigned int m_channel;
+    /// Offset in floats of the value in the pose channel.
+    unsigned int m_offset;
+  };
+
+  /// F-Curves of an action resolved to pose channel members of an armature.
+  struct Binding {
+    /// False if a F-Curve doesn't animate a pose channel transform.
+    bool m_valid;
+    unsigned int m_numChannels;
+    std::vector<Target> m_targets;
+  };
+
+  struct Pose {
+    std::vector<float> m_values;
+    unsigned int m_lastUse;
+  };
+
+  /// Checksum of the F-Curves of an action at its last check.
+  struct ActionState {
+    unsigned int m_checksum;
+    unsigned int m_lastCheck;
+  };
+
+  using BindingKey = std::pair<bArmature *, bAction *>;
+  using PoseKey = std::tuple<bArmature *, bAction *, float>;
+
+  /** Free the bindings and poses of an action if its F-Curves changed since the last check.
+   * The action is checked at its first use in a frame.
+   */
+  void CheckAction(bAction *action);
+  const Binding &GetBinding(bArmature *armature,
+                            bAction *action,
+                            const std::vector<bPoseChannel *> &channels);
+  static void WritePose(const Binding &binding,
+                        const std::vector<float> &values,
+                        const std::vector<bPoseChannel *> &channels);
+
+  std::map<bAction *, ActionState> m_actions;
+  std::map<BindingKey, Binding> m_bindings;
+  std::map<PoseKey, Pose> m_poses;
+  /// Protect the bindings and poses, the armatures are animated in parallel.
+  CM_ThreadMutex m_mutex;
+
+  unsigned int m_maxPoses;
+  float m_frameStep;
+  /// Counter of the updates to know the poses used in the last update.
+  unsigned int m_frame;
+};
+
+#endif  // __BL_ACTIONPOSECACHE_H__
@@ -32,59 +32,213 @@
 
 #include "KX_NetworkMessageManager.h"
 
+#include <algorithm>
 
-KX_NetworkMessageManager::KX_NetworkMessageManager() : m_currentList(0)
+#include "BLI_utildefines.h"
+
+/// Number of interned names over which the unused names are released.
+#define DEFAULT_MAX_NAMES 1024
+
+static bool message_less(const KX_NetworkMessageManager::Message &a,
+                         const KX_NetworkMessageManager::Message &b)
 {
+  return (a.to < b.to) || (a.to == b.to && a.subject < b.subject);
+}
+
+KX_NetworkMessageManager::KX_NetworkMessageManager()
+    : m_currentList(0), m_maxNames(DEFAULT_MAX_NAMES)
+{
+  // The empty name is always the identifier 0.
+  RegisterName("");
 }
 
 KX_NetworkMessageManager::~KX_NetworkMessageManager()
 {
-  ClearMessages();
 }
 
-void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message message)
+KX_NetworkMessageManager::NameId KX_NetworkMessageManager::GetNameId(const std::string &name)
 {
-  // Put the new message in map for the given receiver and subject.
-  m_messages[m_currentList][message.to][message.subject].push_back(message);
+  m_mutex.Lock();
+  const auto it = m_nameIds.find(name);
+  NameId id;
+  if (it != m_nameIds.end()) {
+    id = it->second;
+  }
+  else if (!m_freeNameIds.empty()) {
+    id = m_freeNameIds.back();
+    m_freeNameIds.pop_back();
+    m_names[id] = name;
+    m_nameIds.emplace(name, id);
+  }
+  else {
+    id = m_names.size();
+    m_names.push_back(name);
+    m_nameUsers.push_back(0);
+    m_nameIds.emplace(name, id);
+  }
+  m_mutex.Unlock();
+
+  return id;
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(
-    std::string to, std::string subject)
+KX_NetworkMessageManager::NameId KX_NetworkMessageManager::RegisterName(const std::string &name)
 {
-  std::vector<KX_NetworkMessageManager::Message> messages;
+  const NameId id = GetNameId(name);
 
-  // look at messages without receiver.
-  std::map<std::string, std::vector<Message>> &messagesNoReceiver =
-      m_messages[1 - m_currentList][""];
-  std::map<std::string, std::vector<Message>> &messagesReceiver =
-      m_messages[1 - m_currentList][to];
-  if (subject.empty()) {
-    // Add all message without receiver and subject.
-    for (const auto& pair : messagesNoReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+  m_mutex.Lock();
+  ++m_nameUsers[id];
+  m_mutex.Unlock();
+
+  return id;
+}
+
+KX_NetworkMessageManager::NameId KX_NetworkMessageManager::UnregisterName(
+    const std::string &name)
+{
+  m_mutex.Lock();
+  const NameId id = m_nameIds.at(name);
+  BLI_assert(m_nameUsers[id] > 0);
+  --m_nameUsers[id];
+  m_mutex.Unlock();
+
+  return id;
+}
+
+void KX_NetworkMessageManager::ReleaseUnusedNames()
+{
+  std::vector<bool> used(m_names.size(), false);
+  for (const Message &message : m_lists[1 - m_currentList].messages) {
+    used[message.to] = true;
+    used[message.subject] = true;
+  }
+
+  // The identifier 0 of the empty name is always registered.
+  for (NameId id = 1, size = m_names.size(); id < size; ++id) {
+    std::string &name = m_names[id];
+    if (used[id] || m_nameUsers[id] > 0 || name.empty()) {
+      continue;
     }
-    // Add all message with the given receiver and no subject.
-    for (const auto& pair : messagesReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+    m_nameIds.erase(name);
+    name.clear();
+    m_freeNameIds.push_back(id);
+  }
+
+  // Avoid releasing at each frame when most of the names are used.
+  m_maxNames = std::max<unsigned int>(DEFAULT_MAX_NAMES, m_nameIds.size() * 2);
+}
+
+const std::string &KX_NetworkMessageManager::GetName(NameId id)
+{
+  m_mutex.Lock();
+  const std::string &name = m_names[id];
+  m_mutex.Unlock();
+
+  return name;
+}
+
+void KX_NetworkMessageManager::AddMessage(const std::string &to,
+                                          SCA_IObject *from,
+                                          const std::string &subject,
+                                          const std::string &body)
+{
+  const NameId toId = GetNameId(to);
+  const NameId subjectId = GetNameId(subject);
+
+  m_mutex.Lock();
+  MessageList &list = m_lists[m_currentList];
+  // Put the body in the arena followed by its terminator.
+  const Message message = {
+      toId, subjectId, from, (unsigned int)list.bodies.size(), (unsigned int)body.size()};
+  list.bodies.append(body.c_str(), body.size() + 1);
+  list.messages.push_back(message);
+  m_mutex.Unlock();
+}
+
+KX_NetworkMessageManager::MessageSpan KX_NetworkMessageManager::FindMessages(NameId to) const
+{
+  const std::vector<Message> &messages = m_lists[1 - m_currentList].messages;
+  const Message key = {to, 0, nullptr, 0, 0};
+  const auto range = std::equal_range(
+      messages.begin(), messages.end(), key, [](const Message &a, const Message &b) {
+        return a.to < b.to;
+      });
+  return MessageSpan(messages.data() + (range.first - messages.begin()),
+                     messages.data() + (range.second - messages.begin()));
+}
+
+KX_NetworkMessageManager::MessageSpan KX_NetworkMessageManager::FindMessages(
+    NameId to, NameId subject) const
+{
+  const std::vector<Message> &messages = m_lists[1 - m_currentList].messages;
+  const Message key = {to, subject, nullptr, 0, 0};
+  const auto range = std::equal_range(messages.begin(), messages.end(), key, message_less);
+  return MessageSpan(messages.data() + (range.first - messages.begin()),
+                     messages.data() + (range.second - messages.begin()));
+}
+
+void KX_NetworkMessageManager::GetMessages(const std::string &to,
+                                           const std::string &subject,
+                                           MessageSpan spans[2])
+{
+  spans[0] = spans[1] = MessageSpan();
+
+  // Names never used by a message have no identifier and so no messages.
+  m_mutex.Lock();
+  const auto toIt = m_nameIds.find(to);
+  const auto subjectIt = m_nameIds.find(subject);
+  const bool toValid = (toIt != m_nameIds.end()) && (toIt->second != 0);
+  const bool subjectValid = (subjectIt != m_nameIds.end());
+  const NameId toId = toValid ? toIt->second : 0;
+  const NameId subjectId = subjectValid ? subjectIt->second : 0;
+  m_mutex.Unlock();
+
+  // The readable list is only modified in ClearMessages.
+  if (subject.empty()) {
+    // All messages without receiver and all messages with the given receiver.
+    spans[0] = FindMessages(0);
+    if (toValid) {
+      spans[1] = FindMessages(toId);
     }
   }
-  else {
-    std::vector<KX_NetworkMessageManager::Message> &messagesNoReceiverSubject =
-        messagesNoReceiver[subject];
-    messages.insert(
-        messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-    std::vector<KX_NetworkMessageManager::Message> &messagesReceiverSubject =
-        messagesReceiver[subject];
-    messages.insert(
-        messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
+  else if (subjectValid) {
+    spans[0] = FindMessages(0, subjectId);
+    if (toValid) {
+      spans[1] = FindMessages(toId, subjectId);
+    }
   }
+}
+
+const char *KX_NetworkMessageManager::GetBody(const Message &message) const
+{
+  return m_lists[1 - m_currentList].bodies.c_str() + message.bodyOffset;
+}
 
-  return messages;
+const std::vector<KX_NetworkMessageManager::NameId> &KX_NetworkMessageManager::GetSubjects() const
+{
+  return m_subjects;
 }
 
 void KX_NetworkMessageManager::ClearMessages()
 {
-  // Clear previous list.
-  m_messages[1 - m_currentList].clear();
+  // Clear previous list, keeping its memory for the next frame.
+  MessageList &previousList = m_lists[1 - m_currentList];
+  previousList.messages.clear();
+  previousList.bodies.clear();
+
   m_currentList = 1 - m_currentList;
+
+  // Sort the readable messages by receiver and subject, keeping the sending order.
+  MessageList &list = m_lists[1 - m_currentList];
+  std::stable_sort(list.messages.begin(), list.messages.end(), message_less);
+
+  if (m_nameIds.size() > m_maxNames) {
+    ReleaseUnusedNames();
+  }
+
+  m_subjects.clear();
+  for (const Message &message : list.messages) {
+    m_subjects.push_back(message.subject);
+  }
+  std::sort(m_subjects.begin(), m_subjects.end());
+  m_subjects.erase(std::unique(m_subjects.begin(), m_subjects.end()), m_subjects.end());
 }
@@ -35,52 +35,148 @@ conflicts with KX_NetworkMessageManager::SendMessage */
 #  undef SendMessage
 #endif
 
-#include <map>
+#include <deque>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "CM_Thread.h"
+
 class SCA_IObject;
 
 class KX_NetworkMessageManager {
  public:
+  /// Identifier of an interned receiver or subject name, 0 is the empty name.
+  typedef unsigned int NameId;
+
   struct Message {
     /// Receiver object(s) name.
-    std::string to;
+    NameId to;
+    /// Message subject, used as filter.
+    NameId subject;
     /// Sender game object.
     SCA_IObject *from;
-    /// Message subject, used as filter.
-    std::string subject;
-    /// Message body.
-    std::string body;
+    /// Message body, stored in the body arena of the frame, see GetBody.
+    unsigned int bodyOffset;
+    unsigned int bodySize;
+  };
+
+  /// Contiguous messages of the readable list.
+  class MessageSpan {
+   private:
+    const Message *m_begin;
+    const Message *m_end;
+
+   public:
+    MessageSpan() : m_begin(nullptr), m_end(nullptr)
+    {
+    }
+    MessageSpan(const Message *begin, const Message *end) : m_begin(begin), m_end(end)
+    {
+    }
+
+    const Message *begin() const
+    {
+      return m_begin;
+    }
+    const Message *end() const
+    {
+      return m_end;
+    }
+    unsigned int size() const
+    {
+      return m_end - m_begin;
+    }
+    bool empty() const
+    {
+      return m_begin == m_end;
+    }
   };
 
  private:
-  /** List of all messages, filtered by receiver object(s) name and subject name.
-   * We use two lists, one handle sended message in the current frame and the other
-   * is used for handle message sended in the last frame for sensors.
+  /// The messages and their bodies sent in one frame.
+  struct MessageList {
+    std::vector<Message> messages;
+    /// Frame arena of the null terminated message bodies, cleared without freeing the memory.
+    std::string bodies;
+  };
+
+  /** We use two lists, one handle sended message in the current frame and the other
+   * is used for handle message sended in the last frame for sensors. The list of the
+   * last frame is sorted by receiver and subject.
    */
-  std::map<std::string, std::map<std::string, std::vector<Message>>> m_messages[2];
+  MessageList m_lists[2];
 
   /** Since we use two list for the current and last frame we have to switch of
    * current message list each frame. This value is only 0 or 1.
    */
   unsigned short m_currentList;
 
+  /// Identifiers of the interned names.
+  std::unordered_map<std::string, NameId> m_nameIds;
+  /// Names of the identifiers, a deque never moves its elements. Released names are empty.
+  std::deque<std::string> m_names;
+  /// Number of registrations of each identifier, see RegisterName.
+  std::vector<unsigned int> m_nameUsers;
+  /// Identifiers of the released names, reused by the new names.
+  std::vector<NameId> m_freeNameIds;
+  /// Number of interned names over which the unused names are released.
+  unsigned int m_maxNames;
+
+  /// Subjects of the readable messages, without duplicates.
+  std::vector<NameId> m_subjects;
+
+  /// Messages can be sent and read from isolated scenes updated in parallel.
+  CM_ThreadMutex m_mutex;
+
+  /** Return the identifier of a name, the name is interned if needed.
+   * The identifier is kept while a readable message or a registration uses it.
+   */
+  NameId GetNameId(const std::string &name);
+  /** Release the names not used by the readable messages or a registration, so that the names
+   * sent only once don't accumulate during the game.
+   */
+  void ReleaseUnusedNames();
+
+  /// Find the messages of the readable list for a receiver and any subject.
+  MessageSpan FindMessages(NameId to) const;
+  /// Find the messages of the readable list for a receiver and a subject.
+  MessageSpan FindMessages(NameId to, NameId subject) const;
+
  public:
   KX_NetworkMessageManager();
   virtual ~KX_NetworkMessageManager();
 
+  /// Return the identifier of a name and keep it until UnregisterName.
+  NameId RegisterName(const std::string &name);
+  /// Release a registration of a name, return its identifier.
+  NameId UnregisterName(const std::string &name);
+  /// Return the name of an identifier.
+  const std::string &GetName(NameId id);
+
   /** Add a message in the next message list.
-   * \param message The given message to add.
+   * \param to The object(s) name, empty for all the objects.
+   * \param from The sender game object.
+   * \param subject The message subject.
+   * \param body The message body, copied in the frame arena.
    */
-  void AddMessage(Message message);
-  /** Get all messages for a given receiver object name and message subject.
+  void AddMessage(const std::string &to,
+                  SCA_IObject *from,
+                  const std::string &subject,
+                  const std::string &body);
+  /** Get all messages for a given receiver object name and message subject without copying them,
+   * valid until the next call to ClearMessages.
    * \param to The object(s) name.
-   * \param subject The message subject/filter.
+   * \param subject The message subject/filter, empty for all the subjects.
+   * \param spans The messages sent to all the objects and the messages sent to the receiver.
    */
-  const std::vector<Message> GetMessages(std::string to, std::string subject);
+  void GetMessages(const std::string &to, const std::string &subject, MessageSpan spans[2]);
+  /// Get the null terminated body of a readable message.
+  const char *GetBody(const Message &message) const;
+  /// Get the subjects of all the messages readable in the current frame.
+  const std::vector<NameId> &GetSubjects() const;
 
-  /// Clear all messages
+  /// Swap the message lists, the messages of the last frame become readable.
   void ClearMessages();
 };
 
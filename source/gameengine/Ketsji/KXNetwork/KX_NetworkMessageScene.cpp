@@ -32,6 +32,10 @@
 
 #include "KX_NetworkMessageScene.h"
 
+#include <algorithm>
+
+#include "KX_NetworkMessageSensor.h"
+
 KX_NetworkMessageScene::KX_NetworkMessageScene(KX_NetworkMessageManager *messageManager)
     : m_messageManager(messageManager)
 {
@@ -46,18 +50,58 @@ void KX_NetworkMessageScene::SendMessage(std::string to,
                                          std::string subject,
                                          std::string body)
 {
-  KX_NetworkMessageManager::Message message;
-  message.to = to;
-  message.from = from;
-  message.subject = subject;
-  message.body = body;
+  m_messageManager->AddMessage(to, from, subject, body);
+}
+
+void KX_NetworkMessageScene::FindMessages(const std::string &to,
+                                          const std::string &subject,
+                                          KX_NetworkMessageManager::MessageSpan spans[2])
+{
+  m_messageManager->GetMessages(to, subject, spans);
+}
 
-  // Put the new message in map for the given receiver and subject.
-  m_messageManager->AddMessage(message);
+KX_NetworkMessageManager *KX_NetworkMessageScene::GetMessageManager() const
+{
+  return m_messageManager;
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageScene::FindMessages(
-    std::string to, std::string subject)
+void KX_NetworkMessageScene::RegisterSensor(KX_NetworkMessageSensor *sensor,
+                                            const std::string &subject)
 {
-  return m_messageManager->GetMessages(to, subject);
+  m_sensors[m_messageManager->RegisterName(subject)].push_back(sensor);
+}
+
+void KX_NetworkMessageScene::UnregisterSensor(KX_NetworkMessageSensor *sensor,
+                                              const std::string &subject)
+{
+  const KX_NetworkMessageManager::NameId id = m_messageManager->UnregisterName(subject);
+  std::vector<KX_NetworkMessageSensor *> &sensors = m_sensors[id];
+  sensors.erase(std::find(sensors.begin(), sensors.end(), sensor));
+  // The identifier can be reused by an other name once released.
+  if (sensors.empty() && id != 0) {
+    m_sensors.erase(id);
+  }
+}
+
+void KX_NetworkMessageScene::WakeSensors()
+{
+  const std::vector<KX_NetworkMessageManager::NameId> &subjects =
+      m_messageManager->GetSubjects();
+  if (subjects.empty()) {
+    return;
+  }
+
+  // The sensors without subject filter read all the messages.
+  for (KX_NetworkMessageSensor *sensor : m_sensors[0]) {
+    sensor->WakeUp();
+  }
+
+  for (KX_NetworkMessageManager::NameId subject : subjects) {
+    const auto it = m_sensors.find(subject);
+    if (it != m_sensors.end() && subject != 0) {
+      for (KX_NetworkMessageSensor *sensor : it->second) {
+        sensor->WakeUp();
+      }
+    }
+  }
 }
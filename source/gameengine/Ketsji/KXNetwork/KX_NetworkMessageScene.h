@@ -40,16 +40,21 @@ conflicts with KX_NetworkMessageScene::SendMessage */
 
 #include "KX_NetworkMessageManager.h"
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class SCA_IObject;
+class KX_NetworkMessageSensor;
 
 class KX_NetworkMessageScene {
  private:
   KX_NetworkMessageManager *m_messageManager;
 
+  /// Message sensors waiting for messages, filtered by subject.
+  std::unordered_map<KX_NetworkMessageManager::NameId, std::vector<KX_NetworkMessageSensor *>>
+      m_sensors;
+
  public:
   KX_NetworkMessageScene(KX_NetworkMessageManager *messageManager);
   virtual ~KX_NetworkMessageScene();
@@ -66,9 +71,20 @@ class KX_NetworkMessageScene {
   /** Get all messages for a given receiver object name and message subject.
    * \param to The object(s) name.
    * \param subject The message subject/filter.
+   * \param spans The messages without receiver and the messages to the receiver.
+   */
+  void FindMessages(const std::string &to,
+                    const std::string &subject,
+                    KX_NetworkMessageManager::MessageSpan spans[2]);
+  KX_NetworkMessageManager *GetMessageManager() const;
+
+  /** Register a sensor to wake up when a message is readable.
+   * \param subject The subject filter of the sensor, empty for all the messages.
    */
-  const std::vector<KX_NetworkMessageManager::Message> FindMessages(std::string to,
-                                                                    std::string subject);
+  void RegisterSensor(KX_NetworkMessageSensor *sensor, const std::string &subject);
+  void UnregisterSensor(KX_NetworkMessageSensor *sensor, const std::string &subject);
+  /// Wake up the sensors of the messages readable in the current frame.
+  void WakeSensors();
 };
 
 #endif  // __KX_NETWORKMESSAGESCENE_H__
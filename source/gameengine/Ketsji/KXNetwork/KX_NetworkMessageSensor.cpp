@@ -50,6 +50,7 @@ KX_NetworkMessageSensor::KX_NetworkMessageSensor(
       m_NetworkScene(NetworkScene),
       m_subject(subject),
       m_frame_message_count(0),
+      m_registered(false),
       m_BodyList(nullptr),
       m_SubjectList(nullptr)
 {
@@ -75,10 +76,53 @@ CValue *KX_NetworkMessageSensor::GetReplica()
     return nullptr;
   }
   replica->ProcessReplica();
+  static_cast<KX_NetworkMessageSensor *>(replica)->m_registered = false;
 
   return replica;
 }
 
+bool KX_NetworkMessageSensor::IsEventDriven()
+{
+  return true;
+}
+
+int KX_NetworkMessageSensor::GetActivationDelay()
+{
+  // The messages are read only during one frame, the sensor must go down the next frame.
+  if (m_IsUp && !m_suspended) {
+    return 1;
+  }
+  return SCA_ISensor::GetActivationDelay();
+}
+
+void KX_NetworkMessageSensor::RegisterToManager()
+{
+  if (!m_registered) {
+    m_registeredSubject = m_subject;
+    m_NetworkScene->RegisterSensor(this, m_registeredSubject);
+    m_registered = true;
+  }
+  SCA_ISensor::RegisterToManager();
+}
+
+void KX_NetworkMessageSensor::UnregisterToManager()
+{
+  if (m_registered) {
+    m_NetworkScene->UnregisterSensor(this, m_registeredSubject);
+    m_registered = false;
+  }
+  SCA_ISensor::UnregisterToManager();
+}
+
+void KX_NetworkMessageSensor::Replace_NetworkScene(KX_NetworkMessageScene *val)
+{
+  if (m_registered) {
+    m_NetworkScene->UnregisterSensor(this, m_registeredSubject);
+    val->RegisterSensor(this, m_registeredSubject);
+  }
+  m_NetworkScene = val;
+}
+
 /// Return true only for flank (UP and DOWN)
 bool KX_NetworkMessageSensor::Evaluate()
 {
@@ -100,12 +144,12 @@ bool KX_NetworkMessageSensor::Evaluate()
   std::string toname = GetParent()->GetName();
   std::string &subject = this->m_subject;
 
-  const std::vector<KX_NetworkMessageManager::Message> messages = m_NetworkScene->FindMessages(
-      toname, subject);
+  KX_NetworkMessageManager::MessageSpan spans[2];
+  m_NetworkScene->FindMessages(toname, subject, spans);
 
-  m_frame_message_count = messages.size();
+  m_frame_message_count = spans[0].size() + spans[1].size();
 
-  if (!messages.empty()) {
+  if (m_frame_message_count > 0) {
 #ifdef NAN_NET_DEBUG
     std::cout << "KX_NetworkMessageSensor found one or more messages" << std::endl;
 #endif
@@ -114,20 +158,20 @@ bool KX_NetworkMessageSensor::Evaluate()
     m_SubjectList = new CListValue<CStringValue>();
   }
 
-  std::vector<KX_NetworkMessageManager::Message>::const_iterator mesit;
-  for (mesit = messages.begin(); mesit != messages.end(); mesit++) {
-    // save the body
-    const std::string &body = (*mesit).body;
-    // save the subject
-    const std::string &messub = (*mesit).subject;
+  KX_NetworkMessageManager *manager = m_NetworkScene->GetMessageManager();
+  for (const KX_NetworkMessageManager::MessageSpan &span : spans) {
+    for (const KX_NetworkMessageManager::Message &message : span) {
+      // save the body
+      const std::string body(manager->GetBody(message), message.bodySize);
+      // save the subject
+      const std::string &messub = manager->GetName(message.subject);
 #ifdef NAN_NET_DEBUG
-    if (body) {
-      cout << "body [" << body << "]\n";
-    }
+      std::cout << "body [" << body << "]\n";
 #endif
-    m_BodyList->Add(new CStringValue(body, "body"));
-    // Store Subject
-    m_SubjectList->Add(new CStringValue(messub, "subject"));
+      m_BodyList->Add(new CStringValue(body, "body"));
+      // Store Subject
+      m_SubjectList->Add(new CStringValue(messub, "subject"));
+    }
   }
 
   result = (WasUp != m_IsUp);
@@ -200,7 +244,8 @@ PyMethodDef KX_NetworkMessageSensor::Methods[] = {
 };
 
 PyAttributeDef KX_NetworkMessageSensor::Attributes[] = {
-    KX_PYATTRIBUTE_STRING_RW("subject", 0, 100, false, KX_NetworkMessageSensor, m_subject),
+    KX_PYATTRIBUTE_STRING_RW_CHECK(
+        "subject", 0, 100, false, KX_NetworkMessageSensor, m_subject, pyattr_check_subject),
     KX_PYATTRIBUTE_INT_RO("frameMessageCount", KX_NetworkMessageSensor, m_frame_message_count),
     KX_PYATTRIBUTE_RO_FUNCTION("bodies", KX_NetworkMessageSensor, pyattr_get_bodies),
     KX_PYATTRIBUTE_RO_FUNCTION("subjects", KX_NetworkMessageSensor, pyattr_get_subjects),
@@ -231,4 +276,17 @@ PyObject *KX_NetworkMessageSensor::pyattr_get_subjects(PyObjectPlus *self_v,
   }
 }
 
+int KX_NetworkMessageSensor::pyattr_check_subject(PyObjectPlus *self_v,
+                                                  const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_NetworkMessageSensor *self = static_cast<KX_NetworkMessageSensor *>(self_v);
+  if (self->m_registered) {
+    self->m_NetworkScene->UnregisterSensor(self, self->m_registeredSubject);
+    self->m_registeredSubject = self->m_subject;
+    self->m_NetworkScene->RegisterSensor(self, self->m_registeredSubject);
+  }
+  self->WakeUp();
+  return 0;
+}
+
 #endif  // WITH_PYTHON
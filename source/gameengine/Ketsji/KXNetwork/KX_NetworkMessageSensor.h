@@ -50,6 +50,10 @@ class KX_NetworkMessageSensor : public SCA_ISensor {
 
   bool m_IsUp;
 
+  /// Subject the sensor is registered with in the network scene, see RegisterToManager.
+  std::string m_registeredSubject;
+  bool m_registered;
+
   CListValue<CStringValue> *m_BodyList;
   CListValue<CStringValue> *m_SubjectList;
 
@@ -66,10 +70,11 @@ class KX_NetworkMessageSensor : public SCA_ISensor {
   virtual void Init();
   void EndFrame();
 
-  virtual void Replace_NetworkScene(KX_NetworkMessageScene *val)
-  {
-    m_NetworkScene = val;
-  };
+  virtual bool IsEventDriven();
+  virtual int GetActivationDelay();
+  virtual void RegisterToManager();
+  virtual void UnregisterToManager();
+  virtual void Replace_NetworkScene(KX_NetworkMessageScene *val);
 
 #ifdef WITH_PYTHON
 
@@ -80,6 +85,7 @@ class KX_NetworkMessageSensor : public SCA_ISensor {
   /* attributes */
   static PyObject *pyattr_get_bodies(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_subjects(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_check_subject(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 
 #endif /* WITH_PYTHON */
 };
@@ -0,0 +1,89 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+#include <vector>
+
+#include "KX_NetworkMessageManager.h"
+
+#include "PIL_time.h"
+
+#define NUM_FRAMES 100
+#define NUM_SENDERS 512
+#define NUM_RECEIVERS 4096
+#define NUM_SUBJECTS 16
+
+/* Each frame every sender broadcasts a message and sends a message to one receiver, then every
+ * receiver reads the messages of its subject like a message sensor.
+ * If uniqueSubjects is true every message uses a new subject, the interned names must then be
+ * released over the frames. */
+static void network_message_throughput(const char *id, const bool uniqueSubjects)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  KX_NetworkMessageManager manager;
+
+  std::vector<std::string> receivers(NUM_RECEIVERS);
+  for (unsigned int i = 0; i < NUM_RECEIVERS; ++i) {
+    receivers[i] = "receiver" + std::to_string(i);
+  }
+
+  std::vector<std::string> subjects(NUM_SUBJECTS);
+  for (unsigned int i = 0; i < NUM_SUBJECTS; ++i) {
+    subjects[i] = "subject" + std::to_string(i);
+  }
+
+  const std::string body = "message body";
+  double sendTime = 0.0;
+  double readTime = 0.0;
+  unsigned int count = 0;
+
+  for (unsigned int frame = 0; frame < NUM_FRAMES; ++frame) {
+    if (uniqueSubjects) {
+      for (unsigned int i = 0; i < NUM_SUBJECTS; ++i) {
+        subjects[i] = "subject" + std::to_string(frame * NUM_SUBJECTS + i);
+      }
+    }
+
+    double time = PIL_check_seconds_timer();
+    for (unsigned int i = 0; i < NUM_SENDERS; ++i) {
+      const std::string &subject = subjects[i % NUM_SUBJECTS];
+      manager.AddMessage("", nullptr, subject, body);
+      manager.AddMessage(receivers[(i * 7 + frame) % NUM_RECEIVERS], nullptr, subject, body);
+    }
+    manager.ClearMessages();
+    sendTime += PIL_check_seconds_timer() - time;
+
+    time = PIL_check_seconds_timer();
+    KX_NetworkMessageManager::MessageSpan spans[2];
+    for (unsigned int i = 0; i < NUM_RECEIVERS; ++i) {
+      manager.GetMessages(receivers[i], subjects[i % NUM_SUBJECTS], spans);
+      for (const KX_NetworkMessageManager::MessageSpan &span : spans) {
+        for (const KX_NetworkMessageManager::Message &message : span) {
+          count += (manager.GetBody(message)[0] != '\0');
+        }
+      }
+    }
+    readTime += PIL_check_seconds_timer() - time;
+  }
+
+  printf("%d frames of %d messages sent in %f ms, read %d times in %f ms\n",
+         NUM_FRAMES,
+         NUM_SENDERS * 2,
+         sendTime * 1000.0,
+         count,
+         readTime * 1000.0);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(network_message, Throughput)
+{
+  network_message_throughput("NetworkMessage - Throughput", false);
+}
+
+TEST(network_message, ThroughputUniqueSubjects)
+{
+  network_message_throughput("NetworkMessage - Throughput Unique Subjects", true);
+}
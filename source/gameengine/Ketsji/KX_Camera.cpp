@@ -113,6 +113,15 @@ MT_Transform KX_Camera::GetWorldToCamera() const
   return camtrans;
 }
 
+MT_Transform KX_Camera::GetInterpolatedWorldToCamera(float factor) const
+{
+  MT_Transform camtrans;
+  camtrans.invert(MT_Transform(m_pSGNode->GetInterpolatedWorldPosition(factor),
+                               m_pSGNode->GetInterpolatedWorldOrientation(factor)));
+
+  return camtrans;
+}
+
 MT_Transform KX_Camera::GetCameraToWorld() const
 {
   return MT_Transform(NodeGetWorldPosition(), NodeGetWorldOrientation());
@@ -147,6 +147,8 @@ class KX_Camera : public KX_GameObject {
 
   MT_Transform GetWorldToCamera() const;
   MT_Transform GetCameraToWorld() const;
+  /// Same as GetWorldToCamera but using the interpolated transform of the scene graph node.
+  MT_Transform GetInterpolatedWorldToCamera(float factor) const;
 
   /** Sets the projection matrix that is used by the rasterizer. */
   void SetProjectionMatrix(const MT_Matrix4x4 &mat);
@@ -31,6 +31,8 @@
 
 #include "KX_CollisionEventManager.h"
 
+#include <algorithm>
+
 #include "KX_CollisionContactPoints.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
@@ -54,10 +56,8 @@ KX_CollisionEventManager::~KX_CollisionEventManager()
 
 void KX_CollisionEventManager::RemoveNewCollisions()
 {
-  for (const NewCollision& collision : m_newCollisions) {
-    delete collision.colldata;
-  }
   m_newCollisions.clear();
+  m_physEnv->ReleaseCollData();
 }
 
 bool KX_CollisionEventManager::NewHandleCollision(void *object1,
@@ -67,7 +67,7 @@ bool KX_CollisionEventManager::NewHandleCollision(void *object1,
   PHY_IPhysicsController *obj1 = static_cast<PHY_IPhysicsController *>(object1);
   PHY_IPhysicsController *obj2 = static_cast<PHY_IPhysicsController *>(object2);
 
-  m_newCollisions.insert(NewCollision(obj1, obj2, coll_data));
+  m_newCollisions.emplace_back(obj1, obj2, coll_data);
 
   return false;
 }
@@ -189,6 +189,9 @@ void KX_CollisionEventManager::NextFrame()
     static_cast<SCA_CollisionSensor *>(sensor)->SynchronizeTransform();
   }
 
+  // Sort the collisions to dispatch all the collisions of a controller in a row.
+  std::sort(m_newCollisions.begin(), m_newCollisions.end());
+
   for (const NewCollision& collision : m_newCollisions) {
     // Controllers
     PHY_IPhysicsController *ctrl1 = collision.first;
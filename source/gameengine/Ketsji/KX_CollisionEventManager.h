@@ -32,7 +32,6 @@
 #ifndef __KX_TOUCHEVENTMANAGER_H__
 #define __KX_TOUCHEVENTMANAGER_H__
 
-#include <set>
 #include <vector>
 
 #include "KX_GameObject.h"
@@ -53,12 +52,9 @@ class KX_CollisionEventManager : public SCA_EventManager {
     const PHY_CollData *colldata;
 
     /**
-     * Creates a copy of the given PHY_CollData; freeing that copy should be done by the owner of
-     * the NewCollision object.
-     *
-     * This allows us to efficiently store NewCollision objects in a std::set without creating more
-     * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't
-     * clone it again. */
+     * colldata is owned by the physics environment, it is given back to the environment
+     * once all the collisions of the frame are processed, see RemoveNewCollisions.
+     */
     NewCollision(PHY_IPhysicsController *first,
                  PHY_IPhysicsController *second,
                  const PHY_CollData *colldata);
@@ -68,7 +64,8 @@ class KX_CollisionEventManager : public SCA_EventManager {
 
   PHY_IPhysicsEnvironment *m_physEnv;
 
-  std::set<NewCollision> m_newCollisions;
+  /// Collisions of the frame, the vector capacity is kept between frames.
+  std::vector<NewCollision> m_newCollisions;
 
   static bool newCollisionResponse(void *client_data,
                                    void *object1,
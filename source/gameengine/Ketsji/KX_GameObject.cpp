@@ -53,6 +53,8 @@
 #include "BL_Action.h"
 #include "BL_ActionManager.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
+#include "CM_Thread.h"
 #include "KX_Camera.h"        // only for their ::Type
 #include "KX_ClientObjectInfo.h"
 #include "KX_CollisionContactPoints.h"
@@ -82,12 +84,18 @@ static MT_Vector3 dummy_scaling = MT_Vector3(1.0f, 1.0f, 1.0f);
 static MT_Matrix3x3 dummy_orientation = MT_Matrix3x3(
     1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
 
+/// Protect the shared Main database, isolated scenes can add objects in parallel.
+static CM_ThreadMutex blenderDataMutex;
+
 KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
     : SCA_IObject(),
       m_isReplica(false),           // eevee
+      m_replicaSourceObject(nullptr),  // eevee
       m_staticObject(true),         // eevee
       m_visibleAtGameStart(false),  // eevee
       m_forceIgnoreParentTx(false), // eevee
+      m_transformSyncEnabled(false),  // eevee
+      m_transformSyncPending(false),  // eevee
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
@@ -302,21 +310,30 @@ void KX_GameObject::SyncTransformWithDepsgraph()
 void KX_GameObject::ForceIgnoreParentTx()
 {
   m_forceIgnoreParentTx = true;
+  GetScene()->TagForTransformSync(this);
 }
 
 void KX_GameObject::TagForUpdate(bool is_overlay_pass)
 {
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  const float factor = engine->GetInterpolationFactor();
+
   float obmat[4][4];
-  NodeGetWorldTransform().getValue(&obmat[0][0]);
+  m_pSGNode->GetInterpolatedWorldTransform(factor).getValue(&obmat[0][0]);
   m_staticObject = compare_m4m4(m_prevObmat, obmat, FLT_MIN);
 
-  bContext *C = KX_GetActiveEngine()->GetContext();
+  /* Between two logic frames an interpolated object is kept in the synced objects until it
+   * reaches its current transform. */
+  if (m_staticObject && factor < 1.0f) {
+    float curmat[4][4];
+    NodeGetWorldTransform().getValue(&curmat[0][0]);
+    m_staticObject = compare_m4m4(curmat, obmat, FLT_MIN);
+  }
+
+  bContext *C = engine->GetContext();
   Main *bmain = CTX_data_main(C);
   Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
 
-  if (m_staticObject) {
-    GetScene()->AppendToStaticObjects(this);
-  }
   Object *ob_orig = GetBlenderObject();
 
   bool skip_transform = ob_orig->transflag & OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY;
@@ -384,24 +401,22 @@ void KX_GameObject::ReplicateBlenderObject()
   Object *ob = GetBlenderObject();
 
   if (ob) {
-    bContext *C = KX_GetActiveEngine()->GetContext();
-    Main *bmain = CTX_data_main(C);
-    Object *newob;
-    BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
-    Scene *scene = GetScene()->GetBlenderScene();
-    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
-    BKE_collection_object_add_from(bmain,
-                                   scene,
-                                   BKE_view_layer_camera_find(view_layer),
-                                   newob);  // add replica where is the active camera
-    newob->base_flag |= (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH);
-    newob->restrictflag &= ~OB_RESTRICT_VIEWPORT;
-    GetScene()->TagForCollectionRemap();
+    blenderDataMutex.Lock();
+    // Reuse a hidden copy from the scene pool when possible.
+    Object *newob = GetScene()->AcquireReplicaBlenderObject(ob);
 
     if (ob->parent) {
-      if (GetScene()->GetLastReplicatedParentObject()) {
-        newob->parent = GetScene()->GetLastReplicatedParentObject();
-        if (ob->parent && ob->parent->type == OB_ARMATURE) {
+      Object *parent = GetScene()->GetLastReplicatedParentObject();
+      if (parent) {
+        GetScene()->ResetLastReplicatedParentObject();
+      }
+      else {
+        parent = ob->parent;
+      }
+      // A pooled copy can still point to the parent of its previous use.
+      if (newob->parent != parent) {
+        newob->parent = parent;
+        if (ob->parent->type == OB_ARMATURE) {
           ModifierData *mod;
           for (mod = (ModifierData *)newob->modifiers.first; mod; mod = mod->next) {
             if (mod->type == eModifierType_Armature) {
@@ -409,7 +424,7 @@ void KX_GameObject::ReplicateBlenderObject()
             }
           }
         }
-        GetScene()->ResetLastReplicatedParentObject();
+        GetScene()->TagForRelationsUpdate();
       }
     }
 
@@ -418,10 +433,10 @@ void KX_GameObject::ReplicateBlenderObject()
     if (children.size() > 0) {
       GetScene()->SetLastReplicatedParentObject(newob);
     }
-
-    DEG_relations_tag_update(bmain);
+    blenderDataMutex.Unlock();
 
     m_pBlenderObject = newob;
+    m_replicaSourceObject = ob;
     m_isReplica = true;
   }
 }
@@ -429,13 +444,10 @@ void KX_GameObject::RemoveReplicaObject()
 {
   Object *ob = GetBlenderObject();
   if (ob && m_isReplica) {
-    bContext *C = KX_GetActiveEngine()->GetContext();
-    Main *bmain = CTX_data_main(C);
-    Scene *scene = GetScene()->GetBlenderScene();
-    BKE_scene_collections_object_remove(bmain, scene, ob, true);
-    BKE_id_free(bmain, &ob->id);
+    blenderDataMutex.Lock();
+    GetScene()->ReleaseReplicaBlenderObject(m_replicaSourceObject, ob);
+    blenderDataMutex.Unlock();
     SetBlenderObject(nullptr);
-    DEG_relations_tag_update(bmain);
   }
 }
 
@@ -444,6 +456,39 @@ bool KX_GameObject::IsStatic()
   return m_staticObject;
 }
 
+bool KX_GameObject::IsTransformSyncEnabled() const
+{
+  return m_transformSyncEnabled;
+}
+
+void KX_GameObject::SetTransformSyncEnabled(bool enabled)
+{
+  m_transformSyncEnabled = enabled;
+}
+
+bool KX_GameObject::IsTransformSyncPending() const
+{
+  return m_transformSyncPending;
+}
+
+void KX_GameObject::SetTransformSyncPending(bool pending)
+{
+  m_transformSyncPending = pending;
+}
+
+bool KX_GameObject::UseTransformSyncEveryFrame()
+{
+  Object *ob = GetBlenderObject();
+  if (!ob) {
+    return false;
+  }
+
+  /* The transform is read from the depsgraph or the evaluated transform can be overwritten by
+   * the depsgraph, both can't be detected from the scene graph. */
+  return (ob->transflag & OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY) ||
+         !OrigObCanBeTransformedInRealtime(ob);
+}
+
 void KX_GameObject::HideOriginalObject()
 {
   Object *ob = GetBlenderObject();
@@ -903,6 +948,8 @@ void KX_GameObject::ProcessReplica()
    * See KX_Scene::DupliGroupRecurse. */
   m_pDupliGroupObject = nullptr;
   m_pInstanceObjects = nullptr;
+  m_transformSyncEnabled = false;
+  m_transformSyncPending = false;
   m_pClient_info = new KX_ClientObjectInfo(*m_pClient_info);
   m_pClient_info->m_gameobject = this;
   m_actionManager = nullptr;
@@ -1157,6 +1204,8 @@ void KX_GameObject::UpdateTransform()
 void KX_GameObject::UpdateTransformFunc(SG_Node *node, void *gameobj, void *scene)
 {
   ((KX_GameObject *)gameobj)->UpdateTransform();
+  // The world transform changed, it must be synced to the depsgraph.
+  ((KX_Scene *)scene)->TagForTransformSync((KX_GameObject *)gameobj);
 }
 
 void KX_GameObject::SynchronizeTransform()
@@ -1841,6 +1890,7 @@ void KX_GameObject::UpdateComponents()
   }
 
   for (KX_PythonComponent *comp : m_components) {
+    CM_ProfileZone zone(comp->GetProfileName());
     comp->Update();
   }
 
@@ -2443,10 +2493,13 @@ static int Map_SetItem(PyObject *self_v, PyObject *key, PyObject *val)
       if (vallie) {
         CValue *oldprop = self->GetProperty(attr_str);
 
-        if (oldprop)
+        if (oldprop) {
           oldprop->SetValue(vallie);
-        else
+          self->NotifyPropertyChange(attr_str);
+        }
+        else {
           self->SetProperty(attr_str, vallie);
+        }
 
         vallie->Release();
         set = true;
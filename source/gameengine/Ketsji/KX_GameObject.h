@@ -92,10 +92,16 @@ class KX_GameObject : public SCA_IObject {
   float m_origObmat[4][4];
   float m_prevObmat[4][4];
   bool m_isReplica;
+  /// Blender object copied for this replica, used to give the copy back to its pool.
+  struct Object *m_replicaSourceObject;
   bool m_staticObject;
   bool m_useCopy;
   bool m_visibleAtGameStart;
   bool m_forceIgnoreParentTx;
+  /// True when the object is active in its scene and its transform is synced to the depsgraph.
+  bool m_transformSyncEnabled;
+  /// True when the object is in the transform sync list of its scene.
+  bool m_transformSyncPending;
   /* END OF EEVEE INTEGRATION */
 
   KX_ClientObjectInfo *m_pClient_info;
@@ -157,6 +163,12 @@ class KX_GameObject : public SCA_IObject {
   void ForceIgnoreParentTx();
   bool OrigObCanBeTransformedInRealtime(Object *ob);
   void SyncTransformWithDepsgraph();
+  bool IsTransformSyncEnabled() const;
+  void SetTransformSyncEnabled(bool enabled);
+  bool IsTransformSyncPending() const;
+  void SetTransformSyncPending(bool pending);
+  /// Return true if the transform can't be only synced when the scene graph node is updated.
+  bool UseTransformSyncEveryFrame();
   /* END OF EEVEE INTEGRATION */
 
   /**
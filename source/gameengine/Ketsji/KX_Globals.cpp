@@ -28,10 +28,15 @@
 
 #include "BLI_blenlib.h"
 
+#include "CM_Thread.h"
 #include "KX_KetsjiEngine.h"
 
 static KX_KetsjiEngine *g_engine = nullptr;
 static KX_Scene *g_scene = nullptr;
+/// Scene stepped by the current thread, used by isolated scenes updated in parallel.
+static thread_local KX_Scene *g_threadScene = nullptr;
+/// Debug draw lists are shared by all the scenes.
+static CM_ThreadMutex g_debugDrawMutex;
 static std::string g_mainPath = "";
 static std::string g_origPath = "";
 
@@ -45,6 +50,11 @@ void KX_SetActiveScene(KX_Scene *scene)
   g_scene = scene;
 }
 
+void KX_SetThreadActiveScene(KX_Scene *scene)
+{
+  g_threadScene = scene;
+}
+
 void KX_SetMainPath(const std::string &path)
 {
   char cpath[FILE_MAX];
@@ -68,7 +78,7 @@ KX_KetsjiEngine *KX_GetActiveEngine()
 
 KX_Scene *KX_GetActiveScene()
 {
-  return g_scene;
+  return (g_threadScene) ? g_threadScene : g_scene;
 }
 
 const std::string &KX_GetMainPath()
@@ -85,7 +95,9 @@ void KX_RasterizerDrawDebugLine(const MT_Vector3 &from,
                                 const MT_Vector3 &to,
                                 const MT_Vector4 &color)
 {
+  g_debugDrawMutex.Lock();
   g_engine->GetRasterizer()->GetDebugDraw().DrawLine(from, to, color);
+  g_debugDrawMutex.Unlock();
 }
 
 void KX_RasterizerDrawDebugCircle(const MT_Vector3 &center,
@@ -94,6 +106,8 @@ void KX_RasterizerDrawDebugCircle(const MT_Vector3 &center,
                                   const MT_Vector3 &normal,
                                   int nsector)
 {
+  g_debugDrawMutex.Lock();
   g_engine->GetRasterizer()->GetDebugDraw().DrawCircle(
       center, radius, color, normal, nsector);
+  g_debugDrawMutex.Unlock();
 }
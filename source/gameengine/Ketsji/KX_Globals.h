@@ -37,6 +37,10 @@ class KX_Scene;
 
 void KX_SetActiveEngine(KX_KetsjiEngine *engine);
 void KX_SetActiveScene(KX_Scene *scene);
+/** Override the active scene for the calling thread only, used when scenes
+ * are stepped in parallel. Pass nullptr to fall back to the global active scene.
+ */
+void KX_SetThreadActiveScene(KX_Scene *scene);
 void KX_SetMainPath(const std::string &path);
 void KX_SetOrigPath(const std::string &path);
 
@@ -42,6 +42,8 @@ class KX_ISystem {
   virtual ~KX_ISystem(){};
 
   virtual double GetTimeInSeconds() = 0;
+  /// Sleep the calling thread until the time returned by GetTimeInSeconds reaches time.
+  virtual void SleepUntil(double time) = 0;
 };
 
 #endif
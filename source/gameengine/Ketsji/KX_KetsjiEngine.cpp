@@ -36,8 +36,10 @@
 
 #include "KX_KetsjiEngine.h"
 
+#include <algorithm>
 #include <boost/format.hpp>
 
+#include "BLI_task.h"
 #include "DNA_scene_types.h"
 #include "DRW_render.h"
 #include "GPU_framebuffer.h"
@@ -46,6 +48,7 @@
 
 #include "BL_BlenderConverter.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "DEV_Joystick.h"  // for DEV_Joystick::HandleEvents
 #include "KX_Camera.h"
 #include "KX_Globals.h"
@@ -135,6 +138,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_maxLogicFrame(5),
       m_maxPhysicsFrame(5),
       m_ticrate(DEFAULT_LOGIC_TIC_RATE),
+      m_interpolationFactor(1.0f),
       m_anim_framerate(25.0),
       m_doRender(true),
       m_exitkey(130),
@@ -143,6 +147,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_cameraZoom(1.0f),
       m_overrideCamZoom(1.0f),
       m_logger(KX_TimeCategoryLogger(25)),
+      m_depsgraphZoneStart(0.0),
       m_average_framerate(0.0),
       m_showBoundingBox(KX_DebugOption::DISABLE),
       m_showArmature(KX_DebugOption::DISABLE),
@@ -158,6 +163,9 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
 #endif
 
   m_scenes = new CListValue<KX_Scene>();
+
+  m_scenePoolData.engine = this;
+  m_scenePool = BLI_task_pool_create(&m_scenePoolData, TASK_PRIORITY_HIGH);
 }
 
 /**
@@ -169,6 +177,8 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
   Py_CLEAR(m_pyprofiledict);
 #endif
 
+  BLI_task_pool_free(m_scenePool);
+
   m_scenes->Release();
 }
 
@@ -184,11 +194,13 @@ bContext *KX_KetsjiEngine::GetContext()
 void KX_KetsjiEngine::CountDepsgraphTime()
 {
   m_logger.StartLog(tc_depsgraph, m_kxsystem->GetTimeInSeconds());
+  m_depsgraphZoneStart = CM_Profiler::GetTime();
 }
 
 void KX_KetsjiEngine::EndCountDepsgraphTime()
 {
   m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
+  CM_Profiler::Record("Depsgraph", m_depsgraphZoneStart, CM_Profiler::GetTime());
 }
 /* End of EEVEE integration */
 
@@ -275,6 +287,22 @@ void KX_KetsjiEngine::EndFrame()
     PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
     Py_DECREF(val);
   }
+
+  // Collision datas allocated during the last physics tick, zero once the pools are warm.
+  unsigned int numCollDataAllocations = 0;
+  for (KX_Scene *scene : *m_scenes) {
+    numCollDataAllocations += scene->GetPhysicsEnvironment()->GetNumCollDataAllocations();
+  }
+  PyObject *allocations = PyLong_FromLong(numCollDataAllocations);
+  PyDict_SetItemString(m_pyprofiledict, "Collision Allocations:", allocations);
+  Py_DECREF(allocations);
+
+  PyObject *activeVoices = PyLong_FromLong(m_voiceManager.GetNumActiveVoices());
+  PyDict_SetItemString(m_pyprofiledict, "Active Voices:", activeVoices);
+  Py_DECREF(activeVoices);
+  PyObject *virtualVoices = PyLong_FromLong(m_voiceManager.GetNumVirtualVoices());
+  PyDict_SetItemString(m_pyprofiledict, "Virtual Voices:", virtualVoices);
+  Py_DECREF(virtualVoices);
 #endif
 
   m_average_framerate = 1.0 / tottime;
@@ -320,6 +348,22 @@ void KX_KetsjiEngine::EndFrameViewportRender()
     PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
     Py_DECREF(val);
   }
+
+  // Collision datas allocated during the last physics tick, zero once the pools are warm.
+  unsigned int numCollDataAllocations = 0;
+  for (KX_Scene *scene : *m_scenes) {
+    numCollDataAllocations += scene->GetPhysicsEnvironment()->GetNumCollDataAllocations();
+  }
+  PyObject *allocations = PyLong_FromLong(numCollDataAllocations);
+  PyDict_SetItemString(m_pyprofiledict, "Collision Allocations:", allocations);
+  Py_DECREF(allocations);
+
+  PyObject *activeVoices = PyLong_FromLong(m_voiceManager.GetNumActiveVoices());
+  PyDict_SetItemString(m_pyprofiledict, "Active Voices:", activeVoices);
+  Py_DECREF(activeVoices);
+  PyObject *virtualVoices = PyLong_FromLong(m_voiceManager.GetNumVirtualVoices());
+  PyDict_SetItemString(m_pyprofiledict, "Virtual Voices:", virtualVoices);
+  Py_DECREF(virtualVoices);
 #endif
 
   m_average_framerate = 1.0 / tottime;
@@ -343,6 +387,8 @@ void KX_KetsjiEngine::EndFrameViewportRender()
 
 bool KX_KetsjiEngine::NextFrame()
 {
+  CM_ProfileZone zone("NextFrame");
+
   m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
 
   /*
@@ -369,6 +415,11 @@ bool KX_KetsjiEngine::NextFrame()
    * max_logic_frame, we increase framestep.
    *
    * XXX render.fps is not considred anywhere.
+   *
+   * With USE_INTERPOLATION and a fixed framerate the framestep is never increased, the late
+   * logic frames are dropped like the physics frames. A render happens every call and shows
+   * the objects between their transforms of the last two logic frames, blended by the time
+   * remaining before the next logic frame.
    */
 
   double timestep = m_timescale / m_ticrate;
@@ -409,7 +460,15 @@ bool KX_KetsjiEngine::NextFrame()
 
   bool doRender = frames > 0;
 
-  if (frames > m_maxLogicFrame) {
+  const bool interpolate = (m_flags & USE_INTERPOLATION) && (m_flags & FIXED_FRAMERATE);
+  if (interpolate) {
+    if (frames > m_maxLogicFrame) {
+      m_frameTime += (frames - m_maxLogicFrame) * timestep;
+      frames = m_maxLogicFrame;
+    }
+    doRender = true;
+  }
+  else if (frames > m_maxLogicFrame) {
     framestep = (frames * timestep) / m_maxLogicFrame;
     frames = m_maxLogicFrame;
   }
@@ -418,6 +477,9 @@ bool KX_KetsjiEngine::NextFrame()
     m_frameTime += framestep;
 
     m_converter->MergeAsyncLoads();
+#ifdef WITH_PYTHON
+    m_saveGameManager.MergeAsyncJobs();
+#endif
 
     if (m_inputDevice) {
       m_inputDevice->ReleaseMoveEvent();
@@ -432,64 +494,50 @@ bool KX_KetsjiEngine::NextFrame()
     }
 #endif  // WITH_SDL
 
-    // for each scene, call the proceed functions
-    for (KX_Scene *scene : m_scenes) {
-      /* Suspension holds the physics and logic processing for an
-       * entire scene. Objects can be suspended individually, and
-       * the settings for that precede the logic and physics
-       * update. */
-      m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-
-      scene->UpdateObjectActivity();
+    const bool lastFrame = (i == frames - 1);
 
-      m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
-      // set Python hooks for each scene
-#ifdef WITH_PYTHON
-      PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
-#endif
-      KX_SetActiveScene(scene);
-
-      // Process sensors, and controllers
-      m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-      scene->LogicBeginFrame(m_frameTime, framestep);
+    // Only the transforms before the last logic frame are interpolated.
+    if (interpolate && lastFrame) {
+      for (KX_Scene *scene : m_scenes) {
+        scene->StorePreviousTransforms();
+      }
+    }
 
-      // Scenegraph needs to be updated again, because Logic Controllers
-      // can affect the local matrices.
-      m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-      scene->UpdateParents(m_frameTime);
+    // for each scene, call the proceed functions
+    for (KX_Scene *scene : m_scenes) {
+      if ((m_flags & PARALLEL_SCENES) && scene->IsIsolated()) {
+        m_isolatedScenes.push_back(scene);
+        continue;
+      }
 
-      // Process actuators
+      StepScene(scene, timestep, framestep, lastFrame, true);
+    }
 
-      // Do some cleanup work for this logic frame
+    /* Isolated scenes are stepped after the others to make sure that python scripts
+     * never run concurrently with them. Waiting the pool acts as a barrier before
+     * the messages and scenes management. */
+    if (!m_isolatedScenes.empty()) {
       m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
-      scene->LogicUpdateFrame(m_frameTime);
-
-      scene->LogicEndFrame();
 
-      // Actuators can affect the scenegraph
-      m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-      scene->UpdateParents(m_frameTime);
+      m_scenePoolData.timestep = timestep;
+      m_scenePoolData.framestep = framestep;
+      m_scenePoolData.lastFrame = lastFrame;
 
-      m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
-
-      // Perform physics calculations on the scene. This can involve
-      // many iterations of the physics solver.
-      scene->GetPhysicsEnvironment()->ProceedDeltaTime(
-          m_frameTime, timestep, framestep);  // m_deltatimerealDeltaTime);
-
-      /* No need to call sofbody update more than 1 time */
-      if (i == frames - 1) {
-        scene->GetPhysicsEnvironment()->UpdateSoftBodies();
+      for (KX_Scene *scene : m_isolatedScenes) {
+        BLI_task_pool_push(m_scenePool, StepSceneTask, scene, false, nullptr);
       }
+      BLI_task_pool_work_and_wait(m_scenePool);
 
-      m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
-      scene->UpdateParents(m_frameTime);
-
+      m_isolatedScenes.clear();
       m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
     }
 
     m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
     m_networkMessageManager->ClearMessages();
+    // The message sensors sleep until a message is readable.
+    for (KX_Scene *scene : m_scenes) {
+      scene->GetNetworkMessageScene()->WakeSensors();
+    }
 
     // update system devices
     m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
@@ -502,12 +550,119 @@ bool KX_KetsjiEngine::NextFrame()
 
   }
 
+  if (interpolate) {
+    const double factor = (m_clockTime - m_frameTime) / timestep;
+    m_interpolationFactor = std::min(std::max(float(factor), 0.0f), 1.0f);
+  }
+  else {
+    m_interpolationFactor = 1.0f;
+  }
+
+  {
+    CM_ProfileZone voiceZone("Voices");
+    // Choose the played sounds from the locations set by the logic.
+    m_voiceManager.Update(m_kxsystem->GetTimeInSeconds());
+  }
+
   // Start logging time spent outside main loop
   m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
 
+  if (m_flags & HEADLESS) {
+    // Nothing is rendered, drop the shapes drawn by the logic instead of accumulating them.
+    m_rasterizer->GetDebugDraw().Clear();
+    return false;
+  }
+
   return doRender && m_doRender;
 }
 
+void KX_KetsjiEngine::StepScene(
+    KX_Scene *scene, double timestep, double framestep, bool lastFrame, bool profile)
+{
+  CM_ProfileZone sceneZone(scene->GetProfileName());
+
+  const auto startLog = [this, profile](KX_TimeCategory category) {
+    if (profile) {
+      m_logger.StartLog(category, m_kxsystem->GetTimeInSeconds());
+    }
+  };
+
+  /* Suspension holds the physics and logic processing for an
+   * entire scene. Objects can be suspended individually, and
+   * the settings for that precede the logic and physics
+   * update. */
+  startLog(tc_logic);
+
+  scene->UpdateObjectActivity();
+
+  startLog(tc_physics);
+  // set Python hooks for each scene, isolated scenes don't run python.
+  if (profile) {
+#ifdef WITH_PYTHON
+    PHY_SetActiveEnvironment(scene->GetPhysicsEnvironment());
+#endif
+    KX_SetActiveScene(scene);
+  }
+
+  // Process sensors, and controllers
+  startLog(tc_logic);
+  {
+    CM_ProfileZone zone("Logic Begin");
+    scene->LogicBeginFrame(m_frameTime, framestep);
+  }
+
+  // Scenegraph needs to be updated again, because Logic Controllers
+  // can affect the local matrices.
+  startLog(tc_scenegraph);
+  scene->UpdateParents(m_frameTime);
+
+  // Process actuators
+
+  // Do some cleanup work for this logic frame
+  startLog(tc_logic);
+  {
+    CM_ProfileZone zone("Logic Update");
+    scene->LogicUpdateFrame(m_frameTime);
+
+    scene->LogicEndFrame();
+  }
+
+  // Actuators can affect the scenegraph
+  startLog(tc_scenegraph);
+  scene->UpdateParents(m_frameTime);
+
+  startLog(tc_physics);
+
+  // Perform physics calculations on the scene. This can involve
+  // many iterations of the physics solver.
+  {
+    CM_ProfileZone zone("Physics");
+    scene->GetPhysicsEnvironment()->ProceedDeltaTime(
+        m_frameTime, timestep, framestep);  // m_deltatimerealDeltaTime);
+
+    /* No need to call sofbody update more than 1 time */
+    if (lastFrame) {
+      scene->GetPhysicsEnvironment()->UpdateSoftBodies();
+    }
+  }
+
+  startLog(tc_scenegraph);
+  scene->UpdateParents(m_frameTime);
+
+  startLog(tc_services);
+}
+
+void KX_KetsjiEngine::StepSceneTask(TaskPool *__restrict pool, void *taskdata)
+{
+  KX_Scene *scene = (KX_Scene *)taskdata;
+  const ScenePoolData *data = (ScenePoolData *)BLI_task_pool_user_data(pool);
+
+  // Logic bricks looking for the active scene must find their own scene.
+  KX_SetThreadActiveScene(scene);
+  data->engine->StepScene(scene, data->timestep, data->framestep, data->lastFrame, false);
+  KX_SetThreadActiveScene(nullptr);
+}
+
 KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(
     KX_Scene *scene,
     KX_Camera *camera,
@@ -524,8 +679,10 @@ KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(
   if (usestereo) {
     rendercam = new KX_Camera(scene, scene->m_callbacks, *camera->GetCameraData(), true, true);
     rendercam->SetName("__stereo_" + camera->GetName() + "_" + std::to_string(eye) + "__");
-    rendercam->NodeSetGlobalOrientation(camera->NodeGetWorldOrientation());
-    rendercam->NodeSetWorldPosition(camera->NodeGetWorldPosition());
+    const SG_Node *node = camera->GetSGNode();
+    rendercam->NodeSetGlobalOrientation(
+        node->GetInterpolatedWorldOrientation(m_interpolationFactor));
+    rendercam->NodeSetWorldPosition(node->GetInterpolatedWorldPosition(m_interpolationFactor));
     rendercam->NodeSetWorldScale(camera->NodeGetWorldScaling());
     rendercam->NodeUpdateGS(0.0);
   }
@@ -549,7 +706,9 @@ KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(
 
   // Compute the camera matrices: modelview and projection.
   const MT_Matrix4x4 viewmat = m_rasterizer->GetViewMatrix(
-      eye, rendercam->GetWorldToCamera(), rendercam->GetCameraData()->m_perspective);
+      eye,
+      rendercam->GetInterpolatedWorldToCamera(m_interpolationFactor),
+      rendercam->GetCameraData()->m_perspective);
   const MT_Matrix4x4 projmat = GetCameraProjectionMatrix(scene, rendercam, eye, viewport, area);
   rendercam->SetModelviewMatrix(viewmat);
   rendercam->SetProjectionMatrix(projmat);
@@ -683,6 +842,8 @@ bool KX_KetsjiEngine::GetFrameRenderData(std::vector<FrameRenderData> &frameData
 
 void KX_KetsjiEngine::Render()
 {
+  CM_ProfileZone zone("Render");
+
   m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 
   BeginFrame();
@@ -1035,6 +1196,10 @@ void KX_KetsjiEngine::StopEngine()
 {
   if (m_bInitialized) {
     m_converter->FinalizeAsyncLoads();
+#ifdef WITH_PYTHON
+    // Finish writing the savegames.
+    m_saveGameManager.FinalizeAsyncJobs();
+#endif
 
     while (m_scenes->GetCount() > 0) {
       KX_Scene *scene = m_scenes->GetFront();
@@ -1044,7 +1209,9 @@ void KX_KetsjiEngine::StopEngine()
     }
 
     // cleanup all the stuff
-    m_rasterizer->Exit();
+    if (!(m_flags & HEADLESS)) {
+      m_rasterizer->Exit();
+    }
   }
 }
 
@@ -1245,7 +1412,9 @@ void KX_KetsjiEngine::RemoveScene(const std::string &scenename)
   return;
   /**************************************************/
   if (FindScene(scenename)) {
+    m_schedulingMutex.Lock();
     m_removingScenes.push_back(scenename);
+    m_schedulingMutex.Unlock();
   }
   else {
     CM_Warning("scene " << scenename << " does not exist, not removed!");
@@ -1303,7 +1472,9 @@ bool KX_KetsjiEngine::ReplaceScene(const std::string &oldscene, const std::strin
   // new scene in the lib => it won't work anymore, the lib
   // must be loaded before doing the replace.
   if (m_converter->GetBlenderSceneForName(newscene) != nullptr) {
+    m_schedulingMutex.Lock();
     m_replace_scenes.push_back(std::make_pair(oldscene, newscene));
+    m_schedulingMutex.Unlock();
     return true;
   }
 
@@ -1357,6 +1528,11 @@ void KX_KetsjiEngine::SetTicRate(double ticrate)
   m_ticrate = ticrate;
 }
 
+float KX_KetsjiEngine::GetInterpolationFactor() const
+{
+  return m_interpolationFactor;
+}
+
 double KX_KetsjiEngine::GetTimeScale() const
 {
   return m_timescale;
@@ -1427,6 +1603,23 @@ double KX_KetsjiEngine::GetRealTime(void) const
   return m_kxsystem->GetTimeInSeconds();
 }
 
+double KX_KetsjiEngine::GetNextFrameRealTime() const
+{
+  // The user advances the clock, there is no deadline to wait for.
+  if ((m_flags & USE_EXTERNAL_CLOCK) || m_timescale <= 0.0) {
+    return m_previousRealTime;
+  }
+
+  if (m_flags & FIXED_FRAMERATE) {
+    // Game time remaining before NextFrame proceeds a logic frame, converted to real time.
+    const double timestep = m_timescale / m_ticrate;
+    return m_previousRealTime + (m_frameTime + timestep - m_clockTime) / m_timescale;
+  }
+
+  // Without fixed framerate every call proceeds a frame, the tic rate caps the frequency.
+  return m_previousRealTime + 1.0 / m_ticrate;
+}
+
 void KX_KetsjiEngine::SetAnimFrameRate(double framerate)
 {
   m_anim_framerate = framerate;
@@ -36,14 +36,18 @@
 #include <string>
 #include <vector>
 
+#include "CM_Thread.h"
 #include "EXP_Python.h"
 #include "KX_ISystem.h"
+#include "KX_SaveGameManager.h"
 #include "KX_Scene.h"
 #include "KX_TimeCategoryLogger.h"
 #include "MT_Matrix4x4.h"
 #include "RAS_CameraData.h"
 #include "RAS_Rasterizer.h"
+#include "SCA_VoiceManager.h"
 
+struct TaskPool;
 struct TaskScheduler;
 class KX_ISystem;
 class BL_BlenderConverter;
@@ -92,7 +96,13 @@ class KX_KetsjiEngine {
     /// Automatic add debug properties to the debug list.
     AUTO_ADD_DEBUG_PROPERTIES = (1 << 6),
     /// Use override camera?
-    CAMERA_OVERRIDE = (1 << 7)
+    CAMERA_OVERRIDE = (1 << 7),
+    /// Step the logic and physics of isolated scenes in parallel?
+    PARALLEL_SCENES = (1 << 8),
+    /// Render the objects between the last two fixed logic frames?
+    USE_INTERPOLATION = (1 << 9),
+    /// Run only the logic and physics, without any window, GPU context or rendering.
+    HEADLESS = (1 << 10)
   };
 
  private:
@@ -120,6 +130,14 @@ class KX_KetsjiEngine {
     std::vector<CameraRenderData> m_cameraDataList;
   };
 
+  /// Shared data of the scene stepping tasks.
+  struct ScenePoolData {
+    KX_KetsjiEngine *engine;
+    double timestep;
+    double framestep;
+    bool lastFrame;
+  };
+
   /// Data used to render a frame.
   struct FrameRenderData {
     FrameRenderData(RAS_Rasterizer::FrameBufferType fbType);
@@ -137,8 +155,12 @@ class KX_KetsjiEngine {
   KX_ISystem *m_kxsystem;
   BL_BlenderConverter *m_converter;
   KX_NetworkMessageManager *m_networkMessageManager;
+  /// Choose the sounds played by the audio device.
+  SCA_VoiceManager m_voiceManager;
 #ifdef WITH_PYTHON
   PyObject *m_pyprofiledict;
+  /// Save and load bge.logic.globalDict.
+  KX_SaveGameManager m_saveGameManager;
 #endif
   SCA_IInputDevice *m_inputDevice;
 
@@ -150,6 +172,13 @@ class KX_KetsjiEngine {
   /// The current list of scenes.
   CListValue<KX_Scene> *m_scenes;
 
+  /// Isolated scenes stepped in parallel in the current logic frame.
+  std::vector<KX_Scene *> m_isolatedScenes;
+  ScenePoolData m_scenePoolData;
+  TaskPool *m_scenePool;
+  /// Protect the scheduled scenes lists, isolated scenes can request changes in parallel.
+  CM_ThreadMutex m_schedulingMutex;
+
   bool m_bInitialized;
 
   FlagType m_flags;
@@ -171,6 +200,8 @@ class KX_KetsjiEngine {
   /// maximum number of consecutive physics frame
   int m_maxPhysicsFrame;
   double m_ticrate;
+  /// Blend factor between the previous and current transforms of the last logic frame.
+  float m_interpolationFactor;
   /// for animation playback only - ipo and action
   double m_anim_framerate;
 
@@ -210,6 +241,8 @@ class KX_KetsjiEngine {
 
   /// Time logger.
   KX_TimeCategoryLogger m_logger;
+  /// Start time of the depsgraph zone of the trace profiler.
+  double m_depsgraphZoneStart;
 
   /// Labels for profiling display.
   static const std::string m_profileLabels[tc_numCategories];
@@ -270,6 +303,13 @@ class KX_KetsjiEngine {
 
   void BeginFrame();
 
+  /** Proceed logic, scene graph and physics of a scene for one logic frame.
+   * \param profile Log the time spent per category, only allowed from the main thread.
+   */
+  void StepScene(
+      KX_Scene *scene, double timestep, double framestep, bool lastFrame, bool profile);
+  static void StepSceneTask(TaskPool *__restrict pool, void *taskdata);
+
  public:
   KX_KetsjiEngine(KX_ISystem *system, struct bContext *C);
   virtual ~KX_KetsjiEngine();
@@ -295,6 +335,10 @@ class KX_KetsjiEngine {
   void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
 #ifdef WITH_PYTHON
   PyObject *GetPyProfileDict();
+  KX_SaveGameManager &GetSaveGameManager()
+  {
+    return m_saveGameManager;
+  }
 #endif
   void SetConverter(BL_BlenderConverter *converter);
   BL_BlenderConverter *GetConverter()
@@ -318,6 +362,10 @@ class KX_KetsjiEngine {
   {
     return m_networkMessageManager;
   }
+  SCA_VoiceManager &GetVoiceManager()
+  {
+    return m_voiceManager;
+  }
 
   /// returns true if an update happened to indicate -> Render
   bool NextFrame();
@@ -384,6 +432,12 @@ class KX_KetsjiEngine {
    */
   double GetRealTime(void) const;
 
+  /**
+   * Returns the real (system) time at which the next logic frame is due, used to sleep
+   * between the frames when nothing paces the engine, e.g. the headless player.
+   */
+  double GetNextFrameRealTime() const;
+
   /**
    * Gets the number of logic updates per second.
    */
@@ -392,6 +446,11 @@ class KX_KetsjiEngine {
    * Sets the number of logic updates per second.
    */
   void SetTicRate(double ticrate);
+  /**
+   * Gets the blend factor used to render the objects between the last two logic frames,
+   * 1 when the interpolation is disabled.
+   */
+  float GetInterpolationFactor() const;
   /**
    * Gets the maximum number of logic frame before render frame
    */
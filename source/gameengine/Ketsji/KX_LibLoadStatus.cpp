@@ -120,6 +120,19 @@ void *KX_LibLoadStatus::GetData()
   return m_data;
 }
 
+void KX_LibLoadStatus::AddError(const std::string &error)
+{
+  if (!m_error.empty()) {
+    m_error += "; ";
+  }
+  m_error += error;
+}
+
+const std::string &KX_LibLoadStatus::GetError() const
+{
+  return m_error;
+}
+
 void KX_LibLoadStatus::SetProgress(float progress)
 {
   m_progress = progress;
@@ -152,6 +165,7 @@ PyAttributeDef KX_LibLoadStatus::Attributes[] = {
     KX_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
     KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
     KX_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
+    KX_PYATTRIBUTE_STRING_RO("error", KX_LibLoadStatus, m_error),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
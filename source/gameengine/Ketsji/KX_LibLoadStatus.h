@@ -35,6 +35,8 @@ class KX_LibLoadStatus : public PyObjectPlus {
   class KX_Scene *m_mergescene;
   void *m_data;
   std::string m_libname;
+  /// Errors of the reading, linking and conversion, empty if none.
+  std::string m_error;
 
   float m_progress;
   double m_starttime;
@@ -70,6 +72,10 @@ class KX_LibLoadStatus : public PyObjectPlus {
     return m_finished;
   }
 
+  /// Add an error message, called from the loading task before the merge.
+  void AddError(const std::string &error);
+  const std::string &GetError() const;
+
   void SetProgress(float progress);
   float GetProgress();
   void AddProgress(float progress);
@@ -33,6 +33,12 @@
 
 #  include "KX_MeshProxy.h"
 
+#  include <map>
+#  include <set>
+#  include <vector>
+
+#  include "BLI_utildefines.h"
+
 #  include "EXP_ListWrapper.h"
 #  include "EXP_PyObjectPlus.h"
 #  include "KX_BlenderMaterial.h"
@@ -93,6 +99,14 @@ PyMethodDef KX_MeshProxy::Methods[] = {
     {"transform", (PyCFunction)KX_MeshProxy::sPyTransform, METH_VARARGS},
     {"transformUV", (PyCFunction)KX_MeshProxy::sPyTransformUV, METH_VARARGS},
     {"replaceMaterial", (PyCFunction)KX_MeshProxy::sPyReplaceMaterial, METH_VARARGS},
+    {"getPositions", (PyCFunction)KX_MeshProxy::sPyGetPositions, METH_VARARGS},
+    {"getNormals", (PyCFunction)KX_MeshProxy::sPyGetNormals, METH_VARARGS},
+    {"getUVs", (PyCFunction)KX_MeshProxy::sPyGetUVs, METH_VARARGS},
+    {"getColors", (PyCFunction)KX_MeshProxy::sPyGetColors, METH_VARARGS},
+    {"setPositions", (PyCFunction)KX_MeshProxy::sPySetPositions, METH_VARARGS},
+    {"setNormals", (PyCFunction)KX_MeshProxy::sPySetNormals, METH_VARARGS},
+    {"setUVs", (PyCFunction)KX_MeshProxy::sPySetUVs, METH_VARARGS},
+    {"setColors", (PyCFunction)KX_MeshProxy::sPySetColors, METH_VARARGS},
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -105,12 +119,57 @@ PyAttributeDef KX_MeshProxy::Attributes[] = {
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
+/// Display arrays exported to buffers.
+struct KX_ExportedArray {
+  unsigned int m_exports;
+  /// The mesh was freed, the array is deleted with its last export.
+  bool m_orphan;
+};
+
+static std::map<RAS_IDisplayArray *, KX_ExportedArray> exportedArrays;
+/// All the mesh proxies alive, to invalidate them when their mesh is freed.
+static std::set<KX_MeshProxy *> meshProxies;
+
 KX_MeshProxy::KX_MeshProxy(RAS_MeshObject *mesh) : CValue(), m_meshobj(mesh)
 {
+  meshProxies.insert(this);
 }
 
 KX_MeshProxy::~KX_MeshProxy()
 {
+  meshProxies.erase(this);
+}
+
+void KX_MeshProxy::InvalidateMesh(RAS_MeshObject *meshobj)
+{
+  // Copy the proxies as they are removed from the list when deleted.
+  const std::vector<KX_MeshProxy *> proxies(meshProxies.begin(), meshProxies.end());
+  for (KX_MeshProxy *proxy : proxies) {
+    if (proxy->m_meshobj != meshobj) {
+      continue;
+    }
+
+    proxy->m_meshobj = nullptr;
+    if (proxy->m_proxy && BGE_PROXY_PYOWNS(proxy->m_proxy)) {
+      // The python object stays alive but refers to nothing, delete the mesh proxy now.
+      BGE_PROXY_REF(proxy->m_proxy) = nullptr;
+      proxy->DestructFromPython();
+    }
+    else {
+      proxy->InvalidateProxy();
+    }
+  }
+
+  // Keep the display arrays still exported, they are deleted with their last export.
+  for (unsigned int i = 0, size = meshobj->NumMaterials(); i < size; ++i) {
+    RAS_MeshMaterial *meshmat = meshobj->GetMeshMaterial(i);
+    std::map<RAS_IDisplayArray *, KX_ExportedArray>::iterator it = exportedArrays.find(
+        meshmat->GetDisplayArray());
+    if (it != exportedArrays.end()) {
+      it->second.m_orphan = true;
+      meshmat->ReleaseDisplayArray();
+    }
+  }
 }
 
 // stuff for cvalue related things
@@ -380,6 +439,399 @@ PyObject *KX_MeshProxy::PyReplaceMaterial(PyObject *args, PyObject *kwds)
   Py_RETURN_NONE;
 }
 
+/// Vertex attributes accessible through buffers.
+enum KX_VertexAttribute {
+  KX_VERTEX_POSITION = 0,
+  KX_VERTEX_NORMAL,
+  KX_VERTEX_UV,
+  KX_VERTEX_COLOR
+};
+
+/// Layout of an attribute in the vertices of a display array.
+struct KX_VertexAttributeLayout {
+  RAS_IDisplayArray *m_array;
+  /// Attribute of the first vertex.
+  char *m_data;
+  /// Distance in bytes between two vertices.
+  Py_ssize_t m_stride;
+  Py_ssize_t m_count;
+  /// Number of components of the attribute.
+  Py_ssize_t m_columns;
+  Py_ssize_t m_itemsize;
+  const char *m_format;
+};
+
+static bool kx_mesh_proxy_get_layout(RAS_MeshObject *meshobj,
+                                     int matindex,
+                                     KX_VertexAttribute attrib,
+                                     int layer,
+                                     const char *error_prefix,
+                                     KX_VertexAttributeLayout &layout)
+{
+  RAS_MeshMaterial *mmat = (matindex >= 0) ? meshobj->GetMeshMaterial(matindex) : nullptr;
+  if (!mmat) {
+    PyErr_Format(PyExc_ValueError, "%s: invalid material index %d", error_prefix, matindex);
+    return false;
+  }
+
+  RAS_IDisplayArray *array = mmat->GetDisplayArray();
+  intptr_t offset;
+
+  switch (attrib) {
+    case KX_VERTEX_POSITION: {
+      offset = array->GetVertexXYZOffset();
+      layout.m_columns = 3;
+      break;
+    }
+    case KX_VERTEX_NORMAL: {
+      offset = array->GetVertexNormalOffset();
+      layout.m_columns = 3;
+      break;
+    }
+    case KX_VERTEX_UV: {
+      if (layer < 0 || layer >= array->GetVertexUvSize()) {
+        PyErr_Format(PyExc_ValueError, "%s: invalid uv layer %d", error_prefix, layer);
+        return false;
+      }
+      offset = array->GetVertexUVOffset() + layer * sizeof(float[2]);
+      layout.m_columns = 2;
+      break;
+    }
+    case KX_VERTEX_COLOR: {
+      if (layer < 0 || layer >= array->GetVertexColorSize()) {
+        PyErr_Format(PyExc_ValueError, "%s: invalid color layer %d", error_prefix, layer);
+        return false;
+      }
+      offset = array->GetVertexColorOffset() + layer * sizeof(unsigned int);
+      layout.m_columns = 4;
+      break;
+    }
+  }
+
+  // Colors are stored as 4 bytes, the other attributes as floats.
+  if (attrib == KX_VERTEX_COLOR) {
+    layout.m_itemsize = sizeof(unsigned char);
+    layout.m_format = "B";
+  }
+  else {
+    layout.m_itemsize = sizeof(float);
+    layout.m_format = "f";
+  }
+
+  layout.m_array = array;
+  layout.m_count = array->GetVertexCount();
+  layout.m_stride = array->GetVertexMemorySize();
+  layout.m_data = (layout.m_count > 0) ? (char *)array->GetVertexPointer() + offset : nullptr;
+
+  return true;
+}
+
+/** Exporter of a vertex attribute to memory views. It keeps a reference to the mesh proxy and
+ * resolves the display array on each export, so a buffer can't be exported from a freed mesh.
+ */
+struct KX_VertexAttributeBuffer {
+  PyObject_HEAD
+  /// The python proxy of the KX_MeshProxy.
+  PyObject *m_owner;
+  int m_matindex;
+  KX_VertexAttribute m_attrib;
+  int m_layer;
+};
+
+/// Shape and strides of an export, stored in Py_buffer::internal.
+struct KX_VertexAttributeExport {
+  RAS_IDisplayArray *m_array;
+  Py_ssize_t m_shape[2];
+  Py_ssize_t m_strides[2];
+};
+
+static void kx_vertex_attribute_buffer_dealloc(KX_VertexAttributeBuffer *self)
+{
+  Py_DECREF(self->m_owner);
+  PyObject_Del(self);
+}
+
+static int kx_vertex_attribute_buffer_getbuffer(KX_VertexAttributeBuffer *self,
+                                                Py_buffer *view,
+                                                int flags)
+{
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "vertex attribute buffers are read-only");
+    return -1;
+  }
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+    PyErr_SetString(PyExc_BufferError, "vertex attribute buffers are strided");
+    return -1;
+  }
+
+  KX_MeshProxy *proxy = static_cast<KX_MeshProxy *>(BGE_PROXY_REF(self->m_owner));
+  if (!proxy) {
+    PyErr_SetString(PyExc_BufferError, "the mesh of the vertex attribute buffer has been freed");
+    return -1;
+  }
+
+  KX_VertexAttributeLayout layout;
+  if (!kx_mesh_proxy_get_layout(proxy->GetMesh(),
+                                self->m_matindex,
+                                self->m_attrib,
+                                self->m_layer,
+                                "vertex attribute buffer",
+                                layout)) {
+    return -1;
+  }
+
+  // A memory view can't be created from a null pointer, even without items.
+  static char empty[sizeof(float[4])];
+
+  KX_VertexAttributeExport *info = (KX_VertexAttributeExport *)PyMem_Malloc(
+      sizeof(KX_VertexAttributeExport));
+  info->m_array = layout.m_array;
+  info->m_shape[0] = layout.m_count;
+  info->m_shape[1] = layout.m_columns;
+  info->m_strides[0] = layout.m_stride;
+  info->m_strides[1] = layout.m_itemsize;
+
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->buf = layout.m_data ? layout.m_data : empty;
+  view->len = layout.m_count * layout.m_columns * layout.m_itemsize;
+  view->readonly = 1;
+  view->itemsize = layout.m_itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)layout.m_format : nullptr;
+  view->ndim = 2;
+  view->shape = info->m_shape;
+  view->strides = info->m_strides;
+  view->suboffsets = nullptr;
+  view->internal = info;
+
+  ++exportedArrays[layout.m_array].m_exports;
+
+  return 0;
+}
+
+static void kx_vertex_attribute_buffer_releasebuffer(KX_VertexAttributeBuffer *UNUSED(self),
+                                                     Py_buffer *view)
+{
+  KX_VertexAttributeExport *info = (KX_VertexAttributeExport *)view->internal;
+
+  std::map<RAS_IDisplayArray *, KX_ExportedArray>::iterator it = exportedArrays.find(
+      info->m_array);
+  if (--it->second.m_exports == 0) {
+    if (it->second.m_orphan) {
+      delete it->first;
+    }
+    exportedArrays.erase(it);
+  }
+
+  PyMem_Free(info);
+}
+
+static PyBufferProcs kx_vertex_attribute_buffer_procs = {
+    (getbufferproc)kx_vertex_attribute_buffer_getbuffer,
+    (releasebufferproc)kx_vertex_attribute_buffer_releasebuffer};
+
+static PyTypeObject *kx_vertex_attribute_buffer_type()
+{
+  static PyTypeObject type = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+  if (!type.tp_name) {
+    type.tp_name = "KX_VertexAttributeBuffer";
+    type.tp_basicsize = sizeof(KX_VertexAttributeBuffer);
+    type.tp_dealloc = (destructor)kx_vertex_attribute_buffer_dealloc;
+    type.tp_as_buffer = &kx_vertex_attribute_buffer_procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+  }
+
+  // Nothing is done once the type is ready.
+  if (PyType_Ready(&type) < 0) {
+    return nullptr;
+  }
+
+  return &type;
+}
+
+/** Return a read-only memory view of shape (vertices, components) on the attribute, the view
+ * is strided by the vertex size and doesn't copy the vertices. The view keeps the mesh proxy
+ * alive, and the exported vertices stay allocated until the view is released even if the mesh
+ * is freed.
+ */
+static PyObject *kx_mesh_proxy_get_attribute(KX_MeshProxy *self,
+                                             PyObject *args,
+                                             KX_VertexAttribute attrib,
+                                             const char *format,
+                                             const char *error_prefix)
+{
+  int matindex;
+  int layer = 0;
+
+  if (!PyArg_ParseTuple(args, format, &matindex, &layer)) {
+    return nullptr;
+  }
+
+  KX_VertexAttributeLayout layout;
+  if (!kx_mesh_proxy_get_layout(
+          self->GetMesh(), matindex, attrib, layer, error_prefix, layout)) {
+    return nullptr;
+  }
+
+  PyTypeObject *type = kx_vertex_attribute_buffer_type();
+  if (!type) {
+    return nullptr;
+  }
+
+  KX_VertexAttributeBuffer *buffer = PyObject_New(KX_VertexAttributeBuffer, type);
+  buffer->m_owner = self->GetProxy();
+  buffer->m_matindex = matindex;
+  buffer->m_attrib = attrib;
+  buffer->m_layer = layer;
+
+  PyObject *memview = PyMemoryView_FromObject((PyObject *)buffer);
+  Py_DECREF(buffer);
+
+  return memview;
+}
+
+/** Copy a buffer of shape (vertices, components) or (vertices * components) into the attribute
+ * of all the vertices, and tag the display array once.
+ */
+static PyObject *kx_mesh_proxy_set_attribute(RAS_MeshObject *meshobj,
+                                             PyObject *args,
+                                             KX_VertexAttribute attrib,
+                                             const char *format,
+                                             const char *error_prefix)
+{
+  int matindex;
+  PyObject *value;
+  int layer = 0;
+
+  if (!PyArg_ParseTuple(args, format, &matindex, &value, &layer)) {
+    return nullptr;
+  }
+
+  KX_VertexAttributeLayout layout;
+  if (!kx_mesh_proxy_get_layout(meshobj, matindex, attrib, layer, error_prefix, layout)) {
+    return nullptr;
+  }
+
+  Py_buffer buffer;
+  if (PyObject_GetBuffer(value, &buffer, PyBUF_RECORDS_RO) == -1) {
+    return nullptr;
+  }
+
+  const char *bufformat = buffer.format ? buffer.format : "B";
+  if (ELEM(bufformat[0], '@', '=')) {
+    ++bufformat;
+  }
+
+  const Py_ssize_t columns = layout.m_columns;
+  if (strcmp(bufformat, layout.m_format) != 0 || buffer.itemsize != layout.m_itemsize) {
+    PyErr_Format(
+        PyExc_TypeError, "%s: expected a buffer of format '%s'", error_prefix, layout.m_format);
+    PyBuffer_Release(&buffer);
+    return nullptr;
+  }
+  if (!ELEM(buffer.ndim, 1, 2) || (buffer.ndim == 2 && buffer.shape[1] != columns) ||
+      (buffer.len / buffer.itemsize) != layout.m_count * columns) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: expected a buffer of %zd x %zd values",
+                 error_prefix,
+                 layout.m_count,
+                 columns);
+    PyBuffer_Release(&buffer);
+    return nullptr;
+  }
+
+  // Distance in bytes between two rows and two components of the buffer.
+  const Py_ssize_t colstride = buffer.strides[buffer.ndim - 1];
+  const Py_ssize_t rowstride = (buffer.ndim == 2) ? buffer.strides[0] : colstride * columns;
+  const Py_ssize_t itemsize = layout.m_itemsize;
+  const char *src = (const char *)buffer.buf;
+  char *dst = layout.m_data;
+
+  for (Py_ssize_t i = 0; i < layout.m_count; ++i, src += rowstride, dst += layout.m_stride) {
+    if (colstride == itemsize) {
+      memcpy(dst, src, itemsize * columns);
+    }
+    else {
+      for (Py_ssize_t j = 0; j < columns; ++j) {
+        memcpy(dst + j * itemsize, src + j * colstride, itemsize);
+      }
+    }
+  }
+
+  PyBuffer_Release(&buffer);
+
+  RAS_IDisplayArray *array = layout.m_array;
+  switch (attrib) {
+    case KX_VERTEX_POSITION: {
+      array->AppendModifiedFlag(RAS_IDisplayArray::POSITION_MODIFIED);
+      break;
+    }
+    case KX_VERTEX_NORMAL: {
+      array->AppendModifiedFlag(RAS_IDisplayArray::NORMAL_MODIFIED);
+      break;
+    }
+    case KX_VERTEX_UV: {
+      array->AppendModifiedFlag(RAS_IDisplayArray::UVS_MODIFIED);
+      break;
+    }
+    case KX_VERTEX_COLOR: {
+      array->AppendModifiedFlag(RAS_IDisplayArray::COLORS_MODIFIED);
+      break;
+    }
+  }
+
+  Py_RETURN_NONE;
+}
+
+PyObject *KX_MeshProxy::PyGetPositions(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_get_attribute(
+      this, args, KX_VERTEX_POSITION, "i:getPositions", "mesh.getPositions(...)");
+}
+
+PyObject *KX_MeshProxy::PyGetNormals(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_get_attribute(
+      this, args, KX_VERTEX_NORMAL, "i:getNormals", "mesh.getNormals(...)");
+}
+
+PyObject *KX_MeshProxy::PyGetUVs(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_get_attribute(
+      this, args, KX_VERTEX_UV, "i|i:getUVs", "mesh.getUVs(...)");
+}
+
+PyObject *KX_MeshProxy::PyGetColors(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_get_attribute(
+      this, args, KX_VERTEX_COLOR, "i|i:getColors", "mesh.getColors(...)");
+}
+
+PyObject *KX_MeshProxy::PySetPositions(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_set_attribute(
+      m_meshobj, args, KX_VERTEX_POSITION, "iO:setPositions", "mesh.setPositions(...)");
+}
+
+PyObject *KX_MeshProxy::PySetNormals(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_set_attribute(
+      m_meshobj, args, KX_VERTEX_NORMAL, "iO:setNormals", "mesh.setNormals(...)");
+}
+
+PyObject *KX_MeshProxy::PySetUVs(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_set_attribute(
+      m_meshobj, args, KX_VERTEX_UV, "iO|i:setUVs", "mesh.setUVs(...)");
+}
+
+PyObject *KX_MeshProxy::PySetColors(PyObject *args, PyObject *kwds)
+{
+  return kx_mesh_proxy_set_attribute(
+      m_meshobj, args, KX_VERTEX_COLOR, "iO|i:setColors", "mesh.setColors(...)");
+}
+
 PyObject *KX_MeshProxy::pyattr_get_materials(PyObjectPlus *self_v,
                                              const KX_PYATTRIBUTE_DEF *attrdef)
 {
@@ -60,6 +60,11 @@ class KX_MeshProxy : public CValue {
     return m_meshobj;
   }
 
+  /** Invalidate the proxies of a mesh about to be freed. The vertices exported to buffers are
+   * kept until the buffers are released.
+   */
+  static void InvalidateMesh(RAS_MeshObject *meshobj);
+
   // stuff for cvalue related things
   virtual std::string GetName();
 
@@ -78,6 +83,16 @@ class KX_MeshProxy : public CValue {
   KX_PYMETHOD(KX_MeshProxy, TransformUV);
   KX_PYMETHOD(KX_MeshProxy, ReplaceMaterial);
 
+  // Bulk vertex access through buffers, take materialid (int).
+  KX_PYMETHOD(KX_MeshProxy, GetPositions);
+  KX_PYMETHOD(KX_MeshProxy, GetNormals);
+  KX_PYMETHOD(KX_MeshProxy, GetUVs);
+  KX_PYMETHOD(KX_MeshProxy, GetColors);
+  KX_PYMETHOD(KX_MeshProxy, SetPositions);
+  KX_PYMETHOD(KX_MeshProxy, SetNormals);
+  KX_PYMETHOD(KX_MeshProxy, SetUVs);
+  KX_PYMETHOD(KX_MeshProxy, SetColors);
+
   static PyObject *pyattr_get_materials(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_numMaterials(PyObjectPlus *self_v,
                                            const KX_PYATTRIBUTE_DEF *attrdef);
@@ -28,6 +28,7 @@
 
 #include "KX_ObstacleSimulation.h"
 
+#include "BLI_task.h"
 
 #include "KX_Globals.h"
 #include "KX_NavMeshObject.h"
@@ -187,8 +188,167 @@ static float interpolateToi(float a, const float *dir, const float *toi, const i
   return 0;
 }
 
+static MT_Vector3 nearestPointToObstacle(MT_Vector3 &pos, KX_Obstacle *obstacle)
+{
+  switch (obstacle->m_shape) {
+    case KX_OBSTACLE_SEGMENT: {
+      MT_Vector3 ab = obstacle->m_pos2 - obstacle->m_pos;
+      if (!ab.fuzzyZero()) {
+        const MT_Scalar dist = ab.length();
+        MT_Vector3 abdir = ab.normalized();
+        MT_Vector3 v = pos - obstacle->m_pos;
+        MT_Scalar proj = abdir.dot(v);
+        CLAMP(proj, 0, dist);
+        MT_Vector3 res = obstacle->m_pos + abdir * proj;
+        return res;
+      }
+      ATTR_FALLTHROUGH;
+    }
+    case KX_OBSTACLE_CIRCLE:
+    default:
+      return obstacle->m_pos;
+  }
+}
+
+static bool filterObstacle(KX_Obstacle *activeObst,
+                           KX_NavMeshObject *activeNavMeshObj,
+                           KX_Obstacle *otherObst,
+                           float levelHeight)
+{
+  // filter obstacles by type
+  if ((otherObst == activeObst) ||
+      (otherObst->m_type == KX_OBSTACLE_NAV_MESH && otherObst->m_gameObj != activeNavMeshObj))
+    return false;
+
+  // filter obstacles by position
+  MT_Vector3 p = nearestPointToObstacle(activeObst->m_pos, otherObst);
+  if (fabsf(activeObst->m_pos.z() - p.z()) > levelHeight)
+    return false;
+
+  return true;
+}
+
+/// Maximum number of cells overlapped by an obstacle before it is considered as large.
+static const int GRID_MAX_OBSTACLE_CELLS = 256;
+
+KX_ObstacleGrid::KX_ObstacleGrid()
+    : m_cellSize(1.0f), m_mask(0), m_queryStamp(0), m_numObstacles(0)
+{
+}
+
+unsigned int KX_ObstacleGrid::CellHash(int x, int y) const
+{
+  return (((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u)) & m_mask;
+}
+
+void KX_ObstacleGrid::ComputeCellRange(const Bounds &bounds, CellRange &range) const
+{
+  // Clamp far coordinates to keep the cell coordinates representable.
+  static const float maxCoord = 1.0e8f;
+  for (unsigned short i = 0; i < 2; ++i) {
+    range.m_min[i] = (int)floorf(clamp(bounds.m_min[i] / m_cellSize, -maxCoord, maxCoord));
+    range.m_max[i] = (int)floorf(clamp(bounds.m_max[i] / m_cellSize, -maxCoord, maxCoord));
+  }
+}
+
+void KX_ObstacleGrid::Build(const std::vector<Bounds> &bounds, float cellSize)
+{
+  m_cellSize = cellSize;
+  m_numObstacles = bounds.size();
+  m_ranges.resize(m_numObstacles);
+  m_largeObstacles.clear();
+
+  // Compute the cells overlapped by each obstacle and count the entries.
+  unsigned int numentries = 0;
+  for (unsigned int i = 0; i < m_numObstacles; ++i) {
+    CellRange &range = m_ranges[i];
+    ComputeCellRange(bounds[i], range);
+    const float numcells = (float)(range.m_max[0] - range.m_min[0] + 1) *
+                           (float)(range.m_max[1] - range.m_min[1] + 1);
+    if (numcells > GRID_MAX_OBSTACLE_CELLS) {
+      m_largeObstacles.push_back(i);
+      // Empty the range, the obstacle is not stored in the cells.
+      range.m_max[0] = range.m_min[0] - 1;
+    }
+    else {
+      numentries += (unsigned int)numcells;
+    }
+  }
+
+  const unsigned int tablesize = power_of_2_max_u(max_ii(numentries * 2, 1));
+  m_mask = tablesize - 1;
+
+  /* Sort the entries by cell hash with a counting sort. m_cellStart first receives the end of
+   * each cell and is decremented to the cell start while inserting the entries. */
+  m_cellStart.assign(tablesize + 1, 0);
+  for (const CellRange &range : m_ranges) {
+    for (int y = range.m_min[1]; y <= range.m_max[1]; ++y) {
+      for (int x = range.m_min[0]; x <= range.m_max[0]; ++x) {
+        ++m_cellStart[CellHash(x, y)];
+      }
+    }
+  }
+  for (unsigned int i = 1; i <= tablesize; ++i) {
+    m_cellStart[i] += m_cellStart[i - 1];
+  }
+
+  m_entries.resize(numentries);
+  for (int i = m_numObstacles - 1; i >= 0; --i) {
+    const CellRange &range = m_ranges[i];
+    for (int y = range.m_min[1]; y <= range.m_max[1]; ++y) {
+      for (int x = range.m_min[0]; x <= range.m_max[0]; ++x) {
+        m_entries[--m_cellStart[CellHash(x, y)]] = i;
+      }
+    }
+  }
+
+  m_queryStamps.assign(m_numObstacles, 0);
+  m_queryStamp = 0;
+}
+
+void KX_ObstacleGrid::Query(const Bounds &bounds, std::vector<unsigned int> &indices)
+{
+  indices.clear();
+
+  CellRange range;
+  ComputeCellRange(bounds, range);
+  const float numcells = (float)(range.m_max[0] - range.m_min[0] + 1) *
+                         (float)(range.m_max[1] - range.m_min[1] + 1);
+  // Visiting more cells than the table size is slower than returning all the obstacles.
+  if (numcells > (float)(m_mask + 1)) {
+    for (unsigned int i = 0; i < m_numObstacles; ++i) {
+      indices.push_back(i);
+    }
+    return;
+  }
+
+  indices.insert(indices.end(), m_largeObstacles.begin(), m_largeObstacles.end());
+
+  if (++m_queryStamp == 0) {
+    std::fill(m_queryStamps.begin(), m_queryStamps.end(), 0);
+    m_queryStamp = 1;
+  }
+
+  for (int y = range.m_min[1]; y <= range.m_max[1]; ++y) {
+    for (int x = range.m_min[0]; x <= range.m_max[0]; ++x) {
+      const unsigned int hash = CellHash(x, y);
+      for (unsigned int i = m_cellStart[hash], end = m_cellStart[hash + 1]; i < end; ++i) {
+        const unsigned int index = m_entries[i];
+        if (m_queryStamps[index] != m_queryStamp) {
+          m_queryStamps[index] = m_queryStamp;
+          indices.push_back(index);
+        }
+      }
+    }
+  }
+}
+
 KX_ObstacleSimulation::KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization)
-    : m_levelHeight(levelHeight), m_enableVisualization(enableVisualization)
+    : m_levelHeight(levelHeight),
+      m_enableVisualization(enableVisualization),
+      m_gridDirty(true),
+      m_maxObstacleSpeed(0.0f),
+      m_maxQueryRadius(0.0f)
 {
 }
 
@@ -204,6 +364,9 @@ KX_Obstacle *KX_ObstacleSimulation::CreateObstacle(KX_GameObject *gameobj)
 {
   KX_Obstacle *obstacle = new KX_Obstacle();
   obstacle->m_gameObj = gameobj;
+  obstacle->m_pos = gameobj->NodeGetWorldPosition();
+  obstacle->m_pos2 = obstacle->m_pos;
+  obstacle->m_rad = 0.0f;
 
   vset(obstacle->vel, 0, 0);
   vset(obstacle->pvel, 0, 0);
@@ -214,6 +377,7 @@ KX_Obstacle *KX_ObstacleSimulation::CreateObstacle(KX_GameObject *gameobj)
   obstacle->hhead = 0;
 
   m_obstacles.push_back(obstacle);
+  m_gridDirty = true;
   return obstacle;
 }
 
@@ -259,6 +423,7 @@ void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject *gameobj)
       m_obstacles[i] = m_obstacles.back();
       m_obstacles.pop_back();
       delete obstacle;
+      m_gridDirty = true;
     }
     else
       i++;
@@ -285,6 +450,101 @@ void KX_ObstacleSimulation::UpdateObstacles()
       add_v2_v2v2(obs->pvel, obs->pvel, &obs->hvel[j * 2]);
     mul_v2_fl(obs->pvel, 1.0f / VEL_HIST_SIZE);
   }
+
+  BuildGrid();
+}
+
+void KX_ObstacleSimulation::BuildGrid()
+{
+  const unsigned int nobs = m_obstacles.size();
+  m_bounds.resize(nobs);
+
+  float maxRadius = 0.0f;
+  m_maxObstacleSpeed = 0.0f;
+  for (unsigned int i = 0; i < nobs; ++i) {
+    KX_Obstacle *obs = m_obstacles[i];
+    KX_ObstacleGrid::Bounds &bounds = m_bounds[i];
+
+    if (obs->m_shape == KX_OBSTACLE_SEGMENT) {
+      MT_Vector3 p1 = obs->m_pos;
+      MT_Vector3 p2 = obs->m_pos2;
+      if (obs->m_type == KX_OBSTACLE_NAV_MESH) {
+        KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(obs->m_gameObj);
+        p1 = navmeshobj->TransformToWorldCoords(p1);
+        p2 = navmeshobj->TransformToWorldCoords(p2);
+      }
+      for (unsigned short j = 0; j < 2; ++j) {
+        bounds.m_min[j] = std::min(p1[j], p2[j]) - obs->m_rad;
+        bounds.m_max[j] = std::max(p1[j], p2[j]) + obs->m_rad;
+      }
+    }
+    else {
+      for (unsigned short j = 0; j < 2; ++j) {
+        bounds.m_min[j] = obs->m_pos[j] - obs->m_rad;
+        bounds.m_max[j] = obs->m_pos[j] + obs->m_rad;
+      }
+      maxRadius = std::max(maxRadius, (float)obs->m_rad);
+      m_maxObstacleSpeed = std::max(m_maxObstacleSpeed, len_v2(obs->vel));
+    }
+  }
+
+  // Use the largest query radius of the previous frame to touch few cells per query.
+  const float cellSize = std::max(std::max(m_maxQueryRadius, maxRadius * 2.0f), 0.5f);
+  m_grid.Build(m_bounds, cellSize);
+
+  m_maxQueryRadius = 0.0f;
+  m_gridDirty = false;
+}
+
+void KX_ObstacleSimulation::FindNeighbors(KX_Obstacle *activeObst,
+                                          KX_NavMeshObject *activeNavMeshObj,
+                                          float radius,
+                                          KX_ObstacleNeighbors &neighbors)
+{
+  if (m_gridDirty) {
+    BuildGrid();
+  }
+
+  m_maxQueryRadius = std::max(m_maxQueryRadius, radius);
+
+  const MT_Vector3 &pos = activeObst->m_pos;
+  const KX_ObstacleGrid::Bounds bounds = {{(float)pos.x() - radius, (float)pos.y() - radius},
+                                          {(float)pos.x() + radius, (float)pos.y() + radius}};
+  m_grid.Query(bounds, m_queryIndices);
+
+  neighbors.clear();
+  for (unsigned int index : m_queryIndices) {
+    KX_Obstacle *obs = m_obstacles[index];
+    const KX_ObstacleGrid::Bounds &obsBounds = m_bounds[index];
+    // Reject the hash collisions.
+    if (obsBounds.m_min[0] > bounds.m_max[0] || obsBounds.m_max[0] < bounds.m_min[0] ||
+        obsBounds.m_min[1] > bounds.m_max[1] || obsBounds.m_max[1] < bounds.m_min[1]) {
+      continue;
+    }
+
+    if (!filterObstacle(activeObst, activeNavMeshObj, obs, m_levelHeight)) {
+      continue;
+    }
+
+    KX_ObstacleNeighbor neighbor;
+    neighbor.m_obstacle = obs;
+    if (obs->m_shape == KX_OBSTACLE_SEGMENT) {
+      MT_Vector3 p1 = obs->m_pos;
+      MT_Vector3 p2 = obs->m_pos2;
+      // apply world transform
+      if (obs->m_type == KX_OBSTACLE_NAV_MESH) {
+        KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(obs->m_gameObj);
+        p1 = navmeshobj->TransformToWorldCoords(p1);
+        p2 = navmeshobj->TransformToWorldCoords(p2);
+      }
+      neighbor.m_p1 = p1.to2d();
+      neighbor.m_p2 = p2.to2d();
+    }
+    else {
+      neighbor.m_p1 = neighbor.m_p2 = obs->m_pos.to2d();
+    }
+    neighbors.push_back(neighbor);
+  }
 }
 
 KX_Obstacle *KX_ObstacleSimulation::GetObstacle(KX_GameObject *gameobj)
@@ -332,46 +592,6 @@ void KX_ObstacleSimulation::DrawObstacles()
   }
 }
 
-static MT_Vector3 nearestPointToObstacle(MT_Vector3 &pos, KX_Obstacle *obstacle)
-{
-  switch (obstacle->m_shape) {
-    case KX_OBSTACLE_SEGMENT: {
-      MT_Vector3 ab = obstacle->m_pos2 - obstacle->m_pos;
-      if (!ab.fuzzyZero()) {
-        const MT_Scalar dist = ab.length();
-        MT_Vector3 abdir = ab.normalized();
-        MT_Vector3 v = pos - obstacle->m_pos;
-        MT_Scalar proj = abdir.dot(v);
-        CLAMP(proj, 0, dist);
-        MT_Vector3 res = obstacle->m_pos + abdir * proj;
-        return res;
-      }
-      ATTR_FALLTHROUGH;
-    }
-    case KX_OBSTACLE_CIRCLE:
-    default:
-      return obstacle->m_pos;
-  }
-}
-
-static bool filterObstacle(KX_Obstacle *activeObst,
-                           KX_NavMeshObject *activeNavMeshObj,
-                           KX_Obstacle *otherObst,
-                           float levelHeight)
-{
-  // filter obstacles by type
-  if ((otherObst == activeObst) ||
-      (otherObst->m_type == KX_OBSTACLE_NAV_MESH && otherObst->m_gameObj != activeNavMeshObj))
-    return false;
-
-  // filter obstacles by position
-  MT_Vector3 p = nearestPointToObstacle(activeObst->m_pos, otherObst);
-  if (fabsf(activeObst->m_pos.z() - p.z()) > levelHeight)
-    return false;
-
-  return true;
-}
-
 ///////////*********TOI_rays**********/////////////////
 KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool enableVisualization)
     : KX_ObstacleSimulation(levelHeight, enableVisualization),
@@ -399,8 +619,16 @@ void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle *activeObst,
 
   vset(activeObst->dvel, velocity.x(), velocity.y());
 
+  /* Only the obstacles reachable before the max TOI can change the samples. The sample
+   * velocities are bounded by twice the desired speed and relative velocities use twice the
+   * sample velocity. */
+  const float maxRelativeSpeed = 4.0f * len_v2(activeObst->dvel) + len_v2(activeObst->vel) +
+                                 m_maxObstacleSpeed;
+  const float radius = maxRelativeSpeed * m_maxToi + activeObst->m_rad;
+  FindNeighbors(activeObst, activeNavMeshObj, radius, m_neighbors);
+
   // apply RVO
-  sampleRVO(activeObst, activeNavMeshObj, maxDeltaAngle);
+  sampleRVO(activeObst, m_neighbors, maxDeltaAngle);
 
   // Fake dynamic constraint.
   float dv[2];
@@ -440,8 +668,110 @@ KX_ObstacleSimulationTOI_rays::KX_ObstacleSimulationTOI_rays(MT_Scalar levelHeig
   m_collisionWeight = 100.0f;
 }
 
+/// Minimum number of sample and obstacle tests to sample in parallel.
+static const unsigned int PARALLEL_SAMPLES_MIN_TESTS = 2048;
+
+struct TOIRaysSamples {
+  const KX_Obstacle *activeObst;
+  const KX_ObstacleNeighbors *neighbors;
+  MT_Vector2 vel;
+  float vmax;
+  float odir;
+  float aoff;
+  int maxSamples;
+  float minToi;
+  float maxToi;
+  float velWeight;
+  float toiWeight;
+  float collisionWeight;
+  TOICircle *tc;
+  float score[AVOID_MAX_STEPS];
+};
+
+static void toi_rays_sample_func(void *__restrict userdata,
+                                 const int iter,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TOIRaysSamples *samples = (TOIRaysSamples *)userdata;
+  const KX_Obstacle *activeObst = samples->activeObst;
+
+  // Calculate sample velocity
+  const float ndir = ((float)iter / (float)samples->maxSamples) - samples->aoff;
+  const float dir = samples->odir + ndir * (float)M_PI * 2.0f;
+  MT_Vector2 svel;
+  svel.x() = cosf(dir) * samples->vmax;
+  svel.y() = sinf(dir) * samples->vmax;
+
+  // Find min time of impact and exit amongst all obstacles.
+  float tmin = samples->maxToi;
+  float tmine = 0.0f;
+  for (const KX_ObstacleNeighbor &neighbor : *samples->neighbors) {
+    const KX_Obstacle *ob = neighbor.m_obstacle;
+    float htmin, htmax;
+
+    if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
+      MT_Vector2 vab;
+      if (len_v2(ob->vel) < 0.01f * 0.01f) {
+        // Stationary, use VO
+        vab = svel;
+      }
+      else {
+        // Moving, use RVO
+        vab = 2 * svel - samples->vel - MT_Vector2(ob->vel);
+      }
+
+      if (!sweepCircleCircle(activeObst->m_pos.to2d(),
+                             activeObst->m_rad,
+                             vab,
+                             neighbor.m_p1,
+                             ob->m_rad,
+                             htmin,
+                             htmax)) {
+        continue;
+      }
+    }
+    else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
+      if (!sweepCircleSegment(activeObst->m_pos.to2d(),
+                              activeObst->m_rad,
+                              svel,
+                              neighbor.m_p1,
+                              neighbor.m_p2,
+                              ob->m_rad,
+                              htmin,
+                              htmax)) {
+        continue;
+      }
+    }
+    else {
+      continue;
+    }
+
+    if (htmin > 0.0f) {
+      // The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
+      if (htmin < tmin)
+        tmin = htmin;
+    }
+    else if (htmax > 0.0f) {
+      // The agent overlaps the obstacle, keep track of first safe exit.
+      if (htmax > tmine)
+        tmine = htmax;
+    }
+  }
+
+  // Calculate sample penalties and final score.
+  const float apen = samples->velWeight * fabsf(ndir);
+  const float tpen = samples->toiWeight * (1.0f / (0.0001f + tmin / samples->maxToi));
+  const float cpen = samples->collisionWeight * (tmine / samples->minToi) *
+                     (tmine / samples->minToi);
+  samples->score[iter] = apen + tpen + cpen;
+
+  samples->tc->dir[iter] = dir;
+  samples->tc->toi[iter] = tmin;
+  samples->tc->toie[iter] = tmine;
+}
+
 void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
-                                              KX_NavMeshObject *activeNavMeshObj,
+                                              const KX_ObstacleNeighbors &neighbors,
                                               const float maxDeltaAngle)
 {
   MT_Vector2 vel(activeObst->dvel[0], activeObst->dvel[1]);
@@ -463,100 +793,33 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
   const int iforw = m_maxSamples / 2;
   const float aoff = (float)iforw / (float)m_maxSamples;
 
-  size_t nobs = m_obstacles.size();
+  TOIRaysSamples samples = {activeObst,
+                            &neighbors,
+                            vel,
+                            vmax,
+                            odir,
+                            aoff,
+                            m_maxSamples,
+                            m_minToi,
+                            m_maxToi,
+                            m_velWeight,
+                            m_toiWeight,
+                            m_collisionWeight,
+                            &tc,
+                            {}};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (m_maxSamples * neighbors.size() >= PARALLEL_SAMPLES_MIN_TESTS);
+  BLI_task_parallel_range(0, m_maxSamples, &samples, toi_rays_sample_func, &settings);
+
+  // Update best score, in sample order to not depend on threading.
   for (int iter = 0; iter < m_maxSamples; ++iter) {
-    // Calculate sample velocity
-    const float ndir = ((float)iter / (float)m_maxSamples) - aoff;
-    const float dir = odir + ndir * (float)M_PI * 2.0f;
-    MT_Vector2 svel;
-    svel.x() = cosf(dir) * vmax;
-    svel.y() = sinf(dir) * vmax;
-
-    // Find min time of impact and exit amongst all obstacles.
-    float tmin = m_maxToi;
-    float tmine = 0.0f;
-    for (int i = 0; i < nobs; ++i) {
-      KX_Obstacle *ob = m_obstacles[i];
-      bool res = filterObstacle(activeObst, activeNavMeshObj, ob, m_levelHeight);
-      if (!res)
-        continue;
-
-      float htmin, htmax;
-
-      if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
-        MT_Vector2 vab;
-        if (len_v2(ob->vel) < 0.01f * 0.01f) {
-          // Stationary, use VO
-          vab = svel;
-        }
-        else {
-          // Moving, use RVO
-          vab = 2 * svel - vel - MT_Vector2(ob->vel);
-        }
-
-        if (!sweepCircleCircle(activeObst->m_pos.to2d(),
-                               activeObst->m_rad,
-                               vab,
-                               ob->m_pos.to2d(),
-                               ob->m_rad,
-                               htmin,
-                               htmax)) {
-          continue;
-        }
-      }
-      else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
-        MT_Vector3 p1 = ob->m_pos;
-        MT_Vector3 p2 = ob->m_pos2;
-        // apply world transform
-        if (ob->m_type == KX_OBSTACLE_NAV_MESH) {
-          KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(ob->m_gameObj);
-          p1 = navmeshobj->TransformToWorldCoords(p1);
-          p2 = navmeshobj->TransformToWorldCoords(p2);
-        }
-
-        if (!sweepCircleSegment(activeObst->m_pos.to2d(),
-                                activeObst->m_rad,
-                                svel,
-                                p1.to2d(),
-                                p2.to2d(),
-                                ob->m_rad,
-                                htmin,
-                                htmax)) {
-          continue;
-        }
-      }
-      else {
-        continue;
-      }
-
-      if (htmin > 0.0f) {
-        // The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
-        if (htmin < tmin)
-          tmin = htmin;
-      }
-      else if (htmax > 0.0f) {
-        // The agent overlaps the obstacle, keep track of first safe exit.
-        if (htmax > tmine)
-          tmine = htmax;
-      }
+    if (samples.score[iter] < bestScore) {
+      bestDir = tc.dir[iter];
+      bestToi = tc.toi[iter];
+      bestScore = samples.score[iter];
     }
-
-    // Calculate sample penalties and final score.
-    const float apen = m_velWeight * fabsf(ndir);
-    const float tpen = m_toiWeight * (1.0f / (0.0001f + tmin / m_maxToi));
-    const float cpen = m_collisionWeight * (tmine / m_minToi) * (tmine / m_minToi);
-    const float score = apen + tpen + cpen;
-
-    // Update best score.
-    if (score < bestScore) {
-      bestDir = dir;
-      bestToi = tmin;
-      bestScore = score;
-    }
-
-    tc.dir[iter] = dir;
-    tc.toi[iter] = tmin;
-    tc.toie[iter] = tmine;
   }
 
   if (len_v2(activeObst->vel) > 0.1f) {
@@ -588,15 +851,160 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
 
 ///////////********* TOI_cells**********/////////////////
 
+/// Data shared by the penalty computation of all the samples of processSamples.
+struct TOICellsSamples {
+  const KX_Obstacle *activeObst;
+  const KX_ObstacleNeighbors *neighbors;
+  const float *spos;
+  float activeObstPos[2];
+  float ivmax;
+  float maxToi;
+  float velWeight;
+  float curVelWeight;
+  float sideWeight;
+  float toiWeight;
+  float *penalties;
+};
+
+static void toi_cells_sample_func(void *__restrict userdata,
+                                  const int n,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TOICellsSamples *samples = (TOICellsSamples *)userdata;
+  const KX_Obstacle *activeObst = samples->activeObst;
+
+  float vcand[2];
+  copy_v2_v2(vcand, &samples->spos[n * 2]);
+
+  // Find min time of impact and exit amongst all obstacles.
+  float tmin = samples->maxToi;
+  float side = 0;
+  int nside = 0;
+
+  for (const KX_ObstacleNeighbor &neighbor : *samples->neighbors) {
+    const KX_Obstacle *ob = neighbor.m_obstacle;
+    float htmin, htmax;
+
+    if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
+      float vab[2];
+
+      // Moving, use RVO
+      mul_v2_v2fl(vab, vcand, 2);
+      sub_v2_v2v2(vab, vab, activeObst->vel);
+      sub_v2_v2v2(vab, vab, ob->vel);
+
+      // Side
+      // NOTE: dp, and dv are constant over the whole calculation,
+      // they can be precomputed per object.
+      const float *pa = samples->activeObstPos;
+      float pb[2];
+      vset(pb, ob->m_pos.x(), ob->m_pos.y());
+
+      const float orig[2] = {0, 0};
+      float dp[2], dv[2], np[2];
+      sub_v2_v2v2(dp, pb, pa);
+      normalize_v2(dp);
+      sub_v2_v2v2(dv, ob->dvel, activeObst->dvel);
+
+      /* TODO: use line_point_side_v2 */
+      if (area_tri_signed_v2(orig, dp, dv) < 0.01f) {
+        np[0] = -dp[1];
+        np[1] = dp[0];
+      }
+      else {
+        np[0] = dp[1];
+        np[1] = -dp[0];
+      }
+
+      side += clamp(std::min(dot_v2v2(dp, vab), dot_v2v2(np, vab)) * 2.0f, 0.0f, 1.0f);
+      nside++;
+
+      if (!sweepCircleCircle(activeObst->m_pos.to2d(),
+                             activeObst->m_rad,
+                             MT_Vector2(vab),
+                             ob->m_pos.to2d(),
+                             ob->m_rad,
+                             htmin,
+                             htmax)) {
+        continue;
+      }
+
+      // Handle overlapping obstacles.
+      if (htmin < 0.0f && htmax > 0.0f) {
+        // Avoid more when overlapped.
+        htmin = -htmin * 0.5f;
+      }
+    }
+    else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
+      float p[2], q[2];
+      vset(p, neighbor.m_p1.x(), neighbor.m_p1.y());
+      vset(q, neighbor.m_p2.x(), neighbor.m_p2.y());
+
+      // NOTE: the segments are assumed to come from a navmesh which is shrunken by
+      // the agent radius, hence the use of really small radius.
+      // This can be handle more efficiently by using seg-seg test instead.
+      // If the whole segment is to be treated as obstacle, use agent->rad instead of 0.01f!
+      const float r = 0.01f;  // agent->rad
+      if (dist_squared_to_line_segment_v2(samples->activeObstPos, p, q) < sqr(r + ob->m_rad)) {
+        float sdir[2], snorm[2];
+        sub_v2_v2v2(sdir, q, p);
+        snorm[0] = sdir[1];
+        snorm[1] = -sdir[0];
+        // If the velocity is pointing towards the segment, no collision.
+        if (dot_v2v2(snorm, vcand) < 0.0f)
+          continue;
+        // Else immediate collision.
+        htmin = 0.0f;
+        htmax = 10.0f;
+      }
+      else {
+        if (!sweepCircleSegment(MT_Vector2(samples->activeObstPos),
+                                r,
+                                MT_Vector2(vcand),
+                                MT_Vector2(p),
+                                MT_Vector2(q),
+                                ob->m_rad,
+                                htmin,
+                                htmax))
+          continue;
+      }
+
+      // Avoid less when facing walls.
+      htmin *= 2.0f;
+    }
+    else {
+      continue;
+    }
+
+    if (htmin >= 0.0f) {
+      // The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
+      if (htmin < tmin)
+        tmin = htmin;
+    }
+  }
+
+  // Normalize side bias, to prevent it dominating too much.
+  if (nside)
+    side /= nside;
+
+  const float vpen = samples->velWeight * (len_v2v2(vcand, activeObst->dvel) * samples->ivmax);
+  const float vcpen = samples->curVelWeight * (len_v2v2(vcand, activeObst->vel) * samples->ivmax);
+  const float spen = samples->sideWeight * side;
+  const float tpen = samples->toiWeight * (1.0f / (0.1f + tmin / samples->maxToi));
+
+  const float penalty = vpen + vcpen + spen + tpen;
+
+  samples->penalties[n] = penalty;
+}
+
 static void processSamples(KX_Obstacle *activeObst,
-                           KX_NavMeshObject *activeNavMeshObj,
-                           KX_Obstacles &obstacles,
-                           float levelHeight,
+                           const KX_ObstacleNeighbors &neighbors,
                            const float vmax,
                            const float *spos,
                            const float cs,
                            const int nspos,
                            float *res,
+                           float *penalties,
                            float maxToi,
                            float velWeight,
                            float curVelWeight,
@@ -605,167 +1013,42 @@ static void processSamples(KX_Obstacle *activeObst,
 {
   vset(res, 0, 0);
 
-  const float ivmax = 1.0f / vmax;
-
-  float adir[2] /*, adist */;
-  if (normalize_v2_v2(adir, activeObst->pvel) <= 0.01f) {
-    zero_v2(adir);
-  }
-
-  float activeObstPos[2];
-  vset(activeObstPos, activeObst->m_pos.x(), activeObst->m_pos.y());
-  /* adist = vdot(adir, activeObstPos); */
-
+  TOICellsSamples samples = {activeObst,
+                             &neighbors,
+                             spos,
+                             {(float)activeObst->m_pos.x(), (float)activeObst->m_pos.y()},
+                             1.0f / vmax,
+                             maxToi,
+                             velWeight,
+                             curVelWeight,
+                             sideWeight,
+                             toiWeight,
+                             penalties};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (nspos * neighbors.size() >= PARALLEL_SAMPLES_MIN_TESTS);
+  BLI_task_parallel_range(0, nspos, &samples, toi_cells_sample_func, &settings);
+
+  // Select the sample with the minimum penalty, in sample order to not depend on threading.
   float minPenalty = FLT_MAX;
-
   for (int n = 0; n < nspos; ++n) {
-    float vcand[2];
-    copy_v2_v2(vcand, &spos[n * 2]);
-
-    // Find min time of impact and exit amongst all obstacles.
-    float tmin = maxToi;
-    float side = 0;
-    int nside = 0;
-
-    for (int i = 0; i < obstacles.size(); ++i) {
-      KX_Obstacle *ob = obstacles[i];
-      bool res = filterObstacle(activeObst, activeNavMeshObj, ob, levelHeight);
-      if (!res)
-        continue;
-      float htmin, htmax;
-
-      if (ob->m_shape == KX_OBSTACLE_CIRCLE) {
-        float vab[2];
-
-        // Moving, use RVO
-        mul_v2_v2fl(vab, vcand, 2);
-        sub_v2_v2v2(vab, vab, activeObst->vel);
-        sub_v2_v2v2(vab, vab, ob->vel);
-
-        // Side
-        // NOTE: dp, and dv are constant over the whole calculation,
-        // they can be precomputed per object.
-        const float *pa = activeObstPos;
-        float pb[2];
-        vset(pb, ob->m_pos.x(), ob->m_pos.y());
-
-        const float orig[2] = {0, 0};
-        float dp[2], dv[2], np[2];
-        sub_v2_v2v2(dp, pb, pa);
-        normalize_v2(dp);
-        sub_v2_v2v2(dv, ob->dvel, activeObst->dvel);
-
-        /* TODO: use line_point_side_v2 */
-        if (area_tri_signed_v2(orig, dp, dv) < 0.01f) {
-          np[0] = -dp[1];
-          np[1] = dp[0];
-        }
-        else {
-          np[0] = dp[1];
-          np[1] = -dp[0];
-        }
-
-        side += clamp(std::min(dot_v2v2(dp, vab), dot_v2v2(np, vab)) * 2.0f, 0.0f, 1.0f);
-        nside++;
-
-        if (!sweepCircleCircle(activeObst->m_pos.to2d(),
-                               activeObst->m_rad,
-                               MT_Vector2(vab),
-                               ob->m_pos.to2d(),
-                               ob->m_rad,
-                               htmin,
-                               htmax)) {
-          continue;
-        }
-
-        // Handle overlapping obstacles.
-        if (htmin < 0.0f && htmax > 0.0f) {
-          // Avoid more when overlapped.
-          htmin = -htmin * 0.5f;
-        }
-      }
-      else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
-        MT_Vector3 p1 = ob->m_pos;
-        MT_Vector3 p2 = ob->m_pos2;
-        // apply world transform
-        if (ob->m_type == KX_OBSTACLE_NAV_MESH) {
-          KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(ob->m_gameObj);
-          p1 = navmeshobj->TransformToWorldCoords(p1);
-          p2 = navmeshobj->TransformToWorldCoords(p2);
-        }
-        float p[2], q[2];
-        vset(p, p1.x(), p1.y());
-        vset(q, p2.x(), p2.y());
-
-        // NOTE: the segments are assumed to come from a navmesh which is shrunken by
-        // the agent radius, hence the use of really small radius.
-        // This can be handle more efficiently by using seg-seg test instead.
-        // If the whole segment is to be treated as obstacle, use agent->rad instead of 0.01f!
-        const float r = 0.01f;  // agent->rad
-        if (dist_squared_to_line_segment_v2(activeObstPos, p, q) < sqr(r + ob->m_rad)) {
-          float sdir[2], snorm[2];
-          sub_v2_v2v2(sdir, q, p);
-          snorm[0] = sdir[1];
-          snorm[1] = -sdir[0];
-          // If the velocity is pointing towards the segment, no collision.
-          if (dot_v2v2(snorm, vcand) < 0.0f)
-            continue;
-          // Else immediate collision.
-          htmin = 0.0f;
-          htmax = 10.0f;
-        }
-        else {
-          if (!sweepCircleSegment(MT_Vector2(activeObstPos),
-                                  r,
-                                  MT_Vector2(vcand),
-                                  MT_Vector2(p),
-                                  MT_Vector2(q),
-                                  ob->m_rad,
-                                  htmin,
-                                  htmax))
-            continue;
-        }
-
-        // Avoid less when facing walls.
-        htmin *= 2.0f;
-      }
-      else {
-        continue;
-      }
-
-      if (htmin >= 0.0f) {
-        // The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
-        if (htmin < tmin)
-          tmin = htmin;
-      }
-    }
-
-    // Normalize side bias, to prevent it dominating too much.
-    if (nside)
-      side /= nside;
-
-    const float vpen = velWeight * (len_v2v2(vcand, activeObst->dvel) * ivmax);
-    const float vcpen = curVelWeight * (len_v2v2(vcand, activeObst->vel) * ivmax);
-    const float spen = sideWeight * side;
-    const float tpen = toiWeight * (1.0f / (0.1f + tmin / maxToi));
-
-    const float penalty = vpen + vcpen + spen + tpen;
-
-    if (penalty < minPenalty) {
-      minPenalty = penalty;
-      copy_v2_v2(res, vcand);
+    if (penalties[n] < minPenalty) {
+      minPenalty = penalties[n];
+      copy_v2_v2(res, &spos[n * 2]);
     }
   }
 }
 
 void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
-                                               KX_NavMeshObject *activeNavMeshObj,
+                                               const KX_ObstacleNeighbors &neighbors,
                                                const float maxDeltaAngle)
 {
   vset(activeObst->nvel, 0.f, 0.f);
   float vmax = len_v2(activeObst->dvel);
 
   float *spos = new float[2 * m_maxSamples];
+  float *penalties = new float[m_maxSamples];
   int nspos = 0;
 
   if (!m_adaptive) {
@@ -789,14 +1072,13 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
       }
     }
     processSamples(activeObst,
-                   activeNavMeshObj,
-                   m_obstacles,
-                   m_levelHeight,
+                   neighbors,
                    vmax,
                    spos,
                    cs / 2,
                    nspos,
                    activeObst->nvel,
+                   penalties,
                    m_maxToi,
                    m_velWeight,
                    m_curVelWeight,
@@ -830,14 +1112,13 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
       }
 
       processSamples(activeObst,
-                     activeNavMeshObj,
-                     m_obstacles,
-                     m_levelHeight,
+                     neighbors,
                      vmax,
                      spos,
                      cs / 2,
                      nspos,
                      res,
+                     penalties,
                      m_maxToi,
                      m_velWeight,
                      m_curVelWeight,
@@ -850,6 +1131,7 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
   }
 
   delete[] spos;
+  delete[] penalties;
 }
 
 KX_ObstacleSimulationTOI_cells::KX_ObstacleSimulationTOI_cells(MT_Scalar levelHeight,
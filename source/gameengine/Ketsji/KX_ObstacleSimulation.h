@@ -63,6 +63,60 @@ struct KX_Obstacle {
 };
 typedef std::vector<KX_Obstacle *> KX_Obstacles;
 
+/// Obstacle found near an agent, the segment points are in world space.
+struct KX_ObstacleNeighbor {
+  KX_Obstacle *m_obstacle;
+  MT_Vector2 m_p1;
+  MT_Vector2 m_p2;
+};
+typedef std::vector<KX_ObstacleNeighbor> KX_ObstacleNeighbors;
+
+/** Uniform grid broadphase storing the obstacle indices in the cells overlapped by their 2D
+ * bounds. The cells are hashed into a flat table sorted by cell.
+ */
+class KX_ObstacleGrid {
+ public:
+  struct Bounds {
+    float m_min[2];
+    float m_max[2];
+  };
+
+ private:
+  struct CellRange {
+    int m_min[2];
+    int m_max[2];
+  };
+
+  float m_cellSize;
+  unsigned int m_mask;
+  /// Entries of the cell hash i are in the range [m_cellStart[i], m_cellStart[i + 1]).
+  std::vector<unsigned int> m_cellStart;
+  std::vector<unsigned int> m_entries;
+  /// Obstacles overlapping too many cells, returned by every query.
+  std::vector<unsigned int> m_largeObstacles;
+  std::vector<CellRange> m_ranges;
+  /// Last query stamp of each obstacle, used to not return an obstacle twice.
+  std::vector<unsigned int> m_queryStamps;
+  unsigned int m_queryStamp;
+  unsigned int m_numObstacles;
+
+  unsigned int CellHash(int x, int y) const;
+  void ComputeCellRange(const Bounds &bounds, CellRange &range) const;
+
+ public:
+  KX_ObstacleGrid();
+
+  /** Rebuild the grid.
+   * \param bounds The bounds of each obstacle.
+   * \param cellSize The size of a cell.
+   */
+  void Build(const std::vector<Bounds> &bounds, float cellSize);
+  /** Find the obstacles overlapping bounds, hash collisions can report extra obstacles.
+   * \param indices Receive the obstacle indices.
+   */
+  void Query(const Bounds &bounds, std::vector<unsigned int> &indices);
+};
+
 class KX_ObstacleSimulation {
  protected:
   KX_Obstacles m_obstacles;
@@ -70,7 +124,25 @@ class KX_ObstacleSimulation {
   MT_Scalar m_levelHeight;
   bool m_enableVisualization;
 
+  KX_ObstacleGrid m_grid;
+  std::vector<KX_ObstacleGrid::Bounds> m_bounds;
+  std::vector<unsigned int> m_queryIndices;
+  /// True when obstacles were added or removed since the last grid build.
+  bool m_gridDirty;
+  /// Largest speed of circle obstacles at the last grid build.
+  float m_maxObstacleSpeed;
+  /// Largest query radius since the last grid build, used as cell size.
+  float m_maxQueryRadius;
+
   KX_Obstacle *CreateObstacle(KX_GameObject *gameobj);
+  void BuildGrid();
+  /** Find the obstacles filtered for the active obstacle and which bounds are in radius.
+   * \param neighbors Receive the found obstacles.
+   */
+  void FindNeighbors(KX_Obstacle *activeObst,
+                     KX_NavMeshObject *activeNavMeshObj,
+                     float radius,
+                     KX_ObstacleNeighbors &neighbors);
 
  public:
   KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization);
@@ -100,8 +172,10 @@ class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
   float m_toiWeight;        // Sample selection TOI weight
   float m_collisionWeight;  // Sample selection collision weight
 
+  KX_ObstacleNeighbors m_neighbors;
+
   virtual void sampleRVO(KX_Obstacle *activeObst,
-                         KX_NavMeshObject *activeNavMeshObj,
+                         const KX_ObstacleNeighbors &neighbors,
                          const float maxDeltaAngle) = 0;
 
  public:
@@ -116,7 +190,7 @@ class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
 class KX_ObstacleSimulationTOI_rays : public KX_ObstacleSimulationTOI {
  protected:
   virtual void sampleRVO(KX_Obstacle *activeObst,
-                         KX_NavMeshObject *activeNavMeshObj,
+                         const KX_ObstacleNeighbors &neighbors,
                          const float maxDeltaAngle);
 
  public:
@@ -129,7 +203,7 @@ class KX_ObstacleSimulationTOI_cells : public KX_ObstacleSimulationTOI {
   bool m_adaptive;
   int m_sampleRadius;
   virtual void sampleRVO(KX_Obstacle *activeObst,
-                         KX_NavMeshObject *activeNavMeshObj,
+                         const KX_ObstacleNeighbors &neighbors,
                          const float maxDeltaAngle);
 
  public:
@@ -28,10 +28,15 @@
 #  include "DNA_python_component_types.h"
 
 #  include "CM_Message.h"
+#  include "CM_Profiler.h"
 #  include "KX_GameObject.h"
 
 KX_PythonComponent::KX_PythonComponent(const std::string &name)
-    : m_pc(nullptr), m_gameobj(nullptr), m_name(name), m_init(false)
+    : m_pc(nullptr),
+      m_gameobj(nullptr),
+      m_name(name),
+      m_profileName(CM_Profiler::RegisterName(name)),
+      m_init(false)
 {
 }
 
@@ -45,6 +50,11 @@ std::string KX_PythonComponent::GetName()
   return m_name;
 }
 
+const char *KX_PythonComponent::GetProfileName() const
+{
+  return m_profileName;
+}
+
 CValue *KX_PythonComponent::GetReplica()
 {
   KX_PythonComponent *replica = new KX_PythonComponent(*this);
@@ -36,6 +36,8 @@ class KX_PythonComponent : public CValue {
       private : PythonComponent *m_pc;
   KX_GameObject *m_gameobj;
   std::string m_name;
+  /// Interned name used as profiler zone name.
+  const char *m_profileName;
   bool m_init;
 
  public:
@@ -46,6 +48,8 @@ class KX_PythonComponent : public CValue {
   virtual std::string GetName();
   virtual CValue *GetReplica();
 
+  const char *GetProfileName() const;
+
   void ProcessReplica();
 
   KX_GameObject *GetGameObject() const;
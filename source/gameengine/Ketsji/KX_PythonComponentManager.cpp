@@ -35,3 +35,8 @@ void KX_PythonComponentManager::UpdateComponents()
 		gameobj->UpdateComponents();
 	}
 }
+
+bool KX_PythonComponentManager::IsEmpty() const
+{
+	return m_objects.empty();
+}
@@ -18,6 +18,9 @@ public:
 	void UnregisterObject(KX_GameObject *gameobj);
 
 	void UpdateComponents();
+
+	/// Return true if no object with components is registered.
+	bool IsEmpty() const;
 };
 
 #endif  // __KX_PYTHON_COMPONENT_H__
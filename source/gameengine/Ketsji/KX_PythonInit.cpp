@@ -253,6 +253,28 @@ static PyObject *gPyRestartGame(PyObject *)
   Py_RETURN_NONE;
 }
 
+/// Return a borrowed reference to bge.logic.globalDict, nullptr if it is not found.
+static PyObject *getGlobalDict()
+{
+  PyObject *gameLogic = PyImport_ImportModule("GameLogic");
+  if (!gameLogic) {
+    PyErr_Clear();
+    CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+    return nullptr;
+  }
+
+  PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic),
+                                                "globalDict");  // Same as importing the module
+  Py_DECREF(gameLogic);
+
+  if (!pyGlobalDict || !PyDict_Check(pyGlobalDict)) {
+    CM_Error("bge.logic.globalDict was removed");
+    return nullptr;
+  }
+
+  return pyGlobalDict;
+}
+
 PyDoc_STRVAR(gPySaveGlobalDict_doc,
              "saveGlobalDict()\n"
              "Saves bge.logic.globalDict to a file");
@@ -273,6 +295,40 @@ static PyObject *gPyLoadGlobalDict(PyObject *)
   Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR(gPySaveGlobalDictAsync_doc,
+             "saveGlobalDictAsync()\n"
+             "Saves bge.logic.globalDict to a file without waiting for the file to be written,\n"
+             "returns a KX_SaveGameStatus");
+static PyObject *gPySaveGlobalDictAsync(PyObject *)
+{
+  PyObject *pyGlobalDict = getGlobalDict();
+  if (!pyGlobalDict) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "saveGlobalDictAsync(): bge.logic.globalDict was removed");
+    return nullptr;
+  }
+
+  return KX_GetActiveEngine()->GetSaveGameManager().SaveAsync(pyGlobalDict,
+                                                             pathGamePythonConfig());
+}
+
+PyDoc_STRVAR(gPyLoadGlobalDictAsync_doc,
+             "loadGlobalDictAsync()\n"
+             "Loads bge.logic.globalDict from a file over the next frames,\n"
+             "returns a KX_SaveGameStatus");
+static PyObject *gPyLoadGlobalDictAsync(PyObject *)
+{
+  PyObject *pyGlobalDict = getGlobalDict();
+  if (!pyGlobalDict) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "loadGlobalDictAsync(): bge.logic.globalDict was removed");
+    return nullptr;
+  }
+
+  return KX_GetActiveEngine()->GetSaveGameManager().LoadAsync(pyGlobalDict,
+                                                             pathGamePythonConfig());
+}
+
 PyDoc_STRVAR(gPyGetProfileInfo_doc,
              "getProfileInfo()\n"
              "returns a dictionary with profiling information");
@@ -398,6 +454,69 @@ static PyObject *gPyGetMaxPhysicsFrame(PyObject *)
   return PyLong_FromLong(KX_GetActiveEngine()->GetMaxPhysicsFrame());
 }
 
+static PyObject *gPySetVoiceLimit(PyObject *, PyObject *args)
+{
+  int limit;
+  if (!PyArg_ParseTuple(args, "i:setVoiceLimit", &limit))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetVoiceManager().SetVoiceLimit(limit);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetVoiceLimit(PyObject *)
+{
+  return PyLong_FromLong(KX_GetActiveEngine()->GetVoiceManager().GetVoiceLimit());
+}
+
+static PyObject *gPySetVoiceMinimumGain(PyObject *, PyObject *args)
+{
+  float gain;
+  if (!PyArg_ParseTuple(args, "f:setVoiceMinimumGain", &gain))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetVoiceManager().SetMinimumGain(gain);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetVoiceMinimumGain(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetVoiceManager().GetMinimumGain());
+}
+
+static PyObject *gPySetVoicePriority(PyObject *, PyObject *args)
+{
+  int category, priority;
+  if (!PyArg_ParseTuple(args, "ii:setVoicePriority", &category, &priority))
+    return nullptr;
+
+  if (category < 0 || category >= SCA_VoiceManager::NUM_CATEGORIES) {
+    PyErr_Format(PyExc_ValueError,
+                 "setVoicePriority(category, priority): category must be in [0, %i]",
+                 SCA_VoiceManager::NUM_CATEGORIES - 1);
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetVoiceManager().SetCategoryPriority(category, priority);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetVoicePriority(PyObject *, PyObject *args)
+{
+  int category;
+  if (!PyArg_ParseTuple(args, "i:getVoicePriority", &category))
+    return nullptr;
+
+  if (category < 0 || category >= SCA_VoiceManager::NUM_CATEGORIES) {
+    PyErr_Format(PyExc_ValueError,
+                 "getVoicePriority(category): category must be in [0, %i]",
+                 SCA_VoiceManager::NUM_CATEGORIES - 1);
+    return nullptr;
+  }
+
+  return PyLong_FromLong(KX_GetActiveEngine()->GetVoiceManager().GetCategoryPriority(category));
+}
+
 static PyObject *gPySetPhysicsTicRate(PyObject *, PyObject *args)
 {
   float ticrate;
@@ -786,6 +905,14 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPyLoadGlobalDict,
      METH_NOARGS,
      (const char *)gPyLoadGlobalDict_doc},
+    {"saveGlobalDictAsync",
+     (PyCFunction)gPySaveGlobalDictAsync,
+     METH_NOARGS,
+     (const char *)gPySaveGlobalDictAsync_doc},
+    {"loadGlobalDictAsync",
+     (PyCFunction)gPyLoadGlobalDictAsync,
+     METH_NOARGS,
+     (const char *)gPyLoadGlobalDictAsync_doc},
     {"sendMessage", (PyCFunction)gPySendMessage, METH_VARARGS, (const char *)gPySendMessage_doc},
     {"getCurrentController",
      (PyCFunction)SCA_PythonController::sPyGetCurrentController,
@@ -819,6 +946,30 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPySetMaxPhysicsFrame,
      METH_VARARGS,
      (const char *)"Sets the max number of physics farme per render frame"},
+    {"getVoiceLimit",
+     (PyCFunction)gPyGetVoiceLimit,
+     METH_NOARGS,
+     (const char *)"Gets the max number of sounds played by the audio device"},
+    {"setVoiceLimit",
+     (PyCFunction)gPySetVoiceLimit,
+     METH_VARARGS,
+     (const char *)"Sets the max number of sounds played by the audio device"},
+    {"getVoiceMinimumGain",
+     (PyCFunction)gPyGetVoiceMinimumGain,
+     METH_NOARGS,
+     (const char *)"Gets the gain under which a sound is virtual"},
+    {"setVoiceMinimumGain",
+     (PyCFunction)gPySetVoiceMinimumGain,
+     METH_VARARGS,
+     (const char *)"Sets the gain under which a sound is virtual"},
+    {"getVoicePriority",
+     (PyCFunction)gPyGetVoicePriority,
+     METH_VARARGS,
+     (const char *)"Gets the priority of a sound category"},
+    {"setVoicePriority",
+     (PyCFunction)gPySetVoicePriority,
+     METH_VARARGS,
+     (const char *)"Sets the priority of a sound category"},
     {"getLogicTicRate",
      (PyCFunction)gPyGetLogicTicRate,
      METH_NOARGS,
@@ -2812,133 +2963,17 @@ PyMODINIT_FUNC initApplicationPythonBinding()
 // utility function for loading and saving the globalDict
 void saveGamePythonConfig()
 {
-  char *marshal_buffer = nullptr;
-  int marshal_length = 0;
-  PyObject *gameLogic = PyImport_ImportModule("GameLogic");
-  if (gameLogic) {
-    PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic),
-                                                  "globalDict");  // Same as importing the module
-    if (pyGlobalDict) {
-#  ifdef Py_MARSHAL_VERSION
-      PyObject *pyGlobalDictMarshal = PyMarshal_WriteObjectToString(
-          pyGlobalDict, 2);  // Py_MARSHAL_VERSION == 2 as of Py2.5
-#  else
-      PyObject *pyGlobalDictMarshal = PyMarshal_WriteObjectToString(pyGlobalDict);
-#  endif
-      if (pyGlobalDictMarshal) {
-        // for testing only
-        // PyObject_Print(pyGlobalDictMarshal, stderr, 0);
-        char *marshal_cstring;
-
-        marshal_cstring = PyBytes_AsString(pyGlobalDictMarshal);  // py3 uses byte arrays
-        marshal_length = PyBytes_Size(pyGlobalDictMarshal);
-        marshal_buffer = new char[marshal_length + 1];
-        memcpy(marshal_buffer, marshal_cstring, marshal_length);
-        Py_DECREF(pyGlobalDictMarshal);
-      }
-      else {
-        CM_Error("bge.logic.globalDict could not be marshal'd");
-      }
-    }
-    else {
-      CM_Error("bge.logic.globalDict was removed");
-    }
-    Py_DECREF(gameLogic);
-  }
-  else {
-    PyErr_Clear();
-    CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
-  }
-
-  std::string marshal_path = pathGamePythonConfig();
-
-  if (marshal_length && marshal_buffer) {
-    FILE *fp = fopen(marshal_path.c_str(), "wb");
-
-    if (fp) {
-      if (fwrite(marshal_buffer, 1, marshal_length, fp) != marshal_length) {
-        CM_Error("could not write marshal data");
-      }
-
-      fclose(fp);
-    }
-    else {
-      CM_Error("could not open marshal file");
-    }
-  }
-  else {
-    CM_Error("could not create marshal buffer");
-  }
-
-  if (marshal_buffer) {
-    delete[] marshal_buffer;
+  PyObject *pyGlobalDict = getGlobalDict();
+  if (pyGlobalDict) {
+    KX_GetActiveEngine()->GetSaveGameManager().Save(pyGlobalDict, pathGamePythonConfig());
   }
 }
 
 void loadGamePythonConfig()
 {
-  std::string marshal_path = pathGamePythonConfig();
-
-  FILE *fp = fopen(marshal_path.c_str(), "rb");
-
-  if (fp) {
-    // obtain file size:
-    fseek(fp, 0, SEEK_END);
-    size_t marshal_length = ftell(fp);
-    if (marshal_length == -1) {
-      CM_Error("could not read position of '" << marshal_path << "'");
-      fclose(fp);
-      return;
-    }
-    rewind(fp);
-
-    char *marshal_buffer = (char *)malloc(sizeof(char) * marshal_length);
-
-    int result = fread(marshal_buffer, 1, marshal_length, fp);
-
-    if (result == marshal_length) {
-      /* Restore the dict */
-      PyObject *gameLogic = PyImport_ImportModule("GameLogic");
-
-      if (gameLogic) {
-        PyObject *pyGlobalDict = PyMarshal_ReadObjectFromString(marshal_buffer, marshal_length);
-        if (pyGlobalDict) {
-          PyObject *pyGlobalDict_orig = PyDict_GetItemString(
-              PyModule_GetDict(gameLogic), "globalDict");  // Same as importing the module.
-          if (pyGlobalDict_orig) {
-            PyDict_Clear(pyGlobalDict_orig);
-            PyDict_Update(pyGlobalDict_orig, pyGlobalDict);
-          }
-          else {
-            /* this should not happen, but cant find the original globalDict, just assign it then
-             */
-            PyDict_SetItemString(PyModule_GetDict(gameLogic),
-                                 "globalDict",
-                                 pyGlobalDict);  // Same as importing the module.
-          }
-          Py_DECREF(gameLogic);
-          Py_DECREF(pyGlobalDict);
-        }
-        else {
-          Py_DECREF(gameLogic);
-          PyErr_Clear();
-          CM_Error("could not marshall string");
-        }
-      }
-      else {
-        PyErr_Clear();
-        CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
-      }
-    }
-    else {
-      CM_Error("could not read all of '" << marshal_path << "'");
-    }
-
-    free(marshal_buffer);
-    fclose(fp);
-  }
-  else {
-    CM_Error("could not open '" << marshal_path << "'");
+  PyObject *pyGlobalDict = getGlobalDict();
+  if (pyGlobalDict) {
+    KX_GetActiveEngine()->GetSaveGameManager().Load(pyGlobalDict, pathGamePythonConfig());
   }
 }
 
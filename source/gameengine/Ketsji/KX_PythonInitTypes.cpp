@@ -61,6 +61,7 @@
 #  include "KX_NetworkMessageSensor.h"
 #  include "KX_PolyProxy.h"
 #  include "KX_PythonComponent.h"
+#  include "KX_SaveGameStatus.h"
 #  include "KX_VehicleWrapper.h"
 #  include "KX_VertexProxy.h"
 #  include "SCA_2DFilterActuator.h"
@@ -251,6 +252,7 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, SCA_EndObjectActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_ReplaceMeshActuator, init_getset);
     PyType_Ready_Attr(dict, KX_Scene, init_getset);
+    PyType_Ready_Attr(dict, KX_SaveGameStatus, init_getset);
     PyType_Ready_Attr(dict, KX_NavMeshObject, init_getset);
     PyType_Ready_Attr(dict, SCA_SceneActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_SoundActuator, init_getset);
@@ -31,7 +31,6 @@
 
 #include "KX_SG_NodeRelationships.h"
 
-#include "MT_Matrix4x4.h"
 #include "MT_Transform.h"
 
 
@@ -65,20 +64,34 @@ bool KX_NormalParentRelation::UpdateChildCoordinates(SG_Node *child,
     return true;  // false;
   }
   else {
-    const MT_Transform trans(parent->GetWorldTransform() * child->GetLocalTransform());
-    MT_Matrix4x4 tmat(trans.toMatrix());
-    float sx = MT_Vector3(tmat.getElement(0, 0), tmat.getElement(1, 0), tmat.getElement(2, 0)).length();
-    float sy = MT_Vector3(tmat.getElement(0, 1), tmat.getElement(1, 1), tmat.getElement(2, 1)).length();
-    float sz = MT_Vector3(tmat.getElement(0, 2), tmat.getElement(1, 2), tmat.getElement(2, 2)).length();
-    const MT_Vector3 scale(sx, sy, sz);
-    const MT_Vector3 invscale(1.0f / sx, 1.0f / sy, 1.0f / sz);
-    const MT_Vector3 pos = trans.getOrigin();
-    const MT_Matrix3x3 rot = trans.getBasis().scaled(invscale.x(), invscale.y(), invscale.z());
-
-    child->SetWorldScale(scale);
+    const MT_Vector3 &p_world_scale = parent->GetWorldScaling();
+    const MT_Matrix3x3 &p_world_rotation = parent->GetWorldOrientation();
+    const MT_Vector3 &child_scale = child->GetLocalScale();
+    const MT_Matrix3x3 &child_rotation = child->GetLocalOrientation();
+
+    const MT_Vector3 pos = parent->GetWorldPosition() +
+                           p_world_rotation * (p_world_scale * child->GetLocalPosition());
+
+    /* A positive uniform parent scale commutes with the child rotation, the world rotation and
+     * scale are then computed without extracting the scale from the world matrix. */
+    if (p_world_scale[0] > 0.0f && p_world_scale[0] == p_world_scale[1] &&
+        p_world_scale[0] == p_world_scale[2] && child_scale[0] > 0.0f && child_scale[1] > 0.0f &&
+        child_scale[2] > 0.0f) {
+      child->SetWorldScale(p_world_scale[0] * child_scale);
+      child->SetWorldOrientation(p_world_rotation * child_rotation);
+    }
+    else {
+      const MT_Matrix3x3 basis =
+          p_world_rotation.scaled(p_world_scale[0], p_world_scale[1], p_world_scale[2]) *
+          child_rotation.scaled(child_scale[0], child_scale[1], child_scale[2]);
+      const MT_Vector3 scale(
+          basis.getColumn(0).length(), basis.getColumn(1).length(), basis.getColumn(2).length());
+
+      child->SetWorldScale(scale);
+      child->SetWorldOrientation(basis.scaled(1.0f / scale[0], 1.0f / scale[1], 1.0f / scale[2]));
+    }
     child->SetWorldPosition(pos);
-    child->SetWorldOrientation(rot);
-    
+
     child->ClearModified();
     return true;
   }
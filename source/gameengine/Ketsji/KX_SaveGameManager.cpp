@@ -0,0 +1,607 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SaveGameManager.cpp
+ *  \ingroup ketsji
+ */
+
+#ifdef WITH_PYTHON
+
+#  include "KX_SaveGameManager.h"
+
+#  include <algorithm>
+#  include <cstring>
+#  include <limits>
+#  include <new>
+
+#  include <zlib.h>
+
+#  include "BLI_fileops.h"
+#  include "BLI_task.h"
+#  include "BLI_utildefines.h"
+#  include "marshal.h"
+
+#  include "CM_Message.h"
+#  include "KX_SaveGameStatus.h"
+
+/** File layout, the integers are little endian:
+ * - header: magic (8 bytes), version (uint32), number of chunks (uint32).
+ * - chunks: uncompressed size (uint32), compressed size (uint32), zlib data.
+ * A chunk is the marshalled (key, value) tuple of an item.
+ */
+static const char savegameMagic[8] = {'B', 'G', 'E', 'S', 'A', 'V', 'E', '\0'};
+#  define SAVEGAME_VERSION 1
+#  define SAVEGAME_HEADER_SIZE 16
+#  define SAVEGAME_CHUNK_HEADER_SIZE 8
+// Favor the time spent by the task, the marshalled data compresses well anyway.
+#  define SAVEGAME_COMPRESSION_LEVEL Z_BEST_SPEED
+// Size of the chunks unmarshalled per logic frame by an asynchronous load.
+#  define SAVEGAME_MERGE_BUDGET (1 << 20)
+// Largest uncompressed chunk accepted when loading, and the best compression ratio of zlib.
+#  define SAVEGAME_MAX_CHUNK_SIZE (1 << 30)
+#  define SAVEGAME_MAX_COMPRESSION_RATIO 1032
+
+struct KX_SaveGameManager::Job {
+  enum Type { SAVE = 0, LOAD };
+
+  Job(Type type, const std::string &path, KX_SaveGameStatus *status)
+      : m_type(type),
+        m_path(path),
+        m_status(status),
+        m_proxy(status ? status->NewProxy(true) : nullptr),
+        m_dict(nullptr),
+        m_items(nullptr),
+        m_numChunks(0),
+        m_numMerged(0),
+        m_legacy(false),
+        m_done(false),
+        m_failed(false)
+  {
+  }
+
+  Type m_type;
+  std::string m_path;
+  KX_SaveGameStatus *m_status;
+  /// Reference to the proxy owning the status, keeps the status alive until the job is finished.
+  PyObject *m_proxy;
+
+  /// Marshalled items written by a save.
+  std::vector<PyObject *> m_chunks;
+
+  /// Dictionary replaced by a load.
+  PyObject *m_dict;
+  /// Items unmarshalled by a load.
+  PyObject *m_items;
+  /// Chunks read by the task and not yet unmarshalled.
+  std::deque<std::string> m_readChunks;
+  unsigned int m_numChunks;
+  unsigned int m_numMerged;
+  /// The file is a marshalled dictionary, read as a single chunk.
+  bool m_legacy;
+
+  /// Protect the read chunks and the state shared with the task.
+  CM_ThreadMutex m_mutex;
+  bool m_done;
+  bool m_failed;
+};
+
+static void encode_uint32(unsigned char *data, unsigned int value)
+{
+  data[0] = value & 0xff;
+  data[1] = (value >> 8) & 0xff;
+  data[2] = (value >> 16) & 0xff;
+  data[3] = (value >> 24) & 0xff;
+}
+
+static unsigned int decode_uint32(const unsigned char *data)
+{
+  return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+}
+
+/// Return true if the value and all the values it contains can't be modified.
+static bool is_immutable(PyObject *value)
+{
+  if (value == Py_None || PyBool_Check(value) || PyLong_CheckExact(value) ||
+      PyFloat_CheckExact(value) || PyComplex_CheckExact(value) || PyUnicode_CheckExact(value) ||
+      PyBytes_CheckExact(value)) {
+    return true;
+  }
+
+  if (PyTuple_CheckExact(value)) {
+    for (Py_ssize_t i = 0, size = PyTuple_GET_SIZE(value); i < size; ++i) {
+      if (!is_immutable(PyTuple_GET_ITEM(value, i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  return false;
+}
+
+/// Write the chunks in a temporary file replacing the file once complete, run without the GIL.
+static bool write_savegame(const std::string &path, const std::vector<PyObject *> &chunks)
+{
+  const std::string tmppath = path + ".tmp";
+  FILE *fp = BLI_fopen(tmppath.c_str(), "wb");
+  if (!fp) {
+    CM_Error("could not open '" << tmppath << "'");
+    return false;
+  }
+
+  unsigned char header[SAVEGAME_HEADER_SIZE];
+  memcpy(header, savegameMagic, sizeof(savegameMagic));
+  encode_uint32(header + 8, SAVEGAME_VERSION);
+  encode_uint32(header + 12, chunks.size());
+  bool success = (fwrite(header, 1, sizeof(header), fp) == sizeof(header));
+
+  std::vector<unsigned char> buffer;
+  for (PyObject *chunk : chunks) {
+    if (!success) {
+      break;
+    }
+
+    // The bytes objects are immutable and referenced by the job, their data can be read.
+    const Bytef *data = (const Bytef *)PyBytes_AS_STRING(chunk);
+    const uLong size = PyBytes_GET_SIZE(chunk);
+    uLongf compressedSize = compressBound(size);
+    buffer.resize(SAVEGAME_CHUNK_HEADER_SIZE + compressedSize);
+
+    if (compress2(&buffer[SAVEGAME_CHUNK_HEADER_SIZE],
+                  &compressedSize,
+                  data,
+                  size,
+                  SAVEGAME_COMPRESSION_LEVEL) != Z_OK) {
+      success = false;
+      break;
+    }
+
+    encode_uint32(&buffer[0], size);
+    encode_uint32(&buffer[4], compressedSize);
+    const size_t writeSize = SAVEGAME_CHUNK_HEADER_SIZE + compressedSize;
+    success = (fwrite(buffer.data(), 1, writeSize, fp) == writeSize);
+  }
+
+  if (fclose(fp) != 0) {
+    success = false;
+  }
+
+  if (!success) {
+    CM_Error("could not write '" << tmppath << "'");
+    BLI_delete(tmppath.c_str(), false, false);
+    return false;
+  }
+
+  if (BLI_rename(tmppath.c_str(), path.c_str()) != 0) {
+    CM_Error("could not replace '" << path << "'");
+    return false;
+  }
+
+  return true;
+}
+
+KX_SaveGameManager::KX_SaveGameManager()
+{
+  m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+  m_lastChunks = PyDict_New();
+}
+
+KX_SaveGameManager::~KX_SaveGameManager()
+{
+  BLI_assert(m_jobs.empty());
+
+  BLI_task_pool_free(m_pool);
+  Py_DECREF(m_lastChunks);
+}
+
+void KX_SaveGameManager::SaveTask(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  Job *job = (Job *)taskdata;
+
+  const bool success = write_savegame(job->m_path, job->m_chunks);
+
+  job->m_mutex.Lock();
+  job->m_failed = !success;
+  job->m_done = true;
+  job->m_mutex.Unlock();
+}
+
+void KX_SaveGameManager::LoadTask(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  Job *job = (Job *)taskdata;
+
+  const bool success = ReadChunks(job);
+
+  job->m_mutex.Lock();
+  // The logic thread can already have failed to unmarshal a chunk.
+  job->m_failed |= !success;
+  job->m_done = true;
+  job->m_mutex.Unlock();
+}
+
+bool KX_SaveGameManager::ReadChunks(Job *job)
+{
+  FILE *fp = BLI_fopen(job->m_path.c_str(), "rb");
+  if (!fp) {
+    CM_Error("could not open '" << job->m_path << "'");
+    return false;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  const long fileSize = ftell(fp);
+  rewind(fp);
+
+  bool success = true;
+  unsigned char header[SAVEGAME_HEADER_SIZE];
+  const size_t headerSize = fread(header, 1, sizeof(header), fp);
+
+  // The sizes read from the file are checked, but a valid file can still be too big to load.
+  try {
+    if (headerSize < sizeof(header) || memcmp(header, savegameMagic, sizeof(savegameMagic)) != 0) {
+      // Former file made of the marshalled dictionary.
+      rewind(fp);
+
+      std::string chunk(std::max(fileSize, 0L), '\0');
+      if (fileSize < 0 || fread(&chunk[0], 1, fileSize, fp) != (size_t)fileSize) {
+        CM_Error("could not read all of '" << job->m_path << "'");
+        success = false;
+      }
+      else {
+        job->m_mutex.Lock();
+        job->m_legacy = true;
+        job->m_numChunks = 1;
+        job->m_readChunks.push_back(std::move(chunk));
+        job->m_mutex.Unlock();
+      }
+    }
+    else if (decode_uint32(header + 8) > SAVEGAME_VERSION) {
+      CM_Error("'" << job->m_path << "' was saved by a newer version");
+      success = false;
+    }
+    else {
+      const unsigned int numChunks = decode_uint32(header + 12);
+      // Size of the file left to read.
+      unsigned long remaining = (unsigned long)std::max(fileSize - SAVEGAME_HEADER_SIZE, 0L);
+
+      if (numChunks > remaining / SAVEGAME_CHUNK_HEADER_SIZE) {
+        success = false;
+      }
+      else {
+        job->m_mutex.Lock();
+        job->m_numChunks = numChunks;
+        job->m_mutex.Unlock();
+      }
+
+      std::vector<unsigned char> buffer;
+      for (unsigned int i = 0; success && i < numChunks; ++i) {
+        unsigned char chunkHeader[SAVEGAME_CHUNK_HEADER_SIZE];
+        if (fread(chunkHeader, 1, sizeof(chunkHeader), fp) != sizeof(chunkHeader)) {
+          success = false;
+          break;
+        }
+        remaining -= SAVEGAME_CHUNK_HEADER_SIZE;
+
+        const uLong compressedSize = decode_uint32(chunkHeader + 4);
+        uLongf size = decode_uint32(chunkHeader);
+        // Reject the sizes which can't come from the data left before allocating.
+        if (compressedSize > remaining || size > SAVEGAME_MAX_CHUNK_SIZE ||
+            size > (uint64_t)compressedSize * SAVEGAME_MAX_COMPRESSION_RATIO) {
+          success = false;
+          break;
+        }
+        remaining -= compressedSize;
+
+        buffer.resize(compressedSize);
+        if (fread(buffer.data(), 1, compressedSize, fp) != compressedSize) {
+          success = false;
+          break;
+        }
+
+        std::string chunk(size, '\0');
+        const uLongf expectedSize = size;
+        if (uncompress((Bytef *)&chunk[0], &size, buffer.data(), compressedSize) != Z_OK ||
+            size != expectedSize) {
+          success = false;
+          break;
+        }
+
+        job->m_mutex.Lock();
+        job->m_readChunks.push_back(std::move(chunk));
+        job->m_mutex.Unlock();
+      }
+
+      if (!success) {
+        CM_Error("'" << job->m_path << "' is truncated or corrupted");
+      }
+    }
+  }
+  catch (const std::bad_alloc &) {
+    CM_Error("not enough memory to load '" << job->m_path << "'");
+    success = false;
+  }
+
+  fclose(fp);
+
+  return success;
+}
+
+bool KX_SaveGameManager::Snapshot(PyObject *dict, std::vector<PyObject *> &chunks)
+{
+  PyObject *lastChunks = PyDict_New();
+  bool success = true;
+
+  PyObject *key;
+  PyObject *value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(dict, &pos, &key, &value)) {
+    const bool immutable = is_immutable(value);
+    PyObject *chunk = nullptr;
+
+    if (immutable) {
+      PyObject *last = PyDict_GetItem(m_lastChunks, key);
+      if (last && PyTuple_GET_ITEM(last, 0) == value) {
+        chunk = PyTuple_GET_ITEM(last, 1);
+        Py_INCREF(chunk);
+      }
+    }
+
+    if (!chunk) {
+      PyObject *item = PyTuple_Pack(2, key, value);
+      chunk = PyMarshal_WriteObjectToString(item, Py_MARSHAL_VERSION);
+      Py_DECREF(item);
+
+      if (!chunk || PyBytes_GET_SIZE(chunk) > std::numeric_limits<unsigned int>::max()) {
+        PyErr_Clear();
+        Py_XDECREF(chunk);
+        success = false;
+        break;
+      }
+    }
+
+    // Only the immutable values can reuse their chunk, the others are not kept alive.
+    if (immutable) {
+      PyObject *last = PyTuple_Pack(2, value, chunk);
+      PyDict_SetItem(lastChunks, key, last);
+      Py_DECREF(last);
+    }
+
+    chunks.push_back(chunk);
+  }
+
+  if (!success) {
+    CM_Error("bge.logic.globalDict could not be marshal'd");
+    for (PyObject *chunk : chunks) {
+      Py_DECREF(chunk);
+    }
+    chunks.clear();
+    Py_DECREF(lastChunks);
+    return false;
+  }
+
+  Py_DECREF(m_lastChunks);
+  m_lastChunks = lastChunks;
+
+  return true;
+}
+
+void KX_SaveGameManager::MergeChunks(Job *job, size_t budget)
+{
+  size_t merged = 0;
+  while (budget == 0 || merged < budget) {
+    job->m_mutex.Lock();
+    if (job->m_readChunks.empty()) {
+      job->m_mutex.Unlock();
+      break;
+    }
+    const std::string chunk = std::move(job->m_readChunks.front());
+    job->m_readChunks.pop_front();
+    job->m_mutex.Unlock();
+
+    merged += chunk.size();
+    ++job->m_numMerged;
+
+    PyObject *item = PyMarshal_ReadObjectFromString(chunk.data(), chunk.size());
+    bool success;
+    if (job->m_legacy) {
+      success = item && PyDict_Check(item) && PyDict_Update(job->m_items, item) == 0;
+    }
+    else {
+      success = item && PyTuple_CheckExact(item) && PyTuple_GET_SIZE(item) == 2 &&
+                PyDict_SetItem(
+                    job->m_items, PyTuple_GET_ITEM(item, 0), PyTuple_GET_ITEM(item, 1)) == 0;
+    }
+    Py_XDECREF(item);
+
+    if (!success) {
+      PyErr_Clear();
+      CM_Error("could not unmarshal '" << job->m_path << "'");
+      job->m_mutex.Lock();
+      job->m_failed = true;
+      job->m_mutex.Unlock();
+    }
+  }
+
+  job->m_mutex.Lock();
+  const unsigned int numChunks = job->m_numChunks;
+  job->m_mutex.Unlock();
+
+  if (job->m_status && numChunks > 0) {
+    job->m_status->SetProgress((float)job->m_numMerged / numChunks);
+  }
+}
+
+void KX_SaveGameManager::PushJob(Job *job)
+{
+  m_jobs.push_back(job);
+  if (m_jobs.size() == 1) {
+    StartJob(job);
+  }
+}
+
+void KX_SaveGameManager::StartJob(Job *job)
+{
+  BLI_task_pool_push(
+      m_pool, (job->m_type == Job::SAVE) ? SaveTask : LoadTask, job, false, nullptr);
+}
+
+void KX_SaveGameManager::FinishJob(Job *job)
+{
+  for (PyObject *chunk : job->m_chunks) {
+    Py_DECREF(chunk);
+  }
+
+  // The dictionary is left unchanged by a failing load.
+  if (job->m_type == Job::LOAD && !job->m_failed) {
+    PyDict_Clear(job->m_dict);
+    PyDict_Update(job->m_dict, job->m_items);
+  }
+  Py_XDECREF(job->m_dict);
+  Py_XDECREF(job->m_items);
+
+  if (job->m_status) {
+    job->m_status->Finish(job->m_failed);
+  }
+  Py_XDECREF(job->m_proxy);
+
+  delete job;
+}
+
+PyObject *KX_SaveGameManager::SaveAsync(PyObject *dict, const std::string &path)
+{
+  KX_SaveGameStatus *status = new KX_SaveGameStatus(path);
+  Job *job = new Job(Job::SAVE, path, status);
+  PyObject *proxy = job->m_proxy;
+  Py_INCREF(proxy);
+
+  if (Snapshot(dict, job->m_chunks)) {
+    PushJob(job);
+  }
+  else {
+    job->m_failed = true;
+    FinishJob(job);
+  }
+
+  return proxy;
+}
+
+PyObject *KX_SaveGameManager::LoadAsync(PyObject *dict, const std::string &path)
+{
+  KX_SaveGameStatus *status = new KX_SaveGameStatus(path);
+  Job *job = new Job(Job::LOAD, path, status);
+  PyObject *proxy = job->m_proxy;
+  Py_INCREF(proxy);
+
+  Py_INCREF(dict);
+  job->m_dict = dict;
+  job->m_items = PyDict_New();
+  PushJob(job);
+
+  return proxy;
+}
+
+bool KX_SaveGameManager::Save(PyObject *dict, const std::string &path)
+{
+  // Don't overwrite the file being written or read.
+  FinalizeAsyncJobs();
+
+  std::vector<PyObject *> chunks;
+  if (!Snapshot(dict, chunks)) {
+    return false;
+  }
+
+  const bool success = write_savegame(path, chunks);
+
+  for (PyObject *chunk : chunks) {
+    Py_DECREF(chunk);
+  }
+
+  return success;
+}
+
+bool KX_SaveGameManager::Load(PyObject *dict, const std::string &path)
+{
+  FinalizeAsyncJobs();
+
+  Job *job = new Job(Job::LOAD, path, nullptr);
+  Py_INCREF(dict);
+  job->m_dict = dict;
+  job->m_items = PyDict_New();
+
+  job->m_failed = !ReadChunks(job);
+  if (!job->m_failed) {
+    MergeChunks(job, 0);
+  }
+
+  const bool success = !job->m_failed;
+  FinishJob(job);
+
+  return success;
+}
+
+void KX_SaveGameManager::MergeAsyncJobs()
+{
+  while (!m_jobs.empty()) {
+    Job *job = m_jobs.front();
+
+    if (job->m_type == Job::LOAD) {
+      MergeChunks(job, SAVEGAME_MERGE_BUDGET);
+    }
+
+    job->m_mutex.Lock();
+    const bool done = job->m_done && job->m_readChunks.empty();
+    job->m_mutex.Unlock();
+
+    if (!done) {
+      break;
+    }
+
+    // Start the next job before the finish callback which can request new jobs.
+    m_jobs.pop_front();
+    if (!m_jobs.empty()) {
+      StartJob(m_jobs.front());
+    }
+
+    FinishJob(job);
+  }
+}
+
+void KX_SaveGameManager::FinalizeAsyncJobs()
+{
+  while (!m_jobs.empty()) {
+    BLI_task_pool_work_and_wait(m_pool);
+
+    Job *job = m_jobs.front();
+    if (job->m_type == Job::LOAD) {
+      MergeChunks(job, 0);
+    }
+
+    // Start the next job before the finish callback which can request new jobs.
+    m_jobs.pop_front();
+    if (!m_jobs.empty()) {
+      StartJob(m_jobs.front());
+    }
+
+    FinishJob(job);
+  }
+}
+
+#endif  // WITH_PYTHON
@@ -0,0 +1,102 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SaveGameManager.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_SAVEGAMEMANAGER_H__
+#define __KX_SAVEGAMEMANAGER_H__
+
+#ifdef WITH_PYTHON
+
+#  include <deque>
+#  include <string>
+#  include <vector>
+
+#  include "CM_Thread.h"
+#  include "EXP_Python.h"
+
+class KX_SaveGameStatus;
+struct TaskPool;
+
+/** Save and load a dictionary, bge.logic.globalDict, in a file made of compressed chunks, one
+ * per item of the dictionary. The items are marshalled by the logic thread, the compression
+ * and the file access are done by a task. An asynchronous load unmarshals the chunks over
+ * several logic frames and replaces the content of the dictionary at the end.
+ */
+class KX_SaveGameManager {
+ public:
+  KX_SaveGameManager();
+  ~KX_SaveGameManager();
+
+  /** Snapshot the items of the dictionary and write them in a task.
+   * \return The status of the save, a new reference to its proxy.
+   */
+  PyObject *SaveAsync(PyObject *dict, const std::string &path);
+  /** Read the file in a task and replace the content of the dictionary once all the items
+   * are unmarshalled.
+   * \return The status of the load, a new reference to its proxy.
+   */
+  PyObject *LoadAsync(PyObject *dict, const std::string &path);
+
+  /// Save the dictionary before returning, the pending jobs are finished first.
+  bool Save(PyObject *dict, const std::string &path);
+  /// Load the dictionary before returning, also accepts the former marshal file.
+  bool Load(PyObject *dict, const std::string &path);
+
+  /// Unmarshal the loaded chunks and finish the done jobs, called once per logic frame.
+  void MergeAsyncJobs();
+  /// Wait and finish all the jobs.
+  void FinalizeAsyncJobs();
+
+ private:
+  struct Job;
+
+  /// Jobs in order of request, only the first one is run by a task to keep the file consistent.
+  std::deque<Job *> m_jobs;
+  TaskPool *m_pool;
+  /** Chunks of the last save by key, as (value, chunk) tuples. A deeply immutable value
+   * identical to the saved one reuses its chunk instead of being marshalled again.
+   */
+  PyObject *m_lastChunks;
+
+  static void SaveTask(TaskPool *__restrict pool, void *taskdata);
+  static void LoadTask(TaskPool *__restrict pool, void *taskdata);
+  /// Read and decompress the chunks of the file, run by the task of an asynchronous load.
+  static bool ReadChunks(Job *job);
+
+  /// Marshal the items of the dictionary in bytes objects.
+  bool Snapshot(PyObject *dict, std::vector<PyObject *> &chunks);
+  /** Unmarshal up to a size of chunks into the loaded dictionary.
+   * \param budget The size of the chunks to unmarshal, 0 for all.
+   */
+  void MergeChunks(Job *job, size_t budget);
+  /// Queue a job, it's started once the previous jobs are finished.
+  void PushJob(Job *job);
+  void StartJob(Job *job);
+  void FinishJob(Job *job);
+};
+
+#endif  // WITH_PYTHON
+
+#endif  // __KX_SAVEGAMEMANAGER_H__
@@ -0,0 +1,176 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SaveGameStatus.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SaveGameStatus.h"
+
+#include "PIL_time.h"
+
+KX_SaveGameStatus::KX_SaveGameStatus(const std::string &path)
+    : m_path(path),
+      m_progress(0.0f),
+      m_finished(false),
+      m_failed(false)
+#ifdef WITH_PYTHON
+      ,
+      m_finish_cb(nullptr)
+#endif
+{
+  m_endtime = m_starttime = PIL_check_seconds_timer();
+}
+
+KX_SaveGameStatus::~KX_SaveGameStatus()
+{
+#ifdef WITH_PYTHON
+  Py_XDECREF(m_finish_cb);
+#endif
+}
+
+void KX_SaveGameStatus::Finish(bool failed)
+{
+  m_finished = true;
+  m_failed = failed;
+  m_progress = 1.0f;
+  m_endtime = PIL_check_seconds_timer();
+
+  RunFinishCallback();
+}
+
+void KX_SaveGameStatus::RunFinishCallback()
+{
+#ifdef WITH_PYTHON
+  if (m_finish_cb) {
+    PyObject *args = Py_BuildValue("(O)", GetProxy());
+
+    if (!PyObject_Call(m_finish_cb, args, nullptr)) {
+      PyErr_Print();
+      PyErr_Clear();
+    }
+
+    Py_DECREF(args);
+  }
+#endif
+}
+
+void KX_SaveGameStatus::SetProgress(float progress)
+{
+  m_progress = progress;
+}
+
+#ifdef WITH_PYTHON
+
+PyMethodDef KX_SaveGameStatus::Methods[] = {
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef KX_SaveGameStatus::Attributes[] = {
+    KX_PYATTRIBUTE_RW_FUNCTION(
+        "onFinish", KX_SaveGameStatus, pyattr_get_onfinish, pyattr_set_onfinish),
+    KX_PYATTRIBUTE_FLOAT_RO("progress", KX_SaveGameStatus, m_progress),
+    KX_PYATTRIBUTE_STRING_RO("path", KX_SaveGameStatus, m_path),
+    KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_SaveGameStatus, pyattr_get_timetaken),
+    KX_PYATTRIBUTE_BOOL_RO("finished", KX_SaveGameStatus, m_finished),
+    KX_PYATTRIBUTE_BOOL_RO("failed", KX_SaveGameStatus, m_failed),
+    KX_PYATTRIBUTE_NULL  // Sentinel
+};
+
+PyTypeObject KX_SaveGameStatus::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_SaveGameStatus",
+                                        sizeof(PyObjectPlus_Proxy),
+                                        0,
+                                        py_base_dealloc,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        py_base_repr,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        Methods,
+                                        0,
+                                        0,
+                                        &PyObjectPlus::Type,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        0,
+                                        py_base_new};
+
+PyObject *KX_SaveGameStatus::pyattr_get_onfinish(PyObjectPlus *self_v,
+                                                 const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_SaveGameStatus *self = static_cast<KX_SaveGameStatus *>(self_v);
+
+  if (self->m_finish_cb) {
+    Py_INCREF(self->m_finish_cb);
+    return self->m_finish_cb;
+  }
+
+  Py_RETURN_NONE;
+}
+
+int KX_SaveGameStatus::pyattr_set_onfinish(PyObjectPlus *self_v,
+                                           const KX_PYATTRIBUTE_DEF *attrdef,
+                                           PyObject *value)
+{
+  KX_SaveGameStatus *self = static_cast<KX_SaveGameStatus *>(self_v);
+
+  if (!PyCallable_Check(value)) {
+    PyErr_SetString(PyExc_TypeError, "KX_SaveGameStatus.onFinish requires a callable object");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  Py_XDECREF(self->m_finish_cb);
+
+  Py_INCREF(value);
+  self->m_finish_cb = value;
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_SaveGameStatus::pyattr_get_timetaken(PyObjectPlus *self_v,
+                                                  const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_SaveGameStatus *self = static_cast<KX_SaveGameStatus *>(self_v);
+
+  return PyFloat_FromDouble(self->m_endtime - self->m_starttime);
+}
+#endif  // WITH_PYTHON
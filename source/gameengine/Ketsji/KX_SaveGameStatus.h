@@ -0,0 +1,66 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SaveGameStatus.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_SAVEGAMESTATUS_H__
+#define __KX_SAVEGAMESTATUS_H__
+
+#include "EXP_PyObjectPlus.h"
+
+/// Status of an asynchronous save or load of bge.logic.globalDict, owned by python.
+class KX_SaveGameStatus : public PyObjectPlus {
+  Py_Header private : std::string m_path;
+
+  float m_progress;
+  double m_starttime;
+  double m_endtime;
+
+  bool m_finished;
+  bool m_failed;
+
+#ifdef WITH_PYTHON
+  PyObject *m_finish_cb;
+#endif
+
+ public:
+  KX_SaveGameStatus(const std::string &path);
+  virtual ~KX_SaveGameStatus();
+
+  /// Called from the logic thread when the save or load is done.
+  void Finish(bool failed);
+  void RunFinishCallback();
+
+  void SetProgress(float progress);
+
+#ifdef WITH_PYTHON
+  static PyObject *pyattr_get_onfinish(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_onfinish(PyObjectPlus *self_v,
+                                 const KX_PYATTRIBUTE_DEF *attrdef,
+                                 PyObject *value);
+  static PyObject *pyattr_get_timetaken(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+#endif
+};
+
+#endif  // __KX_SAVEGAMESTATUS_H__
@@ -36,8 +36,10 @@
 
 #include "KX_Scene.h"
 
+#include "BKE_action.h"
 #include "BKE_lib_id.h"
 #include "BKE_object.h"
+#include "BKE_property.h"
 #include "BKE_screen.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
@@ -53,10 +55,12 @@
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_BlenderSceneConverter.h"
+#include "CM_Profiler.h"
 #include "EXP_FloatValue.h"
 #include "KX_2DFilterManager.h"
 #include "KX_BlenderCanvas.h"
 #include "KX_Camera.h"
+#include "KX_ClientObjectInfo.h"
 #include "KX_CollisionEventManager.h"
 #include "KX_FontObject.h"
 #include "KX_Globals.h"
@@ -128,6 +132,8 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    KX_NetworkMessageManager *messageManager)
     : CValue(),
       m_resetTaaSamples(false),               // eevee
+      m_transformSyncAll(true),               // eevee
+      m_objectsAreStatic(true),               // eevee
       m_lastReplicatedParentObject(nullptr),  // eevee
       m_gameDefaultCamera(nullptr),           // eevee
       m_shadingTypeBackup(0),                 // eevee
@@ -138,10 +144,13 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_sceneConverter(nullptr),              // eevee
       m_isPythonMainLoop(false),              // eevee
       m_collectionRemap(false),               // eevee (to uncheck viewport restrictflag)
+      m_relationsUpdate(false),               // eevee
+      m_baseFlagsUpdate(false),               // eevee
       m_keyboardmgr(nullptr),
       m_mousemgr(nullptr),
       m_physicsEnvironment(0),
       m_sceneName(sceneName),
+      m_profileName(CM_Profiler::RegisterName(sceneName)),
       m_active_camera(nullptr),
       m_overrideCullingCamera(nullptr),
       m_ueberExecutionPriority(0),
@@ -154,6 +163,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   m_dbvt_culling = false;
   m_dbvt_occlusion_res = 0;
   m_activity_culling = false;
+  m_isolated = (scene->gm.flag & GAME_SCENE_ISOLATED) != 0;
   m_objectlist = new CListValue<KX_GameObject>();
   m_parentlist = new CListValue<KX_GameObject>();
   m_lightlist = new CListValue<KX_LightObject>();
@@ -212,7 +222,6 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 
   /*************************************************EEVEE
    * INTEGRATION***********************************************************/
-  m_staticObjects = {};
   m_kxobWithLod = {};
   m_obRestrictFlags = {};
 
@@ -240,9 +249,14 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
    */
   ReinitBlenderContextVariables();
 
-  BackupShadingType();
+  // Nothing is rendered by the headless engine, the shading and eevee's cache are useless.
+  const bool headless = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS);
 
-  if ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0) {
+  if (!headless) {
+    BackupShadingType();
+  }
+
+  if ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0 && !headless) {
     /* We want to indicate that we are in bge runtime. The flag can be used in draw code but in
      * depsgraph code too later */
     scene->flag |= SCE_INTERACTIVE;
@@ -280,23 +294,26 @@ KX_Scene::~KX_Scene()
   Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
   View3D *v3d = CTX_wm_view3d(C);
 
-  if ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0) {
-    if (!m_isPythonMainLoop) {
-      /* This will free m_gpuViewport and m_gpuOffScreen */
-      DRW_game_render_loop_end();
+  // The headless engine never used the draw manager.
+  if (!KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS)) {
+    if ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0) {
+      if (!m_isPythonMainLoop) {
+        /* This will free m_gpuViewport and m_gpuOffScreen */
+        DRW_game_render_loop_end();
+      }
+      else {
+        /* It has not been freed before because the main Render loop
+         * is not executed then we free it now.
+         */
+        GPU_viewport_free(m_initMaterialsGPUViewport);
+        DRW_game_python_loop_end(DEG_get_evaluated_view_layer(depsgraph));
+      }
     }
     else {
-      /* It has not been freed before because the main Render loop
-       * is not executed then we free it now.
-       */
-      GPU_viewport_free(m_initMaterialsGPUViewport);
-      DRW_game_python_loop_end(DEG_get_evaluated_view_layer(depsgraph));
+      // Free the allocated profile a last time
+      DRW_game_viewport_render_loop_end();
     }
   }
-  else {
-    // Free the allocated profile a last time
-    DRW_game_viewport_render_loop_end();
-  }
 
   if (m_shadingTypeBackup != 0) {
     v3d->shading.type = m_shadingTypeBackup;
@@ -335,6 +352,10 @@ KX_Scene::~KX_Scene()
   if (m_objectlist)
     m_objectlist->Release();
 
+  while (!m_replicaPools.empty()) {
+    FreeReplicaPool(m_replicaPools.begin()->first);
+  }
+
   LayerCollection *layer_collection = BKE_layer_collection_get_active(view_layer);
   BKE_collection_object_remove(bmain, layer_collection->collection, m_gameDefaultCamera, false);
   BKE_id_free(bmain, m_gameDefaultCamera);
@@ -489,7 +510,7 @@ Object *KX_Scene::GetGameDefaultCamera()
 
 bool KX_Scene::ObjectsAreStatic()
 {
-  return GetObjectList()->GetCount() == m_staticObjects.size();
+  return m_objectsAreStatic;
 }
 
 void KX_Scene::ResetTaaSamples()
@@ -497,6 +518,27 @@ void KX_Scene::ResetTaaSamples()
   m_resetTaaSamples = true;
 }
 
+void KX_Scene::AppendToIdsToUpdate(ID *id, int flag)
+{
+  m_idsToUpdateLock.Lock();
+  m_idsToUpdate.emplace_back(id, flag);
+  m_idsToUpdateLock.Unlock();
+}
+
+void KX_Scene::UpdateIdsToUpdate()
+{
+  if (m_idsToUpdate.empty()) {
+    return;
+  }
+
+  for (const std::pair<ID *, int> &idToUpdate : m_idsToUpdate) {
+    DEG_id_tag_update(idToUpdate.first, idToUpdate.second);
+  }
+  m_idsToUpdate.clear();
+
+  ResetTaaSamples();
+}
+
 void KX_Scene::AddOverlayCollection(KX_Camera *overlay_cam, Collection *collection)
 {
   /* Check for already added collections */
@@ -644,17 +686,27 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, const RAS_Rect &viewport,
     m_collectionRemap = false;
   }
 
-  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  // Objects added or removed during the frame share a single relations rebuild.
+  if (m_relationsUpdate) {
+    DEG_relations_tag_update(bmain);
+    m_relationsUpdate = false;
+  }
 
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(is_overlay_pass);
+  // Pooled replicas shown or hidden during the frame share a single view layer sync.
+  if (m_baseFlagsUpdate) {
+    BKE_layer_collection_sync(scene, BKE_view_layer_default_view(scene));
+    DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+    m_baseFlagsUpdate = false;
   }
 
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+
+  SyncTransforms(is_overlay_pass);
+
   engine->EndCountDepsgraphTime();
 
   bool reset_taa_samples = !ObjectsAreStatic() || m_resetTaaSamples;
   m_resetTaaSamples = false;
-  m_staticObjects.clear();
 
   rcti window;
   int v[4];
@@ -811,9 +863,7 @@ void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
 
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(false);
-  }
+  SyncTransforms(false);
 
   SetCurrentGPUViewport(cam->GetGPUViewport());
 
@@ -1095,6 +1145,138 @@ void KX_Scene::TagForCollectionRemap()
   m_collectionRemap = true;
 }
 
+void KX_Scene::TagForRelationsUpdate()
+{
+  m_relationsUpdate = true;
+}
+
+void KX_Scene::ShowReplicaBlenderObject(Object *ob, bool show)
+{
+  ViewLayer *view_layer = BKE_view_layer_default_view(m_blenderScene);
+  Base *base = BKE_view_layer_base_find(view_layer, ob);
+  if (!base) {
+    return;
+  }
+  if (show) {
+    base->flag &= ~BASE_HIDDEN;
+  }
+  else {
+    base->flag |= BASE_HIDDEN;
+  }
+  // The view layer is synced once before the next render.
+  m_baseFlagsUpdate = true;
+}
+
+Object *KX_Scene::NewReplicaBlenderObject(Object *ob)
+{
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  ViewLayer *view_layer = BKE_view_layer_default_view(m_blenderScene);
+  Object *newob;
+  BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
+  BKE_collection_object_add_from(bmain,
+                                 m_blenderScene,
+                                 BKE_view_layer_camera_find(view_layer),
+                                 newob);  // add replica where is the active camera
+  newob->base_flag |= (BASE_VISIBLE_VIEWLAYER | BASE_VISIBLE_DEPSGRAPH);
+  newob->restrictflag &= ~OB_RESTRICT_VIEWPORT;
+  TagForCollectionRemap();
+  TagForRelationsUpdate();
+
+  return newob;
+}
+
+Object *KX_Scene::AcquireReplicaBlenderObject(Object *ob)
+{
+  std::map<Object *, ReplicaPool>::iterator it = m_replicaPools.find(ob);
+  if (it == m_replicaPools.end() || it->second.objects.empty()) {
+    return NewReplicaBlenderObject(ob);
+  }
+
+  // The copy is already linked in the scene and known by the depsgraph, just show it.
+  Object *newob = it->second.objects.back();
+  it->second.objects.pop_back();
+  ShowReplicaBlenderObject(newob, true);
+  ResetTaaSamples();
+
+  /* Restore the state left by the previous use of the copy, the game object itself is always
+   * a fresh replica of the inactive object. */
+  BKE_object_transform_copy(newob, ob);
+  BKE_bproperty_free_list(&newob->prop);
+  BKE_bproperty_copy_list(&newob->prop, &ob->prop);
+  if (newob->pose && ob->pose) {
+    BKE_pose_copy_result(newob->pose, ob->pose);
+  }
+  DEG_id_tag_update(&newob->id, ID_RECALC_TRANSFORM);
+
+  return newob;
+}
+
+void KX_Scene::ReleaseReplicaBlenderObject(Object *ob, Object *replica)
+{
+  std::map<Object *, ReplicaPool>::iterator it = m_replicaPools.find(ob);
+  if (m_isRuntime && it != m_replicaPools.end() &&
+      it->second.objects.size() < it->second.size) {
+    ShowReplicaBlenderObject(replica, false);
+    ResetTaaSamples();
+    it->second.objects.push_back(replica);
+    return;
+  }
+
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  BKE_scene_collections_object_remove(bmain, m_blenderScene, replica, true);
+  BKE_id_free(bmain, &replica->id);
+  TagForRelationsUpdate();
+}
+
+void KX_Scene::FillReplicaPools()
+{
+  std::map<Object *, unsigned short> sizes;
+  for (KX_GameObject *gameobj : *m_inactivelist) {
+    Object *ob = gameobj->GetBlenderObject();
+    if (!ob || ob->replica_pool_size <= 0) {
+      continue;
+    }
+
+    unsigned short &size = sizes[ob];
+    size = std::max(size, (unsigned short)ob->replica_pool_size);
+
+    // The size of a collection instance applies to every object it instances.
+    if (gameobj->IsDupliGroup()) {
+      FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (ob->instance_collection, groupob) {
+        unsigned short &groupsize = sizes[groupob];
+        groupsize = std::max(groupsize, (unsigned short)ob->replica_pool_size);
+      }
+      FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+    }
+  }
+
+  for (const std::pair<Object *const, unsigned short> &item : sizes) {
+    ReplicaPool &pool = m_replicaPools[item.first];
+    pool.size = std::max(pool.size, item.second);
+    while (pool.objects.size() < pool.size) {
+      Object *newob = NewReplicaBlenderObject(item.first);
+      ShowReplicaBlenderObject(newob, false);
+      pool.objects.push_back(newob);
+    }
+  }
+}
+
+void KX_Scene::FreeReplicaPool(Object *ob)
+{
+  std::map<Object *, ReplicaPool>::iterator it = m_replicaPools.find(ob);
+  if (it == m_replicaPools.end()) {
+    return;
+  }
+
+  Main *bmain = CTX_data_main(KX_GetActiveEngine()->GetContext());
+  for (Object *replica : it->second.objects) {
+    BKE_scene_collections_object_remove(bmain, m_blenderScene, replica, true);
+    BKE_id_free(bmain, &replica->id);
+  }
+  m_replicaPools.erase(it);
+  TagForRelationsUpdate();
+}
+
 /******************End of EEVEE INTEGRATION****************************/
 
 std::string KX_Scene::GetName()
@@ -1106,6 +1288,12 @@ std::string KX_Scene::GetName()
 void KX_Scene::SetName(const std::string &name)
 {
   m_sceneName = name;
+  m_profileName = CM_Profiler::RegisterName(name);
+}
+
+const char *KX_Scene::GetProfileName() const
+{
+  return m_profileName;
 }
 
 RAS_BucketManager *KX_Scene::GetBucketManager() const
@@ -1184,6 +1372,12 @@ void KX_Scene::SetActivityCulling(bool b)
   m_activity_culling = b;
 }
 
+bool KX_Scene::IsIsolated() const
+{
+  // Python components and controllers are run during the logic frame and need the GIL.
+  return m_isolated && m_componentManager.IsEmpty() && !m_logicmgr->HasPythonControllers();
+}
+
 void KX_Scene::AddObjectDebugProperties(class KX_GameObject *gameobj)
 {
   Object *blenderobject = gameobj->GetBlenderObject();
@@ -1271,6 +1465,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
   // this is the list of object that are send to the graphics pipeline
   m_objectlist->Add(CM_AddRef(newobj));
+  AddTransformSyncObject(newobj);
   switch (newobj->GetGameObjectType()) {
     case SCA_IObject::OBJ_LIGHT: {
       m_lightlist->Add(CM_AddRef(static_cast<KX_LightObject *>(newobj)));
@@ -1620,6 +1815,13 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
 
   m_ueberExecutionPriority++;
 
+  /* The timebomb name is added once to the layout of the original object and shared by all
+   * its replicas, else each replica would copy the layout to add it. */
+  int timebombSlot = -1;
+  if (lifespan > 0.0f) {
+    timebombSlot = originalobj->RegisterPropertySlot("::timebomb");
+  }
+
   // lets create a replica
   KX_GameObject *replica = (KX_GameObject *)AddNodeReplicaObject(nullptr, originalobj);
 
@@ -1627,13 +1829,13 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
   // lifespan of zero means 'this object lives forever'
   if (lifespan > 0.0f) {
     // for now, convert between so called frames and realtime
-    m_tempObjectList.push_back(replica);
     // this convert the life from frames to sort-of seconds, hard coded 0.02 that assumes we have
     // 50 frames per second if you change this value, make sure you change it in
     // KX_GameObject::pyattr_get_life property too
     CValue *fval = new CFloatValue(lifespan * 0.02f);
     replica->SetProperty("::timebomb", fval);
     fval->Release();
+    m_tempObjectList.emplace_back(replica, timebombSlot);
   }
 
   // add to 'rootparent' list (this is the list of top hierarchy objects, updated each frame)
@@ -1758,6 +1960,10 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
   if (gameobj->GetBlenderObject()) {
     // In some case the game object can contains a nullptr blender object e.g default camera.
     m_logicmgr->UnregisterGameObj(gameobj->GetBlenderObject(), gameobj);
+    // The pooled copies of a freed source object (e.g LibFree) can't be reused anymore.
+    if (!gameobj->IsReplica() && !m_replicaPools.empty()) {
+      FreeReplicaPool(gameobj->GetBlenderObject());
+    }
   }
 
   // remove all sensors/controllers/actuators from logicsystem...
@@ -1808,6 +2014,8 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
   m_componentManager.UnregisterObject(gameobj);
 
+  RemoveTransformSyncObject(gameobj);
+
   gameobj->RemoveMeshes();
 
   bool ret = true;
@@ -1844,8 +2052,10 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     m_euthanasyobjects.erase(euthit);
   }
 
-  const std::vector<KX_GameObject *>::const_iterator tempit = std::find(
-      m_tempObjectList.begin(), m_tempObjectList.end(), gameobj);
+  const std::vector<std::pair<KX_GameObject *, int>>::const_iterator tempit = std::find_if(
+      m_tempObjectList.begin(),
+      m_tempObjectList.end(),
+      [gameobj](const std::pair<KX_GameObject *, int> &pair) { return pair.first == gameobj; });
   if (tempit != m_tempObjectList.end()) {
     m_tempObjectList.erase(tempit);
   }
@@ -1999,8 +2209,9 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
 void KX_Scene::LogicBeginFrame(double curtime, double framestep)
 {
   // have a look at temp objects ...
-  for (KX_GameObject *gameobj : m_tempObjectList) {
-    CFloatValue *propval = (CFloatValue *)gameobj->GetProperty("::timebomb");
+  for (const std::pair<KX_GameObject *, int> &pair : m_tempObjectList) {
+    KX_GameObject *gameobj = pair.first;
+    CFloatValue *propval = (CFloatValue *)gameobj->GetPropertyFromSlot(pair.second);
 
     if (propval) {
       const float timeleft = propval->GetNumber() - framestep;
@@ -2030,76 +2241,110 @@ void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
   }
 }
 
-static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+static bool armature_child_is_culled(KX_GameObject *child, const SG_Frustum &frustum)
 {
-  KX_GameObject *gameobj, *parent;
-  CListValue<KX_GameObject> *children;
-  bool needs_update;
-  KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_user_data(pool);
-  double curtime = data->curtime;
+  Object *ob = child->GetBlenderObject();
+  if (!ob || ob->type != OB_MESH) {
+    return false;
+  }
 
-  gameobj = (KX_GameObject *)taskdata;
+  // The bounding box is stored per object, it's safe to compute it from a task.
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (!bb) {
+    return false;
+  }
+
+  const MT_Vector3 min(bb->vec[0]);
+  const MT_Vector3 max(bb->vec[6]);
+  const MT_Matrix4x4 mat(child->NodeGetWorldTransform());
+
+  return (frustum.AabbInsideFrustum(min, max, mat) == SG_Frustum::OUTSIDE);
+}
+
+static void update_anim_thread_func(TaskPool *__restrict pool, void *taskdata)
+{
+  KX_GameObject *gameobj = (KX_GameObject *)taskdata;
+  const KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)
+      BLI_task_pool_user_data(pool);
 
   // Non-armature updates are fast enough, so just update them
-  needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
+  bool needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE ||
+                      !data->frustum;
 
   if (!needs_update) {
     // If we got here, we're looking to update an armature, so check its children meshes
     // to see if we need to bother with a more expensive pose update
-    children = gameobj->GetChildren();
+    CListValue<KX_GameObject> *children = gameobj->GetChildren();
 
     bool has_mesh = false, has_non_mesh = false;
 
     // Check for meshes that haven't been culled
     for (KX_GameObject *child : children) {
-      // if (!child->GetCulled()) { // eevee disable armature animation culling
-      needs_update = true;
-      break;
-      //}
-
-      if (child->GetMeshCount() == 0)
+      if (child->GetMeshCount() == 0) {
         has_non_mesh = true;
-      else
-        has_mesh = true;
+        continue;
+      }
+
+      has_mesh = true;
+      if (!armature_child_is_culled(child, *data->frustum)) {
+        needs_update = true;
+        break;
+      }
     }
 
     // If we didn't find a non-culled mesh, check to see
     // if we even have any meshes, and update if this
     // armature has only non-mesh children.
-    if (!needs_update && !has_mesh && has_non_mesh)
+    if (!needs_update && !has_mesh && has_non_mesh) {
       needs_update = true;
+    }
 
     children->Release();
   }
 
   // If the object is a culled armature, then we manage only the animation time and end of its
   // animations.
-  gameobj->UpdateActionManager(curtime, needs_update);
-
-  if (needs_update) {
-    children = gameobj->GetChildren();
-    parent = gameobj->GetParent();
-
-    children->Release();
-  }
+  gameobj->UpdateActionManager(data->curtime, needs_update);
 }
 
 void KX_Scene::UpdateAnimations(double curtime)
 {
-  // m_animationPoolData.curtime = curtime;
+  m_animationPoolData.curtime = curtime;
+  m_animationPoolData.frustum = (m_active_camera) ? &m_active_camera->GetFrustum() : nullptr;
 
+  /* Armature pose evaluation is the expensive part and only touches per object data,
+   * other actions can evaluate shared data blocks (materials, world...) and are
+   * updated serially. */
   for (KX_GameObject *gameobj : m_animatedlist) {
-    // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
-    // TASK_PRIORITY_LOW);
-    gameobj->UpdateActionManager(curtime, true);
+    if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+      m_animatedArmatures.push_back(gameobj);
+    }
+    else {
+      gameobj->UpdateActionManager(curtime, true);
+    }
+  }
+
+  if (!m_animatedArmatures.empty()) {
+    for (KX_GameObject *gameobj : m_animatedArmatures) {
+      BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false, nullptr);
+    }
+
+    BLI_task_pool_work_and_wait(m_animationPool);
+    m_animatedArmatures.clear();
+
+    m_actionPoseCache.EndFrame();
   }
 
-  // BLI_task_pool_work_and_wait(m_animationPool);
+  // Apply the depsgraph updates requested by the actions.
+  UpdateIdsToUpdate();
 }
 
 void KX_Scene::LogicUpdateFrame(double curtime)
 {
-  m_componentManager.UpdateComponents();
+  {
+    CM_ProfileZone zone("Python Components");
+    m_componentManager.UpdateComponents();
+  }
 
   m_logicmgr->UpdateFrame(curtime);
 }
@@ -2127,18 +2372,65 @@ void KX_Scene::LogicEndFrame()
   }
 }
 
+/// Minimum number of famillies to update the scene graph in parallel.
+static const unsigned int PARALLEL_PARENTS_MIN_FAMILLIES = 64;
+
+struct UpdateParentsData {
+  const NodeList &nodes;
+  const std::vector<unsigned int> &famillies;
+  double time;
+};
+
+static void update_parents_familly_func(void *__restrict userdata,
+                                        const int iter,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const UpdateParentsData *data = (UpdateParentsData *)userdata;
+
+  for (unsigned int i = data->famillies[iter], end = data->famillies[iter + 1]; i < end; ++i) {
+    data->nodes[i]->UpdateScheduledWorldData(data->time);
+  }
+}
+
 /**
  * UpdateParents: SceneGraph transformation update.
  */
 void KX_Scene::UpdateParents(double curtime)
 {
-  // we use the SG dynamic list
-  SG_Node *node;
+  CM_ProfileZone zone("UpdateParents");
+
+  /* The famillies share no node and are updated in parallel. The nodes of a familly are
+   * updated in the schedule order, the root nodes first. Nodes scheduled during the update
+   * are processed by the next iteration. */
+  while (!m_sghead.Empty()) {
+    SG_Node::GetScheduledNodes(m_sghead, m_scheduledNodes);
+    std::stable_sort(
+        m_scheduledNodes.begin(), m_scheduledNodes.end(), [](SG_Node *node1, SG_Node *node2) {
+          return node1->GetFamilly().get() < node2->GetFamilly().get();
+        });
+
+    m_scheduledFamillies.clear();
+    for (unsigned int i = 0, size = m_scheduledNodes.size(); i < size; ++i) {
+      if (i == 0 ||
+          m_scheduledNodes[i]->GetFamilly() != m_scheduledNodes[i - 1]->GetFamilly()) {
+        m_scheduledFamillies.push_back(i);
+      }
+    }
+    const unsigned int famillyCount = m_scheduledFamillies.size();
+    m_scheduledFamillies.push_back(m_scheduledNodes.size());
+
+    UpdateParentsData data = {m_scheduledNodes, m_scheduledFamillies, curtime};
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (famillyCount >= PARALLEL_PARENTS_MIN_FAMILLIES);
+    BLI_task_parallel_range(0, famillyCount, &data, update_parents_familly_func, &settings);
 
-  while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
-    node->UpdateWorldData(curtime);
+    m_scheduledNodes.clear();
   }
 
+  SG_Node *node;
+
   // the list must be empty here
   BLI_assert(m_sghead.Empty());
   // some nodes may be ready for reschedule, move them to schedule list for next time
@@ -2155,9 +2447,79 @@ RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool
 /*****************************TAA UTILS**********************************/
 /* Utils for TAA to check if nothing is moving inside view frustum (or anywhere when using probes)
  */
-void KX_Scene::AppendToStaticObjects(KX_GameObject *gameobj)
+void KX_Scene::AddTransformSyncObject(KX_GameObject *gameobj)
+{
+  gameobj->SetTransformSyncEnabled(true);
+  TagForTransformSync(gameobj);
+}
+
+void KX_Scene::RemoveTransformSyncObject(KX_GameObject *gameobj)
+{
+  gameobj->SetTransformSyncEnabled(false);
+
+  if (gameobj->IsTransformSyncPending()) {
+    m_transformSyncObjects.erase(
+        std::find(m_transformSyncObjects.begin(), m_transformSyncObjects.end(), gameobj));
+    gameobj->SetTransformSyncPending(false);
+  }
+}
+
+void KX_Scene::TagForTransformSync(KX_GameObject *gameobj)
+{
+  m_transformSyncLock.Lock();
+  if (gameobj->IsTransformSyncEnabled() && !gameobj->IsTransformSyncPending()) {
+    gameobj->SetTransformSyncPending(true);
+    m_transformSyncObjects.push_back(gameobj);
+  }
+  m_transformSyncLock.Unlock();
+}
+
+void KX_Scene::StorePreviousTransforms()
 {
-  m_staticObjects.push_back(gameobj);
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    gameobj->GetSGNode()->StorePreviousWorldTransform();
+  }
+}
+
+void KX_Scene::SyncTransforms(bool is_overlay_pass)
+{
+  if (m_transformSyncAll) {
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      AddTransformSyncObject(gameobj);
+    }
+    m_transformSyncAll = false;
+  }
+
+  /* With an overlay camera the objects are compared to the previous frame only in the overlay
+   * pass, they must be kept until this pass. */
+  const bool lastPass = (!GetOverlayCamera() || is_overlay_pass);
+
+  m_objectsAreStatic = true;
+
+  // Objects tagged during the sync are kept after the synced objects.
+  const unsigned int count = m_transformSyncObjects.size();
+  unsigned int size = 0;
+  for (unsigned int i = 0; i < count; ++i) {
+    KX_GameObject *gameobj = m_transformSyncObjects[i];
+    gameobj->TagForUpdate(is_overlay_pass);
+
+    const bool isStatic = gameobj->IsStatic();
+    if (!isStatic) {
+      m_objectsAreStatic = false;
+    }
+
+    /* A moved object is synced once more to be found static, then it waits for the next
+     * update of its scene graph node. */
+    if (!lastPass || !isStatic || gameobj->UseTransformSyncEveryFrame()) {
+      m_transformSyncObjects[size++] = gameobj;
+    }
+    else {
+      gameobj->SetTransformSyncPending(false);
+    }
+  }
+
+  m_transformSyncObjects.erase(m_transformSyncObjects.begin() + size,
+                               m_transformSyncObjects.begin() + count);
 }
 /************************End of TAA UTILS**************************/
 /*************************************End of EEVEE INTEGRATION*********************************/
@@ -2390,6 +2752,14 @@ bool KX_Scene::MergeScene(KX_Scene *other)
   GetObjectList()->MergeList(other->GetObjectList());
   other->GetObjectList()->ReleaseAndRemoveAll();
 
+  // The merged objects are synced from this scene.
+  for (KX_GameObject *gameobj : other->m_transformSyncObjects) {
+    gameobj->SetTransformSyncEnabled(false);
+    gameobj->SetTransformSyncPending(false);
+  }
+  other->m_transformSyncObjects.clear();
+  m_transformSyncAll = true;
+
   GetInactiveList()->MergeList(other->GetInactiveList());
   other->GetInactiveList()->ReleaseAndRemoveAll();
 
@@ -2440,6 +2810,10 @@ bool KX_Scene::MergeScene(KX_Scene *other)
       timemgr->AddTimeProperty(times[i]);
     }
   }
+
+  // Pre-warm the replica pools of the merged inactive objects.
+  FillReplicaPools();
+
   return true;
 }
 
@@ -2521,6 +2895,7 @@ PyMethodDef KX_Scene::Methods[] = {
     KX_PYMETHODTABLE(KX_Scene, restart),
     KX_PYMETHODTABLE(KX_Scene, replace),
     KX_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+    KX_PYMETHODTABLE_KEYWORDS(KX_Scene, rayCastBatch),
     KX_PYMETHODTABLE(KX_Scene, convertBlenderObject),
     KX_PYMETHODTABLE(KX_Scene, convertBlenderObjectsList),
     KX_PYMETHODTABLE(KX_Scene, convertBlenderCollection),
@@ -2806,6 +3181,62 @@ int KX_Scene::pyattr_set_gravity(PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_action_pose_cache_size(PyObjectPlus *self_v,
+                                                      const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyLong_FromLong(self->m_actionPoseCache.GetMaxPoses());
+}
+
+int KX_Scene::pyattr_set_action_pose_cache_size(PyObjectPlus *self_v,
+                                                const KX_PYATTRIBUTE_DEF *attrdef,
+                                                PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const long size = PyLong_AsLong(value);
+  if (size == -1 && PyErr_Occurred()) {
+    return PY_SET_ATTR_FAIL;
+  }
+  if (size < 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.actionPoseCacheSize = int: KX_Scene, expected a positive value");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->m_actionPoseCache.SetMaxPoses(size);
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_Scene::pyattr_get_action_frame_step(PyObjectPlus *self_v,
+                                                const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyFloat_FromDouble(self->m_actionPoseCache.GetFrameStep());
+}
+
+int KX_Scene::pyattr_set_action_frame_step(PyObjectPlus *self_v,
+                                          const KX_PYATTRIBUTE_DEF *attrdef,
+                                          PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const double step = PyFloat_AsDouble(value);
+  if (step == -1.0 && PyErr_Occurred()) {
+    return PY_SET_ATTR_FAIL;
+  }
+  if (step < 0.0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.actionFrameStep = float: KX_Scene, expected a positive value");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->m_actionPoseCache.SetFrameStep(step);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
     KX_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -2831,7 +3262,14 @@ PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_FLOAT_RW(
         "activity_culling_radius", 0.5f, FLT_MAX, KX_Scene, m_activity_box_radius),
     KX_PYATTRIBUTE_BOOL_RO("dbvt_culling", KX_Scene, m_dbvt_culling),
+    KX_PYATTRIBUTE_BOOL_RW("isolated", KX_Scene, m_isolated),
     KX_PYATTRIBUTE_BOOL_RW("resetTaaSamples", KX_Scene, m_resetTaaSamples),
+    KX_PYATTRIBUTE_RW_FUNCTION("actionPoseCacheSize",
+                               KX_Scene,
+                               pyattr_get_action_pose_cache_size,
+                               pyattr_set_action_pose_cache_size),
+    KX_PYATTRIBUTE_RW_FUNCTION(
+        "actionFrameStep", KX_Scene, pyattr_get_action_frame_step, pyattr_set_action_frame_step),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -2926,6 +3364,229 @@ KX_PYMETHODDEF_DOC(KX_Scene,
   Py_RETURN_NONE;
 }
 
+/// Ray cast filter of rayCastBatch, the controllers are tested from several threads.
+class KX_RayCastBatchFilter : public PHY_IRayCastFilterCallback {
+ private:
+  unsigned short m_mask;
+
+ public:
+  KX_RayCastBatchFilter(PHY_IPhysicsController *ignoreController, unsigned short mask)
+      : PHY_IRayCastFilterCallback(ignoreController), m_mask(mask)
+  {
+  }
+
+  virtual bool needBroadphaseRayCast(PHY_IPhysicsController *controller)
+  {
+    KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(controller->GetNewClientInfo());
+    if (!info || info->m_type > KX_ClientObjectInfo::ACTOR) {
+      return false;
+    }
+
+    return (info->m_gameobject->GetUserCollisionGroup() & m_mask);
+  }
+
+  /// Batched queries write their results directly.
+  virtual void reportHit(PHY_RayCastResult *UNUSED(result))
+  {
+  }
+};
+
+/** Convert a sequence of 3D vectors or an object exposing a buffer of floats
+ * (multiple of 3) to a list of points.
+ */
+static bool ConvertPythonToPoints(PyObject *value,
+                                  std::vector<MT_Vector3> &points,
+                                  const char *error_prefix)
+{
+  if (PyObject_CheckBuffer(value)) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(value, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) == -1) {
+      return false;
+    }
+
+    const bool isFloat = STREQ(view.format, "f");
+    const bool isDouble = STREQ(view.format, "d");
+    if ((!isFloat && !isDouble) || (view.len / view.itemsize) % 3 != 0) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s, expected a buffer of floats or doubles with a length multiple of 3",
+                   error_prefix);
+      PyBuffer_Release(&view);
+      return false;
+    }
+
+    const Py_ssize_t size = view.len / view.itemsize / 3;
+    points.resize(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+      if (isFloat) {
+        points[i] = MT_Vector3(((float *)view.buf) + i * 3);
+      }
+      else {
+        points[i] = MT_Vector3(((double *)view.buf) + i * 3);
+      }
+    }
+
+    PyBuffer_Release(&view);
+    return true;
+  }
+
+  PyObject *seq = PySequence_Fast(value, error_prefix);
+  if (!seq) {
+    return false;
+  }
+
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(seq);
+  PyObject **items = PySequence_Fast_ITEMS(seq);
+  points.resize(size);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    if (!PyVecTo(items[i], points[i])) {
+      Py_DECREF(seq);
+      return false;
+    }
+  }
+
+  Py_DECREF(seq);
+  return true;
+}
+
+/// Return a memory view of floats with the shape (rows, columns) or (rows) for one column.
+static PyObject *CreateFloatMemoryView(const std::vector<float> &data, unsigned int columns)
+{
+  PyObject *bytes = PyByteArray_FromStringAndSize((const char *)data.data(),
+                                                  data.size() * sizeof(float));
+  if (!bytes) {
+    return nullptr;
+  }
+
+  PyObject *view = PyMemoryView_FromObject(bytes);
+  Py_DECREF(bytes);
+  if (!view) {
+    return nullptr;
+  }
+
+  PyObject *result;
+  const Py_ssize_t rows = data.size() / columns;
+  // A memory view can't be casted to a shape containing zeros.
+  if (rows == 0 || columns == 1) {
+    result = PyObject_CallMethod(view, "cast", "s", "f");
+  }
+  else {
+    result = PyObject_CallMethod(view, "cast", "s(nI)", "f", rows, columns);
+  }
+  Py_DECREF(view);
+
+  return result;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   rayCastBatch,
+                   "rayCastBatch(fromPoints, toPoints, radius=0.0, mask=0xFFFF, ignore=None)\n"
+                   "Cast several rays or sphere sweeps in parallel and return their closest hit.\n"
+                   "Return a tuple (objects, hitPoints, hitNormals, hitFractions).\n")
+{
+  PyObject *pyfrom;
+  PyObject *pyto;
+  float radius = 0.0f;
+  int mask = ((1 << OB_MAX_COL_MASKS) - 1);
+  PyObject *pyignore = Py_None;
+
+  static const char *kwlist[] = {"fromPoints", "toPoints", "radius", "mask", "ignore", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OO|fiO:rayCastBatch",
+                                   const_cast<char **>(kwlist),
+                                   &pyfrom,
+                                   &pyto,
+                                   &radius,
+                                   &mask,
+                                   &pyignore)) {
+    return nullptr;
+  }
+
+  if ((mask == 0) || (mask & ~((1 << OB_MAX_COL_MASKS) - 1))) {
+    PyErr_Format(PyExc_ValueError,
+                 "scene.rayCastBatch(...): mask must be between 1 and %i",
+                 ((1 << OB_MAX_COL_MASKS) - 1));
+    return nullptr;
+  }
+
+  if (radius < 0.0f) {
+    PyErr_SetString(PyExc_ValueError, "scene.rayCastBatch(...): radius must be positive");
+    return nullptr;
+  }
+
+  KX_GameObject *ignore;
+  if (!ConvertPythonToGameObject(
+          m_logicmgr, pyignore, &ignore, true, "scene.rayCastBatch(...): ignore")) {
+    return nullptr;
+  }
+
+  std::vector<MT_Vector3> fromPoints;
+  std::vector<MT_Vector3> toPoints;
+  if (!ConvertPythonToPoints(pyfrom, fromPoints, "scene.rayCastBatch(...): fromPoints") ||
+      !ConvertPythonToPoints(pyto, toPoints, "scene.rayCastBatch(...): toPoints")) {
+    return nullptr;
+  }
+
+  if (fromPoints.size() != toPoints.size()) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.rayCastBatch(...): fromPoints and toPoints must have the same length");
+    return nullptr;
+  }
+
+  const unsigned int count = fromPoints.size();
+  std::vector<PHY_RayCastQuery> queries(count);
+  for (unsigned int i = 0; i < count; ++i) {
+    queries[i] = {fromPoints[i], toPoints[i], radius};
+  }
+
+  std::vector<PHY_RayCastQueryResult> results(count);
+  if (m_physicsEnvironment && count > 0) {
+    KX_RayCastBatchFilter filter(ignore ? ignore->GetPhysicsController() : nullptr, mask);
+    m_physicsEnvironment->RayTestBatch(filter, queries.data(), results.data(), count);
+  }
+  else {
+    for (PHY_RayCastQueryResult &result : results) {
+      result.m_controller = nullptr;
+    }
+  }
+
+  PyObject *objects = PyList_New(count);
+  std::vector<float> hitPoints(count * 3, 0.0f);
+  std::vector<float> hitNormals(count * 3, 0.0f);
+  std::vector<float> hitFractions(count, 1.0f);
+
+  for (unsigned int i = 0; i < count; ++i) {
+    const PHY_RayCastQueryResult &result = results[i];
+    KX_ClientObjectInfo *info = result.m_controller ?
+                                    static_cast<KX_ClientObjectInfo *>(
+                                        result.m_controller->GetNewClientInfo()) :
+                                    nullptr;
+    if (!info) {
+      PyList_SET_ITEM(objects, i, Py_None);
+      Py_INCREF(Py_None);
+      continue;
+    }
+
+    PyList_SET_ITEM(objects, i, info->m_gameobject->GetProxy());
+    result.m_hitPoint.getValue(&hitPoints[i * 3]);
+    result.m_hitNormal.getValue(&hitNormals[i * 3]);
+    hitFractions[i] = result.m_hitFraction;
+  }
+
+  PyObject *pyHitPoints = CreateFloatMemoryView(hitPoints, 3);
+  PyObject *pyHitNormals = CreateFloatMemoryView(hitNormals, 3);
+  PyObject *pyHitFractions = CreateFloatMemoryView(hitFractions, 1);
+  if (!pyHitPoints || !pyHitNormals || !pyHitFractions) {
+    Py_DECREF(objects);
+    Py_XDECREF(pyHitPoints);
+    Py_XDECREF(pyHitNormals);
+    Py_XDECREF(pyHitFractions);
+    return nullptr;
+  }
+
+  return Py_BuildValue("(NNNN)", objects, pyHitPoints, pyHitNormals, pyHitFractions);
+}
+
 /* Matches python dict.get(key, [default]) */
 KX_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
@@ -33,9 +33,12 @@
 #define __KX_SCENE_H__
 
 #include <list>
+#include <map>
 #include <set>
 #include <vector>
 
+#include "BL_ActionPoseCache.h"
+#include "CM_Thread.h"
 #include "EXP_PyObjectPlus.h"
 #include "EXP_Value.h"
 #include "KX_PhysicsEngineEnums.h"
@@ -53,6 +56,7 @@
 struct SM_MaterialProps;
 struct SM_ShapeProps;
 struct Scene;
+struct ID;
 
 template<class T> class CListValue;
 
@@ -106,6 +110,8 @@ class KX_Scene : public CValue, public SCA_IScene {
 
   struct AnimationPoolData {
     double curtime;
+    /// Frustum of the active camera used to skip culled armatures, nullptr to disable.
+    const SG_Frustum *frustum;
   };
 
  private:
@@ -119,7 +125,15 @@ class KX_Scene : public CValue, public SCA_IScene {
  protected:
   /***************EEVEE INTEGRATION*****************/
 
-  std::vector<KX_GameObject *> m_staticObjects;
+  /** Objects to sync to the depsgraph in the next render pass. Objects are added when the world
+   * transform of their node changes and removed once they are found static.
+   */
+  std::vector<KX_GameObject *> m_transformSyncObjects;
+  CM_ThreadSpinLock m_transformSyncLock;
+  /// Sync all the objects in the next render pass, used when objects are added without update.
+  bool m_transformSyncAll;
+  /// True when no object moved since the previous frame in the last sync.
+  bool m_objectsAreStatic;
 
   int m_taaSamplesBackup;
   bool m_resetTaaSamples;
@@ -141,11 +155,28 @@ class KX_Scene : public CValue, public SCA_IScene {
   std::vector<KX_GameObject *> m_kxobWithLod;
   std::map<Object *, char> m_obRestrictFlags;
   bool m_collectionRemap;
+  /// True when the depsgraph relations must be rebuilt before the next render.
+  bool m_relationsUpdate;
+  /// True when pooled replicas were shown or hidden and the view layer must be synced.
+  bool m_baseFlagsUpdate;
+
+  /// Hidden Blender object copies ready to be reused by replicas of the same source object.
+  struct ReplicaPool {
+    unsigned short size;
+    std::vector<Object *> objects;
+  };
+  std::map<Object *, ReplicaPool> m_replicaPools;
+
+  /// Copy ob and link the copy where the active camera is.
+  Object *NewReplicaBlenderObject(Object *ob);
+  /// Show or hide a pooled copy, the view layer is synced before the next render.
+  void ShowReplicaBlenderObject(Object *ob, bool show);
   /*************************************************/
 
   RAS_BucketManager *m_bucketmanager;
 
-  std::vector<KX_GameObject *> m_tempObjectList;
+  /// Objects with a limited lifetime and the slot of their "::timebomb" property.
+  std::vector<std::pair<KX_GameObject *, int>> m_tempObjectList;
 
   /**
    * The list of objects which have been removed during the
@@ -170,6 +201,10 @@ class KX_Scene : public CValue, public SCA_IScene {
                       // the Dlist is not object that must be updated
                       // the Qlist is for objects that needs to be rescheduled
                       // for updates after udpate is over (slow parent, bone parent)
+  /// Scheduled nodes sorted by familly, used by UpdateParents.
+  NodeList m_scheduledNodes;
+  /// Index of the first scheduled node of each familly, followed by the number of nodes.
+  std::vector<unsigned int> m_scheduledFamillies;
 
   /**
    * Various SCA managers used by the scene
@@ -191,6 +226,8 @@ class KX_Scene : public CValue, public SCA_IScene {
    * The name of the scene
    */
   std::string m_sceneName;
+  /// Interned scene name used as profiler zone name.
+  const char *m_profileName;
 
   /**
    * \section Different scenes, linked to ketsji scene
@@ -273,6 +310,12 @@ class KX_Scene : public CValue, public SCA_IScene {
    */
   int m_dbvt_occlusion_res;
 
+  /**
+   * The scene doesn't run python or interact with other scenes,
+   * its logic and physics can be stepped in parallel.
+   */
+  bool m_isolated;
+
   /**
    * The framing settings used by this scene
    */
@@ -298,6 +341,16 @@ class KX_Scene : public CValue, public SCA_IScene {
 
   AnimationPoolData m_animationPoolData;
   TaskPool *m_animationPool;
+  /// Armatures updated in parallel in the current animations update.
+  std::vector<KX_GameObject *> m_animatedArmatures;
+  /// Poses evaluated from actions shared by the armatures of the scene.
+  BL_ActionPoseCache m_actionPoseCache;
+
+  /** Depsgraph updates requested by actions, they are collected during the animations
+   * update as it can run in parallel and are applied once it's finished.
+   */
+  std::vector<std::pair<struct ID *, int>> m_idsToUpdate;
+  CM_ThreadSpinLock m_idsToUpdateLock;
 
   /**
    * LOD Hysteresis settings
@@ -319,9 +372,22 @@ class KX_Scene : public CValue, public SCA_IScene {
   virtual ~KX_Scene();
 
   /******************EEVEE INTEGRATION************************/
-  void AppendToStaticObjects(KX_GameObject *gameobj);
+  /// Enable the transform sync of an object added to the active objects.
+  void AddTransformSyncObject(KX_GameObject *gameobj);
+  /// Disable the transform sync of an object removed from the scene.
+  void RemoveTransformSyncObject(KX_GameObject *gameobj);
+  /// Request to sync an object transform to the depsgraph if enabled, thread safe.
+  void TagForTransformSync(KX_GameObject *gameobj);
+  /// Sync the transform of the moved objects to the depsgraph.
+  void SyncTransforms(bool is_overlay_pass);
+  /// Save the world transform of all the objects before a logic frame, see USE_INTERPOLATION.
+  void StorePreviousTransforms();
   bool ObjectsAreStatic();
   void ResetTaaSamples();
+  /// Request a depsgraph update of an ID and a TAA reset, thread safe.
+  void AppendToIdsToUpdate(struct ID *id, int flag);
+  /// Tag all the requested IDs for depsgraph update.
+  void UpdateIdsToUpdate();
   void ConvertBlenderObject(struct Object *ob);
   void ConvertBlenderObjectsList(std::vector<Object *> objectslist, bool asynchronous);
   void ConvertBlenderCollection(struct Collection *co, bool asynchronous);
@@ -357,6 +423,15 @@ class KX_Scene : public CValue, public SCA_IScene {
   void BackupRestrictFlag(Object *ob, char restrictFlag);
   void RestoreRestrictFlags();
   void TagForCollectionRemap();
+  void TagForRelationsUpdate();
+  /// Return a linked and visible Blender copy of ob, taken from its pool when possible.
+  Object *AcquireReplicaBlenderObject(Object *ob);
+  /// Hide and keep a copy of ob for later reuse, or free it when its pool is full.
+  void ReleaseReplicaBlenderObject(Object *ob, Object *replica);
+  /// Create the hidden copies requested by the replica pool size of the inactive objects.
+  void FillReplicaPools();
+  /// Free the pooled copies of ob.
+  void FreeReplicaPool(Object *ob);
   /***************End of EEVEE INTEGRATION**********************/
 
   RAS_BucketManager *GetBucketManager() const;
@@ -518,6 +593,12 @@ class KX_Scene : public CValue, public SCA_IScene {
   {
     return m_dbvt_culling;
   }
+  void SetIsolated(bool isolated)
+  {
+    m_isolated = isolated;
+  }
+  /// Return true if the scene can be stepped in parallel with other isolated scenes.
+  bool IsIsolated() const;
   void SetDbvtOcclusionRes(int i)
   {
     m_dbvt_occlusion_res = i;
@@ -555,11 +636,18 @@ class KX_Scene : public CValue, public SCA_IScene {
     return m_obstacleSimulation;
   }
 
+  BL_ActionPoseCache &GetActionPoseCache()
+  {
+    return m_actionPoseCache;
+  }
+
   /**  Inherited from CValue -- returns the name of this object. */
   virtual std::string GetName();
 
   /** Inherited from CValue -- set the name of this object. */
   virtual void SetName(const std::string &name);
+  /// Return the scene name registered to the profiler.
+  const char *GetProfileName() const;
 
 #ifdef WITH_PYTHON
   /* --------------------------------------------------------------------- */
@@ -572,6 +660,7 @@ class KX_Scene : public CValue, public SCA_IScene {
   KX_PYMETHOD_DOC(KX_Scene, replace);
   KX_PYMETHOD_DOC(KX_Scene, get);
   KX_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+  KX_PYMETHOD_DOC(KX_Scene, rayCastBatch);
   KX_PYMETHOD_DOC(KX_Scene, convertBlenderObject);
   KX_PYMETHOD_DOC(KX_Scene, convertBlenderObjectsList);
   KX_PYMETHOD_DOC(KX_Scene, convertBlenderCollection);
@@ -605,6 +694,16 @@ class KX_Scene : public CValue, public SCA_IScene {
   static int pyattr_set_gravity(PyObjectPlus *self_v,
                                 const KX_PYATTRIBUTE_DEF *attrdef,
                                 PyObject *value);
+  static PyObject *pyattr_get_action_pose_cache_size(PyObjectPlus *self_v,
+                                                      const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_action_pose_cache_size(PyObjectPlus *self_v,
+                                               const KX_PYATTRIBUTE_DEF *attrdef,
+                                               PyObject *value);
+  static PyObject *pyattr_get_action_frame_step(PyObjectPlus *self_v,
+                                                const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_action_frame_step(PyObjectPlus *self_v,
+                                          const KX_PYATTRIBUTE_DEF *attrdef,
+                                          PyObject *value);
 
   /* getitem/setitem */
   static PyMappingMethods Mapping;
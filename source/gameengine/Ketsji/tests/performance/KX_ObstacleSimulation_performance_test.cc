@@ -0,0 +1,168 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <vector>
+
+#include "KX_ObstacleSimulation.h"
+
+#include "PIL_time.h"
+
+#define NUM_FRAMES 10
+#define NUM_AGENTS 1000
+#define AGENTS_PER_ROW 32
+#define AGENT_SPACING 2.0f
+#define AGENT_RADIUS 0.5f
+#define AGENT_SPEED 2.0f
+#define AGENT_ACCELERATION 3.0f
+#define AGENT_TURN_SPEED 120.0f
+#define TIME_STEP (1.0f / 60.0f)
+
+/* Simulation of agents without game objects, the benchmark moves the agents and updates their
+ * velocity instead of the steering actuators. */
+template<class Simulation> class KX_ObstacleSimulationBenchmark : public Simulation {
+ public:
+  KX_ObstacleSimulationBenchmark() : Simulation(1.0f, false)
+  {
+    for (unsigned int i = 0; i < NUM_AGENTS; ++i) {
+      KX_Obstacle *obstacle = new KX_Obstacle();
+      obstacle->m_type = KX_OBSTACLE_OBJ;
+      obstacle->m_shape = KX_OBSTACLE_CIRCLE;
+      obstacle->m_pos = MT_Vector3(
+          (i % AGENTS_PER_ROW) * AGENT_SPACING, (i / AGENTS_PER_ROW) * AGENT_SPACING, 0.0f);
+      obstacle->m_pos2 = obstacle->m_pos;
+      obstacle->m_rad = AGENT_RADIUS;
+      obstacle->m_gameObj = nullptr;
+      this->m_obstacles.push_back(obstacle);
+    }
+    this->m_gridDirty = true;
+  }
+
+  KX_Obstacle *GetAgent(unsigned int index)
+  {
+    return this->m_obstacles[index];
+  }
+
+  void BuildAgentGrid()
+  {
+    this->BuildGrid();
+  }
+
+  /// Adjust the velocity with every other agent as neighbor, without the grid.
+  void AdjustObstacleVelocityBruteForce(KX_Obstacle *activeObst,
+                                        MT_Vector3 &velocity,
+                                        MT_Scalar maxDeltaSpeed,
+                                        MT_Scalar maxDeltaAngle)
+  {
+    activeObst->dvel[0] = velocity.x();
+    activeObst->dvel[1] = velocity.y();
+
+    this->m_neighbors.clear();
+    for (KX_Obstacle *obs : this->m_obstacles) {
+      if (obs == activeObst ||
+          fabs(activeObst->m_pos.z() - obs->m_pos.z()) > this->m_levelHeight) {
+        continue;
+      }
+      KX_ObstacleNeighbor neighbor;
+      neighbor.m_obstacle = obs;
+      neighbor.m_p1 = neighbor.m_p2 = obs->m_pos.to2d();
+      this->m_neighbors.push_back(neighbor);
+    }
+
+    this->sampleRVO(activeObst, this->m_neighbors, maxDeltaAngle);
+
+    // Same dynamic constraint as KX_ObstacleSimulationTOI::AdjustObstacleVelocity.
+    MT_Vector2 dv(activeObst->nvel[0] - activeObst->vel[0],
+                  activeObst->nvel[1] - activeObst->vel[1]);
+    const MT_Scalar ds = dv.length();
+    if (ds > maxDeltaSpeed) {
+      dv *= maxDeltaSpeed / ds;
+    }
+    velocity.x() = activeObst->vel[0] + dv.x();
+    velocity.y() = activeObst->vel[1] + dv.y();
+  }
+
+  /// Set the adjusted velocities and move the agents.
+  void Step(const std::vector<MT_Vector3> &velocities)
+  {
+    for (unsigned int i = 0; i < NUM_AGENTS; ++i) {
+      KX_Obstacle *obs = this->m_obstacles[i];
+      obs->vel[0] = obs->pvel[0] = velocities[i].x();
+      obs->vel[1] = obs->pvel[1] = velocities[i].y();
+      obs->m_pos += velocities[i] * TIME_STEP;
+    }
+  }
+};
+
+/* Each frame every agent adjusts its velocity to cross its neighbor agents of the same row, first
+ * with the grid built each frame, then by testing every other agent as before the grid. */
+template<class Simulation> static void obstacle_simulation_agents(const char *id)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  const MT_Scalar maxDeltaSpeed = AGENT_ACCELERATION * TIME_STEP;
+  const MT_Scalar maxDeltaAngle = AGENT_TURN_SPEED / (180.0f * (float)M_PI * TIME_STEP);
+
+  std::vector<MT_Vector3> velocities(NUM_AGENTS);
+  double times[2] = {0.0, 0.0};
+  double buildTime = 0.0;
+  float distance[2] = {0.0f, 0.0f};
+
+  for (unsigned short bruteForce = 0; bruteForce < 2; ++bruteForce) {
+    KX_ObstacleSimulationBenchmark<Simulation> simulation;
+
+    for (unsigned int frame = 0; frame < NUM_FRAMES; ++frame) {
+      const double time = PIL_check_seconds_timer();
+      if (!bruteForce) {
+        simulation.BuildAgentGrid();
+        buildTime += PIL_check_seconds_timer() - time;
+      }
+
+      for (unsigned int i = 0; i < NUM_AGENTS; ++i) {
+        velocities[i] = MT_Vector3((i % 2) ? -AGENT_SPEED : AGENT_SPEED, 0.0f, 0.0f);
+        if (bruteForce) {
+          simulation.AdjustObstacleVelocityBruteForce(
+              simulation.GetAgent(i), velocities[i], maxDeltaSpeed, maxDeltaAngle);
+        }
+        else {
+          simulation.AdjustObstacleVelocity(
+              simulation.GetAgent(i), nullptr, velocities[i], maxDeltaSpeed, maxDeltaAngle);
+        }
+      }
+      times[bruteForce] += PIL_check_seconds_timer() - time;
+
+      simulation.Step(velocities);
+    }
+
+    for (unsigned int i = 0; i < NUM_AGENTS; ++i) {
+      distance[bruteForce] += simulation.GetAgent(i)->m_pos.to2d().length();
+    }
+  }
+
+  printf("%d frames of %d agents with grid in %f ms (grid build %f ms)\n",
+         NUM_FRAMES,
+         NUM_AGENTS,
+         times[0] * 1000.0,
+         buildTime * 1000.0);
+  printf("%d frames of %d agents with brute force in %f ms\n",
+         NUM_FRAMES,
+         NUM_AGENTS,
+         times[1] * 1000.0);
+  printf("Speedup: %.2fx\n", times[1] / times[0]);
+
+  // Both paths found the same neighbors, the agents moved the same way.
+  EXPECT_NEAR(distance[0], distance[1], distance[1] * 1.0e-4f);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(obstacle_simulation, AgentsTOIRays)
+{
+  obstacle_simulation_agents<KX_ObstacleSimulationTOI_rays>("ObstacleSimulation - TOI Rays");
+}
+
+TEST(obstacle_simulation, AgentsTOICells)
+{
+  obstacle_simulation_agents<KX_ObstacleSimulationTOI_cells>("ObstacleSimulation - TOI Cells");
+}
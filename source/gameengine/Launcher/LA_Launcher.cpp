@@ -38,6 +38,7 @@
 #include "BL_BlenderConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "DEV_EventConsumer.h"
 #include "DEV_InputDevice.h"
 #include "DEV_Joystick.h"
@@ -87,7 +88,8 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system,
       m_stereoMode(stereoMode),
       m_argc(argc),
       m_argv(argv),
-      m_audioDeviceIsInitialized(false)
+      m_audioDeviceIsInitialized(false),
+      m_headless(false)
 {
   m_pythonConsole.use = false;
 }
@@ -136,6 +138,18 @@ void LA_Launcher::InitEngine()
   bool frameRate = (SYS_GetCommandLineInt(syshandle, "show_framerate", 0) != 0);
   bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
   bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
+  bool parallelScenes = (gm.flag & GAME_USE_PARALLEL_SCENES) != 0;
+  bool interpolation = (gm.flag & GAME_USE_INTERPOLATION) != 0;
+  m_headless = (SYS_GetCommandLineInt(syshandle, "headless", 0) != 0);
+
+  // The trace profiler keeps recording through game restarts.
+  const std::string profileTrace = SYS_GetCommandLineString(syshandle, "profile_trace", "");
+  if (profileTrace.empty()) {
+    CM_Profiler::Disable();
+  }
+  else if (!CM_Profiler::IsEnabled()) {
+    CM_Profiler::Enable(SYS_GetCommandLineInt(syshandle, "profile_trace_size", 1 << 20));
+  }
 
   // Setup python console keys used as shortcut.
   for (unsigned short i = 0; i < 4; ++i) {
@@ -149,6 +163,9 @@ void LA_Launcher::InitEngine()
       (fixed_framerate ? KX_KetsjiEngine::FIXED_FRAMERATE : 0) |
       (frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
       (restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
+      (parallelScenes ? KX_KetsjiEngine::PARALLEL_SCENES : 0) |
+      (interpolation ? KX_KetsjiEngine::USE_INTERPOLATION : 0) |
+      (m_headless ? KX_KetsjiEngine::HEADLESS : 0) |
       (properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
       (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
 
@@ -227,7 +244,10 @@ void LA_Launcher::InitEngine()
   // Set the global settings (carried over if restart/load new files).
   m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
-  m_rasterizer->Init(m_canvas);
+  // Without GPU context the rasterizer only holds the render settings.
+  if (!m_headless) {
+    m_rasterizer->Init(m_canvas);
+  }
   InitCamera();
 
 #ifdef WITH_PYTHON
@@ -279,6 +299,14 @@ void LA_Launcher::ExitEngine()
   DEV_Joystick::Close();
   m_ketsjiEngine->StopEngine();
 
+  if (CM_Profiler::IsEnabled()) {
+    const std::string profileTrace = SYS_GetCommandLineString(
+        SYS_GetSystem(), "profile_trace", "");
+    if (!CM_Profiler::WriteTrace(profileTrace)) {
+      CM_Error("cannot write profiler trace to \"" << profileTrace << "\"");
+    }
+  }
+
 #ifdef WITH_PYTHON
 
   /* Clears the dictionary by hand:
@@ -477,6 +505,11 @@ bool LA_Launcher::EngineNextFrame()
     m_exitRequested = KX_ExitRequest::OUTSIDE;
   }
 
+  // Nothing waits for the display, sleep until the next logic frame instead of spinning.
+  if (m_headless && m_exitRequested == KX_ExitRequest::NO_REQUEST) {
+    m_kxsystem->SleepUntil(m_ketsjiEngine->GetNextFrameRealTime());
+  }
+
   return (m_exitRequested == KX_ExitRequest::NO_REQUEST);
 }
 
@@ -96,6 +96,9 @@ class LA_Launcher {
   /// avoid to run audaspace code if audio device fails to initialize
   bool m_audioDeviceIsInitialized;
 
+  /// Run without window and rendering, the frames are paced by sleeping.
+  bool m_headless;
+
   /// Saved data to restore at the game end.
   struct SavedData {
     int vsync;
@@ -38,6 +38,7 @@
 
 #include "BKE_sound.h"
 #include "BLI_fileops.h"
+#include "DNA_scene_types.h"
 #include "MEM_guardedalloc.h"
 
 #include "CM_Message.h"
@@ -127,7 +128,9 @@ void LA_PlayerLauncher::InitEngine()
   BKE_sound_init(m_maggie);
   LA_Launcher::InitEngine();
 
-  m_rasterizer->PrintHardwareInfo();
+  if (!m_headless) {
+    m_rasterizer->PrintHardwareInfo();
+  }
 }
 
 void LA_PlayerLauncher::ExitEngine()
@@ -151,5 +154,10 @@ bool LA_PlayerLauncher::EngineNextFrame()
 
 RAS_ICanvas *LA_PlayerLauncher::CreateCanvas()
 {
-  return (new GPG_Canvas(m_rasterizer, m_mainWindow));
+  GPG_Canvas *canvas = new GPG_Canvas(m_rasterizer, m_mainWindow);
+  // Without window the canvas takes the player size of the file, used by cameras and mouse.
+  if (m_headless) {
+    canvas->Resize(m_startScene->gm.xplay, m_startScene->gm.yplay);
+  }
+  return canvas;
 }
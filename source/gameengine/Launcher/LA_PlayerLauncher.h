@@ -40,7 +40,7 @@ class GHOST_IWindow;
 
 class LA_PlayerLauncher : public LA_Launcher {
  protected:
-  /// Main window.
+  /// Main window, nullptr for the headless player.
   GHOST_IWindow *m_mainWindow;
 
   /// Override python script main loop file name.
@@ -28,6 +28,9 @@
 
 #include "LA_System.h"
 
+#include <chrono>
+#include <thread>
+
 #include "PIL_time.h"
 
 LA_System::LA_System()
@@ -43,3 +46,20 @@ double LA_System::GetTimeInSeconds()
 {
   return PIL_check_seconds_timer() - m_starttime;
 }
+
+void LA_System::SleepUntil(double time)
+{
+  /* The system sleep can overshoot by the scheduler granularity, sleep until slightly before
+   * the deadline and yield for the remaining time.
+   */
+  static const double margin = 0.001;
+
+  const double remaining = time - GetTimeInSeconds();
+  if (remaining > margin) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(remaining - margin));
+  }
+
+  while (GetTimeInSeconds() < time) {
+    std::this_thread::yield();
+  }
+}
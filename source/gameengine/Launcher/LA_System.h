@@ -40,6 +40,7 @@ class LA_System : public KX_ISystem {
   virtual ~LA_System();
 
   virtual double GetTimeInSeconds();
+  virtual void SleepUntil(double time);
 };
 
 #endif  // __LA_SYSTEM_H__
@@ -306,8 +306,14 @@ bool CcdPhysicsController::CreateSoftbody()
     return false;
   }
 
+  btSoftRigidDynamicsWorld *softBodyWorld = m_cci.m_physicsEnv->GetSoftBodyWorld();
+  // The multithreaded world doesn't support soft bodies.
+  if (!softBodyWorld) {
+    return false;
+  }
+
   btSoftBody *psb = nullptr;
-  btSoftBodyWorldInfo &worldInfo = m_cci.m_physicsEnv->GetDynamicsWorld()->getWorldInfo();
+  btSoftBodyWorldInfo &worldInfo = softBodyWorld->getWorldInfo();
 
   if (m_cci.m_collisionShape->getShapeType() == CONVEX_HULL_SHAPE_PROXYTYPE) { // Disabled in upbge 0.3
     btConvexHullShape *convexHull = (btConvexHullShape *)m_cci.m_collisionShape;
@@ -520,6 +526,54 @@ bool CcdPhysicsController::CreateSoftbody()
           }
         }
       }
+
+      /* Map the vertices of the original mesh to the soft body nodes through the tessfaces,
+       * this mapping is used each frame to write back the soft body nodes. */
+      m_softBodyVertices.clear();
+
+      Mesh *me = rasMesh->GetOrigMesh();
+      DerivedMesh *dm = CDDM_from_mesh(me);
+      // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
+      DM_ensure_tessface(dm);
+
+      const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
+      const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
+      if (!index_mf_to_mpoly) {
+        index_mp_to_orig = nullptr;
+      }
+
+      const MFace *mface = dm->getTessFaceArray(dm);
+      const int numfaces = dm->getNumTessFaces(dm);
+      const int numnodes = psb->m_nodes.size();
+      // The node of each vertex, the last face using a vertex gives its node.
+      std::vector<int> vertexNodes(dm->getNumVerts(dm), -1);
+
+      for (int f = 0; f < numfaces; ++f) {
+        const MFace *mf = &mface[f];
+        const int origi = index_mf_to_mpoly ?
+                              DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, f) :
+                              f;
+        RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
+        if (!poly) {
+          continue;
+        }
+
+        const unsigned int verts[4] = {mf->v1, mf->v2, mf->v3, mf->v4};
+        for (unsigned short i = 0, size = (mf->v4) ? 4 : 3; i < size; ++i) {
+          const int node = poly->GetVertexInfo(i).getSoftBodyIndex();
+          if (node < numnodes) {
+            vertexNodes[verts[i]] = node;
+          }
+        }
+      }
+
+      for (unsigned int v = 0, size = vertexNodes.size(); v < size; ++v) {
+        if (vertexNodes[v] != -1) {
+          m_softBodyVertices.push_back({v, vertexNodes[v]});
+        }
+      }
+
+      dm->release(dm);
     }
   }
   m_softbodyMappingDone = true;
@@ -695,7 +749,7 @@ bool CcdPhysicsController::ReplaceControllerShape(btCollisionShape *newShape)
 
   btSoftBody *softBody = GetSoftBody();
   if (softBody) {
-    btSoftRigidDynamicsWorld *world = GetPhysicsEnvironment()->GetDynamicsWorld();
+    btSoftRigidDynamicsWorld *world = GetPhysicsEnvironment()->GetSoftBodyWorld();
     // remove the old softBody
     world->removeSoftBody(softBody);
 
@@ -827,93 +881,52 @@ bool CcdPhysicsController::SynchronizeMotionStates(float time)
 
 void CcdPhysicsController::UpdateSoftBody()
 {
-  btSoftBody *sb = GetSoftBody();
-  if (sb && sb->getActivationState() != ISLAND_SLEEPING) {
-    if (sb->m_pose.m_bframe) {
-
-      RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
-
-      if (rasMesh) {
-        // Get other mesh data
-        Mesh *me = rasMesh->GetOrigMesh();
-        // I don't see how we could do without DerivedMesh...
-        DerivedMesh *dm = CDDM_from_mesh(me);
-
-        // Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
-        DM_ensure_tessface(dm);
-
-        const int *index_mf_to_mpoly = (const int *)dm->getTessFaceDataArray(dm, CD_ORIGINDEX);
-        const int *index_mp_to_orig = (const int *)dm->getPolyDataArray(dm, CD_ORIGINDEX);
-        if (!index_mf_to_mpoly) {
-          index_mp_to_orig = nullptr;
-        }
-
-        MVert *mverts = dm->getVertArray(dm);
-        MFace *mface = dm->getTessFaceArray(dm);
-        int numpolys = dm->getNumTessFaces(dm);
-
-        btSoftBody::tNodeArray &nodes(sb->m_nodes);
-        bContext *C = KX_GetActiveEngine()->GetContext();
-        Depsgraph *depsgraph = CTX_data_depsgraph_on_load(C);
-        Object *ob = DEG_get_evaluated_object(depsgraph, rasMesh->GetOriginalObject());
-
-        for (int p2 = 0; p2 < numpolys; p2++) {
-          MFace *mf = &mface[p2];
-          const int origi = index_mf_to_mpoly ?
-                                DM_origindex_mface_mpoly(index_mf_to_mpoly, index_mp_to_orig, p2) :
-                                p2;
-          RAS_Polygon *poly = (origi != ORIGINDEX_NONE) ? rasMesh->GetPolygon(origi) : nullptr;
-
-          // only add polygons that have the collisionflag set
-          if (poly) {
-            MVert *v1 = &mverts[mf->v1];
-            MVert *v2 = &mverts[mf->v2];
-            MVert *v3 = &mverts[mf->v3];
-
-            int i1 = poly->GetVertexInfo(0).getSoftBodyIndex();
-            int i2 = poly->GetVertexInfo(1).getSoftBodyIndex();
-            int i3 = poly->GetVertexInfo(2).getSoftBodyIndex();
-
-            MT_Vector3 p1 = ToMoto(nodes.at(i1).m_x - sb->m_pose.m_com);
-            MT_Vector3 p2 = ToMoto(nodes.at(i2).m_x - sb->m_pose.m_com);
-            MT_Vector3 p3 = ToMoto(nodes.at(i3).m_x - sb->m_pose.m_com);
-
-            MT_Vector3 n1 = ToMoto(nodes.at(i1).m_n);
-            MT_Vector3 n2 = ToMoto(nodes.at(i2).m_n);
-            MT_Vector3 n3 = ToMoto(nodes.at(i3).m_n);
-
-            // Do we need obmat? maybe
-            copy_v3_v3(v1->co, p1.getValue());
-            copy_v3_v3(v2->co, p2.getValue());
-            copy_v3_v3(v3->co, p3.getValue());
+  Mesh *me = GetSoftBodyUpdateMesh();
+  if (me) {
+    WriteSoftBodyVertices(me);
+    DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+  }
+}
 
-            normal_float_to_short_v3(v1->no, n1.getValue());
-            normal_float_to_short_v3(v2->no, n2.getValue());
-            normal_float_to_short_v3(v3->no, n3.getValue());
+Mesh *CcdPhysicsController::GetSoftBodyUpdateMesh()
+{
+  btSoftBody *sb = GetSoftBody();
+  if (!sb || sb->getActivationState() == ISLAND_SLEEPING || !sb->m_pose.m_bframe) {
+    return nullptr;
+  }
 
-            if (mf->v4) {
-              MVert *v4 = &mverts[mf->v4];
+  RAS_MeshObject *rasMesh = GetShapeInfo()->GetMesh();
+  if (!rasMesh) {
+    return nullptr;
+  }
 
-              int i4 = poly->GetVertexInfo(3).getSoftBodyIndex();
+  return rasMesh->GetOrigMesh();
+}
 
-              MT_Vector3 p4 = ToMoto(nodes.at(i4).m_x - sb->m_pose.m_com);
+void CcdPhysicsController::WriteSoftBodyVertices(Mesh *me)
+{
+  btSoftBody *sb = GetSoftBody();
+  const btSoftBody::tNodeArray &nodes = sb->m_nodes;
+  const btVector3 &com = sb->m_pose.m_com;
+  MVert *mverts = me->mvert;
+  const unsigned int totvert = me->totvert;
+
+  for (const SoftBodyVertex &sbvert : m_softBodyVertices) {
+    if (sbvert.m_vertex >= totvert) {
+      continue;
+    }
 
-              MT_Vector3 n4 = ToMoto(nodes.at(i4).m_n);
+    const btSoftBody::Node &node = nodes[sbvert.m_node];
+    MVert &mvert = mverts[sbvert.m_vertex];
 
-              copy_v3_v3(v4->co, p4.getValue());
+    // Do we need obmat? maybe
+    const btVector3 co = node.m_x - com;
+    mvert.co[0] = co.x();
+    mvert.co[1] = co.y();
+    mvert.co[2] = co.z();
 
-              normal_float_to_short_v3(v4->no, n4.getValue());
-            }
-          }
-        }
-        DM_to_mesh(dm,
-                   me,
-                   rasMesh->GetOriginalObject(),
-                   &CD_MASK_MESH,
-                   true);  // if take_ownership is true, dm is freed
-        DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
-      }
-    }
+    const float no[3] = {node.m_n.x(), node.m_n.y(), node.m_n.z()};
+    normal_float_to_short_v3(mvert.no, no);
   }
 }
 
@@ -1151,7 +1164,7 @@ void CcdPhysicsController::RefreshCollisions()
   if (IsPhysicsSuspended())
     return;
 
-  btSoftRigidDynamicsWorld *dw = GetPhysicsEnvironment()->GetDynamicsWorld();
+  btDiscreteDynamicsWorld *dw = GetPhysicsEnvironment()->GetDynamicsWorld();
   btBroadphaseProxy *proxy = m_object->getBroadphaseHandle();
   btDispatcher *dispatcher = dw->getDispatcher();
   btOverlappingPairCache *pairCache = dw->getPairCache();
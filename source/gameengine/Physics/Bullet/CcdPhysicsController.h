@@ -47,6 +47,7 @@ class CcdPhysicsController;
 class btMotionState;
 class RAS_MeshObject;
 struct DerivedMesh;
+struct Mesh;
 class btCollisionShape;
 
 #define CCD_BSB_SHAPE_MATCHING 2
@@ -566,8 +567,16 @@ class CcdPhysicsController : public PHY_IPhysicsController {
   /// needed when updating the controller
   friend class CcdPhysicsEnvironment;
 
+  /// Soft body node of an original mesh vertex.
+  struct SoftBodyVertex {
+    unsigned int m_vertex;
+    int m_node;
+  };
+
   // some book keeping for replication
   bool m_softbodyMappingDone;
+  /// Vertices of the original mesh driven by the soft body nodes, computed with the mapping.
+  std::vector<SoftBodyVertex> m_softBodyVertices;
   bool m_softBodyTransformInitialized;
   bool m_prototypeTransformInitialized;
   btTransform m_softbodyStartTrans;
@@ -666,6 +675,13 @@ class CcdPhysicsController : public PHY_IPhysicsController {
 
   virtual void UpdateSoftBody();
 
+  /// Return the mesh to update from the soft body nodes, nullptr if the soft body is not updated.
+  Mesh *GetSoftBodyUpdateMesh();
+  /** Write the soft body node positions and normals into the vertices of a mesh, this function
+   * doesn't tag the mesh for update and can be called from any thread.
+   */
+  void WriteSoftBodyVertices(Mesh *me);
+
   /**
    * Called for every physics simulation step. Use this method for
    * things like limiting linear and angular velocity.
@@ -22,20 +22,30 @@
 #include "CcdPhysicsEnvironment.h"
 
 
+#include "BKE_collection.h"
 #include "BKE_object.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "../depsgraph/DEG_depsgraph.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_force_types.h"
 #include "DNA_scene_types.h"
 
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "LinearMath/btThreads.h"
 
 #include "BL_BlenderSceneConverter.h"
 #include "CcdConstraint.h"
 #include "CcdGraphicController.h"
+#include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "KX_GameObject.h"
 #include "MT_MinMax.h"
 #include "PHY_IVehicle.h"
@@ -367,21 +377,26 @@ void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
 }
 
 CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
-                                             bool useDbvtCulling)
+                                             bool useDbvtCulling,
+                                             bool useThreading)
     : m_cullingCache(nullptr),
       m_cullingTree(nullptr),
       m_numIterations(10),
       m_numTimeSubSteps(1),
       m_solverType(PHY_SOLVER_NONE),
+      m_useThreading(useThreading),
       m_deactivationTime(2.0f),
       m_linearDeactivationThreshold(0.8f),
       m_angularDeactivationThreshold(1.0f),
       m_contactBreakingThreshold(0.02f),
+      m_subtickZoneStart(0.0),
       m_solver(nullptr),
       m_ownPairCache(nullptr),
       m_filterCallback(nullptr),
       m_ghostPairCallback(nullptr),
-      m_ownDispatcher(nullptr)
+      m_ownDispatcher(nullptr),
+      m_numUsedCollData(0),
+      m_numCollDataAllocations(0)
 {
   for (int i = 0; i < PHY_NUM_RESPONSE; i++) {
     m_triggerCallbacks[i] = nullptr;
@@ -389,7 +404,9 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
 
   m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
 
-  btCollisionDispatcher *dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+  btCollisionDispatcher *dispatcher = (m_useThreading) ?
+                                          new btCollisionDispatcherMt(m_collisionConfiguration) :
+                                          new btCollisionDispatcher(m_collisionConfiguration);
   btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
   m_ownDispatcher = dispatcher;
 
@@ -408,10 +425,21 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
   SetSolverType(solverType);  // issues with quickstep and memory allocations
   //	m_dynamicsWorld = new
   // btDiscreteDynamicsWorld(dispatcher,m_broadphase,m_solver,m_collisionConfiguration);
-  m_dynamicsWorld = new btSoftRigidDynamicsWorld(
-      dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+  if (m_useThreading) {
+    btConstraintSolverPoolMt *solverPool = static_cast<btConstraintSolverPoolMt *>(m_solver);
+    m_dynamicsWorld = new btDiscreteDynamicsWorldMt(
+        dispatcher, m_broadphase, solverPool, nullptr, m_collisionConfiguration);
+    m_softBodyWorld = nullptr;
+  }
+  else {
+    m_softBodyWorld = new btSoftRigidDynamicsWorld(
+        dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+    m_dynamicsWorld = m_softBodyWorld;
+  }
   m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback,
                                            this);
+  m_dynamicsWorld->setInternalTickCallback(
+      &CcdPhysicsEnvironment::StaticSimulationPreSubtickCallback, this, true);
   // m_dynamicsWorld->getSolverInfo().m_linearSlop = 0.01f;
   // m_dynamicsWorld->getSolverInfo().m_solverMode=	SOLVER_USE_WARMSTARTING +
   // SOLVER_USE_2_FRICTION_DIRECTIONS +	SOLVER_RANDMIZE_ORDER +	SOLVER_USE_FRICTION_WARMSTARTING;
@@ -456,7 +484,12 @@ void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
   else {
     if (ctrl->GetSoftBody()) {
       btSoftBody *softBody = ctrl->GetSoftBody();
-      m_dynamicsWorld->addSoftBody(softBody);
+      if (m_softBodyWorld) {
+        m_softBodyWorld->addSoftBody(softBody);
+      }
+      else {
+        CM_Warning("soft bodies are not supported with threaded physics, soft body ignored.");
+      }
     }
     else {
       if (obj->getCollisionShape()) {
@@ -589,7 +622,9 @@ bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctr
   else {
     // if a softbody
     if (ctrl->GetSoftBody()) {
-      m_dynamicsWorld->removeSoftBody(ctrl->GetSoftBody());
+      if (m_softBodyWorld) {
+        m_softBodyWorld->removeSoftBody(ctrl->GetSoftBody());
+      }
     }
     else {
       m_dynamicsWorld->removeCollisionObject(ctrl->GetCollisionObject());
@@ -625,7 +660,9 @@ void CcdPhysicsEnvironment::UpdateCcdPhysicsController(CcdPhysicsController *ctr
       m_dynamicsWorld->addRigidBody(body, newCollisionGroup, newCollisionMask);
     }
     else if (softBody) {
-      m_dynamicsWorld->addSoftBody(softBody);
+      if (m_softBodyWorld) {
+        m_softBodyWorld->addSoftBody(softBody);
+      }
     }
     else {
       m_dynamicsWorld->addCollisionObject(obj, newCollisionGroup, newCollisionMask);
@@ -710,6 +747,15 @@ void CcdPhysicsEnvironment::StaticSimulationSubtickCallback(btDynamicsWorld *wor
   // Get the pointer to the CcdPhysicsEnvironment associated with this Bullet world.
   CcdPhysicsEnvironment *this_ = static_cast<CcdPhysicsEnvironment *>(world->getWorldUserInfo());
   this_->SimulationSubtickCallback(timeStep);
+
+  CM_Profiler::Record("Physics Substep", this_->m_subtickZoneStart, CM_Profiler::GetTime());
+}
+
+void CcdPhysicsEnvironment::StaticSimulationPreSubtickCallback(btDynamicsWorld *world,
+                                                               btScalar UNUSED(timeStep))
+{
+  CcdPhysicsEnvironment *this_ = static_cast<CcdPhysicsEnvironment *>(world->getWorldUserInfo());
+  this_->m_subtickZoneStart = CM_Profiler::GetTime();
 }
 
 void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
@@ -761,12 +807,48 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
   return true;
 }
 
+struct SoftBodyUpdate {
+  Mesh *m_mesh;
+  CcdPhysicsController *m_controller;
+};
+
+static void update_soft_body_func(void *__restrict userdata,
+                                  const int iter,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SoftBodyUpdate &update = ((SoftBodyUpdate *)userdata)[iter];
+  update.m_controller->WriteSoftBodyVertices(update.m_mesh);
+}
+
 void CcdPhysicsEnvironment::UpdateSoftBodies()
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  /* Replicas of a soft body share the same mesh, only the last controller writes into a mesh
+   * to not write a mesh from several threads. */
+  std::map<Mesh *, CcdPhysicsController *> meshControllers;
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    Mesh *me = ctrl->GetSoftBodyUpdateMesh();
+    if (me) {
+      meshControllers[me] = ctrl;
+    }
+  }
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->UpdateSoftBody();
+  if (meshControllers.empty()) {
+    return;
+  }
+
+  std::vector<SoftBodyUpdate> updates;
+  updates.reserve(meshControllers.size());
+  for (const std::pair<Mesh *const, CcdPhysicsController *> &pair : meshControllers) {
+    updates.push_back({pair.first, pair.second});
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (updates.size() > 1);
+  BLI_task_parallel_range(0, updates.size(), updates.data(), update_soft_body_func, &settings);
+
+  for (const SoftBodyUpdate &update : updates) {
+    DEG_id_tag_update(&update.m_mesh->id, ID_RECALC_GEOMETRY);
   }
 }
 
@@ -1015,21 +1097,37 @@ void CcdPhysicsEnvironment::SetSolverType(PHY_SolverType solverType)
     return;
   }
 
+  if (m_useThreading) {
+    // Each island solved in parallel uses a solver of the pool.
+    const int numSolvers = BLI_system_thread_count();
+    std::vector<btConstraintSolver *> solvers(numSolvers);
+    for (btConstraintSolver *&solver : solvers) {
+      solver = CreateConstraintSolver(solverType);
+    }
+    m_solver = new btConstraintSolverPoolMt(solvers.data(), numSolvers);
+  }
+  else {
+    m_solver = CreateConstraintSolver(solverType);
+  }
+  m_solverType = solverType;
+}
+
+btConstraintSolver *CcdPhysicsEnvironment::CreateConstraintSolver(PHY_SolverType solverType)
+{
   switch (solverType) {
     case PHY_SOLVER_SEQUENTIAL: {
-      m_solver = new btSequentialImpulseConstraintSolver();
-      break;
+      return new btSequentialImpulseConstraintSolver();
     }
 
     case PHY_SOLVER_NNCG: {
-      m_solver = new btNNCGConstraintSolver();
-      break;
+      return new btNNCGConstraintSolver();
     }
     default: {
       BLI_assert(false);
     }
   };
-  m_solverType = solverType;
+
+  return nullptr;
 }
 
 void CcdPhysicsEnvironment::GetGravity(MT_Vector3 &grav)
@@ -1044,7 +1142,9 @@ void CcdPhysicsEnvironment::SetGravity(float x, float y, float z)
 {
   m_gravity = btVector3(x, y, z);
   m_dynamicsWorld->setGravity(m_gravity);
-  m_dynamicsWorld->getWorldInfo().m_gravity.setValue(x, y, z);
+  if (m_softBodyWorld) {
+    m_softBodyWorld->getWorldInfo().m_gravity.setValue(x, y, z);
+  }
 }
 
 static int gConstraintUid = 1;
@@ -1324,6 +1424,177 @@ PHY_IPhysicsController *CcdPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallbac
   return result.m_controller;
 }
 
+/// Filter of the queries of RayTestBatch, the same as FilterClosestRayResultCallback.
+static bool BatchNeedsCollision(PHY_IRayCastFilterCallback &phyRayFilter,
+                                btBroadphaseProxy *proxy0,
+                                short int collisionFilterGroup,
+                                short int collisionFilterMask)
+{
+  if (!(proxy0->m_collisionFilterGroup & collisionFilterMask))
+    return false;
+  if (!(collisionFilterGroup & proxy0->m_collisionFilterMask))
+    return false;
+  btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
+  CcdPhysicsController *phyCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
+  if (phyCtrl == phyRayFilter.m_ignoreController)
+    return false;
+  return phyRayFilter.needBroadphaseRayCast(phyCtrl);
+}
+
+struct BatchRayResultCallback : public btCollisionWorld::ClosestRayResultCallback {
+  PHY_IRayCastFilterCallback &m_phyRayFilter;
+
+  BatchRayResultCallback(PHY_IRayCastFilterCallback &phyRayFilter,
+                         const btVector3 &rayFrom,
+                         const btVector3 &rayTo)
+      : btCollisionWorld::ClosestRayResultCallback(rayFrom, rayTo), m_phyRayFilter(phyRayFilter)
+  {
+  }
+
+  virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+  {
+    return BatchNeedsCollision(
+        m_phyRayFilter, proxy0, m_collisionFilterGroup, m_collisionFilterMask);
+  }
+};
+
+struct BatchConvexResultCallback : public btCollisionWorld::ClosestConvexResultCallback {
+  PHY_IRayCastFilterCallback &m_phyRayFilter;
+
+  BatchConvexResultCallback(PHY_IRayCastFilterCallback &phyRayFilter,
+                            const btVector3 &rayFrom,
+                            const btVector3 &rayTo)
+      : btCollisionWorld::ClosestConvexResultCallback(rayFrom, rayTo),
+        m_phyRayFilter(phyRayFilter)
+  {
+  }
+
+  virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+  {
+    return BatchNeedsCollision(
+        m_phyRayFilter, proxy0, m_collisionFilterGroup, m_collisionFilterMask);
+  }
+};
+
+struct RayTestBatchData {
+  btCollisionWorld *world;
+  PHY_IRayCastFilterCallback *filterCallback;
+  const PHY_RayCastQuery *queries;
+  PHY_RayCastQueryResult *results;
+};
+
+static void RayTestBatchFunc(void *__restrict userdata,
+                             const int iter,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RayTestBatchData *data = (RayTestBatchData *)userdata;
+  const PHY_RayCastQuery &query = data->queries[iter];
+  PHY_RayCastQueryResult &result = data->results[iter];
+
+  const btVector3 from = ToBullet(query.m_from);
+  const btVector3 to = ToBullet(query.m_to);
+  // don't collision with sensor object
+  const short int mask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
+
+  const btCollisionObject *hitObject = nullptr;
+  btVector3 hitPoint;
+  btVector3 hitNormal;
+  btScalar hitFraction;
+
+  if (query.m_radius > 0.0f) {
+    BatchConvexResultCallback callback(*data->filterCallback, from, to);
+    callback.m_collisionFilterMask = mask;
+
+    const btSphereShape shape(query.m_radius);
+    const btTransform fromTrans(btMatrix3x3::getIdentity(), from);
+    const btTransform toTrans(btMatrix3x3::getIdentity(), to);
+    data->world->convexSweepTest(&shape, fromTrans, toTrans, callback);
+
+    if (callback.hasHit()) {
+      hitObject = callback.m_hitCollisionObject;
+      hitPoint = callback.m_hitPointWorld;
+      hitNormal = callback.m_hitNormalWorld;
+      hitFraction = callback.m_closestHitFraction;
+    }
+  }
+  else {
+    BatchRayResultCallback callback(*data->filterCallback, from, to);
+    callback.m_collisionFilterMask = mask;
+    // use faster (less accurate) ray callback, works better with 0 collision margins
+    callback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
+    data->world->rayTest(from, to, callback);
+
+    if (callback.hasHit()) {
+      hitObject = callback.m_collisionObject;
+      hitPoint = callback.m_hitPointWorld;
+      hitNormal = callback.m_hitNormalWorld;
+      hitFraction = callback.m_closestHitFraction;
+    }
+  }
+
+  if (!hitObject) {
+    result.m_controller = nullptr;
+    return;
+  }
+
+  if (hitNormal.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
+    hitNormal.normalize();
+  }
+  else {
+    hitNormal.setValue(1.0f, 0.0f, 0.0f);
+  }
+
+  result.m_controller = static_cast<CcdPhysicsController *>(hitObject->getUserPointer());
+  result.m_hitPoint = ToMoto(hitPoint);
+  result.m_hitNormal = ToMoto(hitNormal);
+  result.m_hitFraction = hitFraction;
+}
+
+/// Return true if a shape is or contains a GImpact shape.
+static bool HasGImpactShape(const btCollisionShape *shape)
+{
+  if (shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE) {
+    return true;
+  }
+  if (shape->isCompound()) {
+    const btCompoundShape *compoundShape = static_cast<const btCompoundShape *>(shape);
+    for (int i = 0, size = compoundShape->getNumChildShapes(); i < size; ++i) {
+      if (HasGImpactShape(compoundShape->getChildShape(i))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void CcdPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                                         const PHY_RayCastQuery *queries,
+                                         PHY_RayCastQueryResult *results,
+                                         unsigned int count)
+{
+  CM_ProfileZone zone("Ray Test Batch");
+
+  /* The world is only read, the broadphase uses a stack per thread for ray tests
+   * as Bullet is built thread safe. */
+  RayTestBatchData data = {m_dynamicsWorld, &filterCallback, queries, results};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 32;
+
+  /* GImpact shapes lock their child shapes with an unprotected counter during a test,
+   * the queries are then run serially. */
+  const btCollisionObjectArray &objects = m_dynamicsWorld->getCollisionObjectArray();
+  for (int i = 0, size = objects.size(); i < size; ++i) {
+    if (HasGImpactShape(objects[i]->getCollisionShape())) {
+      settings.use_threading = false;
+      break;
+    }
+  }
+
+  BLI_task_parallel_range(0, count, &data, RayTestBatchFunc, &settings);
+}
+
 // Handles occlusion culling.
 // The implementation is based on the CDTestFramework
 struct OcclusionBuffer {
@@ -2024,6 +2295,10 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
   if (nullptr != m_broadphase)
     delete m_broadphase;
 
+  for (CcdCollData *collData : m_collDataPool) {
+    delete collData;
+  }
+
   if (nullptr != m_cullingTree)
     delete m_cullingTree;
 
@@ -2072,6 +2347,28 @@ void CcdPhysicsEnvironment::AddCollisionCallback(int response_class,
   m_triggerCallbacks[response_class] = callback;
   m_triggerCallbacksUserPtrs[response_class] = user;
 }
+CcdCollData *CcdPhysicsEnvironment::NewCollData(const btPersistentManifold *manifold)
+{
+  if (m_numUsedCollData == m_collDataPool.size()) {
+    m_collDataPool.push_back(new CcdCollData(manifold));
+    ++m_numCollDataAllocations;
+  }
+
+  CcdCollData *collData = m_collDataPool[m_numUsedCollData++];
+  collData->SetManifold(manifold);
+  return collData;
+}
+
+void CcdPhysicsEnvironment::ReleaseCollData()
+{
+  m_numUsedCollData = 0;
+}
+
+unsigned int CcdPhysicsEnvironment::GetNumCollDataAllocations() const
+{
+  return m_numCollDataAllocations;
+}
+
 bool CcdPhysicsEnvironment::RequestCollisionCallback(PHY_IPhysicsController *ctrl)
 {
   CcdPhysicsController *ccdCtrl = static_cast<CcdPhysicsController *>(ctrl);
@@ -2083,6 +2380,8 @@ void CcdPhysicsEnvironment::CallbackTriggers()
   bool draw_contact_points = m_debugDrawer &&
                              (m_debugDrawer->getDebugMode() & btIDebugDraw::DBG_DrawContactPoints);
 
+  m_numCollDataAllocations = 0;
+
   if (!m_triggerCallbacks[PHY_OBJECT_RESPONSE] && !draw_contact_points)
     return;
 
@@ -2124,7 +2423,7 @@ void CcdPhysicsEnvironment::CallbackTriggers()
     }
 
     if (usecallback) {
-      const CcdCollData *coll_data = new CcdCollData(manifold);
+      const CcdCollData *coll_data = NewCollData(manifold);
 
       m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
                                               colliding_ctrl0 ? ctrl0 : ctrl1,
@@ -2733,6 +3032,156 @@ struct BlenderDebugDraw : public btIDebugDraw {
   }
 };
 
+/** Bullet task scheduler running the parallel loops of the multithreaded world
+ * in the Blender task scheduler.
+ */
+class BlenderTaskScheduler : public btITaskScheduler {
+ private:
+  struct ForData {
+    const btIParallelForBody *body;
+    int begin;
+    int end;
+    int grainSize;
+  };
+
+  struct SumData {
+    const btIParallelSumBody *body;
+    int begin;
+    int end;
+    int grainSize;
+    btScalar *sums;
+  };
+
+  static void ForFunc(void *__restrict userdata,
+                      const int iter,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
+  {
+    const ForData *data = (ForData *)userdata;
+    const int begin = data->begin + iter * data->grainSize;
+    data->body->forLoop(begin, std::min(begin + data->grainSize, data->end));
+  }
+
+  static void SumFunc(void *__restrict userdata,
+                      const int iter,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
+  {
+    SumData *data = (SumData *)userdata;
+    const int begin = data->begin + iter * data->grainSize;
+    data->sums[iter] = data->body->sumLoop(begin, std::min(begin + data->grainSize, data->end));
+  }
+
+  static int GetNumChunks(int begin, int end, int grainSize)
+  {
+    return (end - begin + grainSize - 1) / grainSize;
+  }
+
+  static TaskParallelSettings GetSettings()
+  {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    // The chunks are already sized by Bullet.
+    settings.min_iter_per_thread = 1;
+    return settings;
+  }
+
+ public:
+  BlenderTaskScheduler() : btITaskScheduler("Blender")
+  {
+  }
+
+  /* The collision dispatcher allocates data per thread index returned by
+   * btGetCurrentThreadIndex, which is unique for any thread running a task as long as the
+   * thread count is under BT_MAX_THREAD_COUNT (checked in InitTaskScheduler),
+   * so the maximum number of threads is always reported. */
+  virtual int getMaxNumThreads() const
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+
+  virtual int getNumThreads() const
+  {
+    return BT_MAX_THREAD_COUNT;
+  }
+
+  virtual void setNumThreads(int UNUSED(numThreads))
+  {
+  }
+
+  virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body)
+  {
+    grainSize = std::max(grainSize, 1);
+    const int numChunks = GetNumChunks(iBegin, iEnd, grainSize);
+    if (numChunks <= 1) {
+      body.forLoop(iBegin, iEnd);
+      return;
+    }
+
+    ForData data = {&body, iBegin, iEnd, grainSize};
+    TaskParallelSettings settings = GetSettings();
+    BLI_task_parallel_range(0, numChunks, &data, ForFunc, &settings);
+  }
+
+  virtual btScalar parallelSum(int iBegin,
+                               int iEnd,
+                               int grainSize,
+                               const btIParallelSumBody &body)
+  {
+    grainSize = std::max(grainSize, 1);
+    const int numChunks = GetNumChunks(iBegin, iEnd, grainSize);
+    if (numChunks <= 1) {
+      return body.sumLoop(iBegin, iEnd);
+    }
+
+    std::vector<btScalar> sums(numChunks);
+    SumData data = {&body, iBegin, iEnd, grainSize, sums.data()};
+    TaskParallelSettings settings = GetSettings();
+    BLI_task_parallel_range(0, numChunks, &data, SumFunc, &settings);
+
+    // Sum in a fixed order to keep the result deterministic.
+    btScalar sum = 0.0f;
+    for (btScalar chunkSum : sums) {
+      sum += chunkSum;
+    }
+    return sum;
+  }
+};
+
+static BlenderTaskScheduler taskScheduler;
+
+void CcdPhysicsEnvironment::InitTaskScheduler()
+{
+  if (btGetTaskScheduler() == &taskScheduler) {
+    return;
+  }
+
+  // Bullet only accepts a task scheduler from its main thread, the first one calling it.
+  if (!btIsMainThread()) {
+    return;
+  }
+
+  /* Bullet indexes its per thread data by a thread index, the indices wrap around past
+   * BT_MAX_THREAD_COUNT. The main thread and all the workers must fit. */
+  if (BLI_system_thread_count() >= (int)BT_MAX_THREAD_COUNT) {
+    return;
+  }
+
+  btSetTaskScheduler(&taskScheduler);
+}
+
+static bool SceneHasSoftBody(Scene *blenderscene)
+{
+  bool found = false;
+  FOREACH_SCENE_OBJECT_BEGIN (blenderscene, ob) {
+    if (ob->gameflag & OB_SOFT_BODY) {
+      found = true;
+      break;
+    }
+  }
+  FOREACH_SCENE_OBJECT_END;
+
+  return found;
+}
+
 CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics)
 {
 
@@ -2740,8 +3189,25 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
       PHY_SOLVER_SEQUENTIAL,    // GAME_SOLVER_SEQUENTIAL
       PHY_SOLVER_NNCG,          // GAME_SOLVER_NNGC
   };
+
+  bool useThreading = (blenderscene->gm.flag & GAME_USE_THREADED_PHYSICS);
+  if (useThreading) {
+    if (SceneHasSoftBody(blenderscene)) {
+      CM_Warning("scene \"" << (blenderscene->id.name + 2)
+                            << "\" uses soft bodies, threaded physics disabled.");
+      useThreading = false;
+    }
+    else if (btGetTaskScheduler() != &taskScheduler) {
+      CM_Warning("scene \"" << (blenderscene->id.name + 2)
+                            << "\" can't use threaded physics with more than "
+                            << (BT_MAX_THREAD_COUNT - 1)
+                            << " threads or outside of the main thread, disabled.");
+      useThreading = false;
+    }
+  }
+
   CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment(
-      solverTypeTable[blenderscene->gm.solverType], false);
+      solverTypeTable[blenderscene->gm.solverType], false, useThreading);
   ccdPhysEnv->SetDebugDrawer(new BlenderDebugDraw());
   ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
   ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
@@ -2797,6 +3263,13 @@ void CcdPhysicsEnvironment::ConvertObject(BL_BlenderSceneConverter *converter,
     isbulletsoftbody = false;
   }
 
+  // Objects added by LibLoad to a scene using the multithreaded world.
+  if (isbulletsoftbody && !m_softBodyWorld) {
+    CM_Warning("object \"" << gameobj->GetName()
+                           << "\" is a soft body, not supported with threaded physics.");
+    isbulletsoftbody = false;
+  }
+
   if (!isbulletdyna) {
     ci.m_collisionFlags |= btCollisionObject::CF_STATIC_OBJECT;
   }
@@ -3330,6 +3803,11 @@ CcdCollData::~CcdCollData()
 {
 }
 
+void CcdCollData::SetManifold(const btPersistentManifold *manifoldPoint)
+{
+  m_manifoldPoint = manifoldPoint;
+}
+
 unsigned int CcdCollData::GetNumContacts() const
 {
   return m_manifoldPoint->getNumContacts();
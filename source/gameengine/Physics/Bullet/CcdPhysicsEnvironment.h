@@ -52,6 +52,7 @@ class PHY_IVehicle;
 class CcdGraphicController;
 class CcdOverlapFilterCallBack;
 class CcdShapeConstructionInfo;
+class CcdCollData;
 
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional
  * continuous collision detection. Physics Environment takes care of stepping the simulation and is
@@ -89,17 +90,21 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   int m_numTimeSubSteps;
 
   PHY_SolverType m_solverType;
+  /// Use the multithreaded world, it doesn't support soft bodies.
+  bool m_useThreading;
 
   float m_deactivationTime;
   float m_linearDeactivationThreshold;
   float m_angularDeactivationThreshold;
   float m_contactBreakingThreshold;
 
+  /// Start time of the current simulation tick zone of the profiler.
+  double m_subtickZoneStart;
+
   void ProcessFhSprings(double curTime, float timeStep);
 
  public:
-  CcdPhysicsEnvironment(PHY_SolverType solverType,
-                        bool useDbvtCulling);
+  CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling, bool useThreading);
 
   virtual ~CcdPhysicsEnvironment();
 
@@ -144,6 +149,8 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
    * the btDynamicsWorld::getWorldUserInfo() pointer.
    */
   static void StaticSimulationSubtickCallback(btDynamicsWorld *world, btScalar timeStep);
+  /// Called by Bullet before every physical simulation (sub)tick to start its profiler zone.
+  static void StaticSimulationPreSubtickCallback(btDynamicsWorld *world, btScalar timeStep);
   void SimulationSubtickCallback(btScalar timeStep);
 
   virtual void DebugDrawWorld();
@@ -188,6 +195,8 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   virtual float getAppliedImpulse(int constraintid);
 
   virtual void CallbackTriggers();
+  virtual void ReleaseCollData();
+  virtual unsigned int GetNumCollDataAllocations() const;
 
   // complex constraint for vehicles
   virtual PHY_IVehicle *GetVehicleConstraint(int constraintId);
@@ -203,6 +212,10 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                           float toX,
                                           float toY,
                                           float toZ);
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const PHY_RayCastQuery *queries,
+                            PHY_RayCastQueryResult *results,
+                            unsigned int count);
   virtual bool CullingTest(PHY_CullingCallback callback,
                            void *userData,
                            const std::array<MT_Vector4, 6> &planes,
@@ -273,16 +286,27 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   void SyncMotionStates(float timeStep);
 
-  class btSoftRigidDynamicsWorld *GetDynamicsWorld()
+  class btDiscreteDynamicsWorld *GetDynamicsWorld()
   {
     return m_dynamicsWorld;
   }
 
+  /// Return the world supporting soft bodies, nullptr for the multithreaded world.
+  class btSoftRigidDynamicsWorld *GetSoftBodyWorld()
+  {
+    return m_softBodyWorld;
+  }
+
   class btConstraintSolver *GetConstraintSolver();
 
   void MergeEnvironment(PHY_IPhysicsEnvironment *other_env);
 
   static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics);
+  /** Install the task scheduler used by the threaded physics. Must be called from the main
+   * thread before any physics environment is created, Bullet gives the thread index 0 to the
+   * first thread using it and only accepts a task scheduler from this thread.
+   */
+  static void InitTaskScheduler();
 
   virtual void ConvertObject(BL_BlenderSceneConverter *converter,
                              KX_GameObject *gameobj,
@@ -306,6 +330,16 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
   void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
 
+  /// Collision datas given to the collision callbacks, reused once released.
+  std::vector<CcdCollData *> m_collDataPool;
+  /// Number of collision datas of the pool used since the last release.
+  unsigned int m_numUsedCollData;
+  /// Number of collision datas allocated during the last call to CallbackTriggers.
+  unsigned int m_numCollDataAllocations;
+
+  /// Return a collision data for manifold from the pool, allocating it when the pool is empty.
+  CcdCollData *NewCollData(const btPersistentManifold *manifold);
+
   std::vector<WrapperVehicle *> m_wrapperVehicles;
 
   /** use explicit btSoftRigidDynamicsWorld/btDiscreteDynamicsWorld* so that we have access to
@@ -315,10 +349,15 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
    * Ideally we would like to have access to this function from the btDynamicsWorld interface
    */
   // class btDynamicsWorld *m_dynamicsWorld;
-  class btSoftRigidDynamicsWorld *m_dynamicsWorld;
+  class btDiscreteDynamicsWorld *m_dynamicsWorld;
+  /// The same world as m_dynamicsWorld when it supports soft bodies, else nullptr.
+  class btSoftRigidDynamicsWorld *m_softBodyWorld;
 
+  /// The constraint solver or the solver pool of the multithreaded world.
   class btConstraintSolver *m_solver;
 
+  btConstraintSolver *CreateConstraintSolver(PHY_SolverType solverType);
+
   class btOverlappingPairCache *m_ownPairCache;
 
   class CcdOverlapFilterCallBack *m_filterCallback;
@@ -337,6 +376,8 @@ class CcdCollData : public PHY_CollData {
   CcdCollData(const btPersistentManifold *manifoldPoint);
   virtual ~CcdCollData();
 
+  void SetManifold(const btPersistentManifold *manifoldPoint);
+
   virtual unsigned int GetNumContacts() const;
   virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
   virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
@@ -99,6 +99,25 @@ class PHY_IRayCastFilterCallback {
   }
 };
 
+/**
+ * A query of RayTestBatch, a ray when m_radius is zero, else a sphere sweep.
+ */
+struct PHY_RayCastQuery {
+  MT_Vector3 m_from;
+  MT_Vector3 m_to;
+  float m_radius;
+};
+
+/**
+ * Closest hit of a query of RayTestBatch, m_controller is nullptr if nothing was hit.
+ */
+struct PHY_RayCastQueryResult {
+  PHY_IPhysicsController *m_controller;
+  MT_Vector3 m_hitPoint;
+  MT_Vector3 m_hitNormal;
+  float m_hitFraction;
+};
+
 /**
  * Physics Environment takes care of stepping the simulation and is a container for physics
  * entities (rigidbodies,constraints, materials etc.) A derived class may be able to 'construct'
@@ -229,6 +248,17 @@ class PHY_IPhysicsEnvironment {
                                           float toY,
                                           float toZ) = 0;
 
+  /** Compute the closest hit of several independent queries, the queries can be run in
+   * parallel and must not be called during a physics step.
+   * \param filterCallback Filter of the tested controllers, called from several threads,
+   * its reportHit function is not used.
+   * \param results The array receiving one result per query.
+   */
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const PHY_RayCastQuery *queries,
+                            PHY_RayCastQueryResult *results,
+                            unsigned int count) = 0;
+
   // culling based on physical broad phase
   // the plane number must be set as follow: near, far, left, right, top, botton
   // the near plane must be the first one and must always be present, it is used to get the
@@ -248,6 +278,15 @@ class PHY_IPhysicsEnvironment {
                                     void *user) = 0;
   virtual bool RequestCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
   virtual bool RemoveCollisionCallback(PHY_IPhysicsController *ctrl) = 0;
+  /// Give back the collision datas sent to the collision callbacks, they must not be used anymore.
+  virtual void ReleaseCollData()
+  {
+  }
+  /// Number of collision datas allocated during the last physics tick.
+  virtual unsigned int GetNumCollDataAllocations() const
+  {
+    return 0;
+  }
   // These two methods are *solely* used to create controllers for sensor! Don't use for anything
   // else
   virtual PHY_IPhysicsController *CreateSphereController(float radius,
@@ -123,3 +123,13 @@ PHY_IPhysicsController *DummyPhysicsEnvironment::RayTest(
   // collision detection / raytesting
   return nullptr;
 }
+
+void DummyPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                                           const PHY_RayCastQuery *queries,
+                                           PHY_RayCastQueryResult *results,
+                                           unsigned int count)
+{
+  for (unsigned int i = 0; i < count; ++i) {
+    results[i].m_controller = nullptr;
+  }
+}
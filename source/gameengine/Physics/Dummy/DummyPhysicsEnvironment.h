@@ -98,6 +98,10 @@ class DummyPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                           float toX,
                                           float toY,
                                           float toZ);
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const PHY_RayCastQuery *queries,
+                            PHY_RayCastQueryResult *results,
+                            unsigned int count);
   virtual bool CullingTest(PHY_CullingCallback callback,
                            void *userData,
                            const std::array<MT_Vector4, 6> &planes,
@@ -160,6 +160,11 @@ void RAS_DebugDraw::Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas)
 
   m_impl->Flush(rasty, canvas, this);
 
+  Clear();
+}
+
+void RAS_DebugDraw::Clear()
+{
   m_lines.clear();
   m_circles.clear();
   m_aabbs.clear();
@@ -153,6 +153,8 @@ class RAS_DebugDraw {
   void RenderText2D(const std::string &text, const MT_Vector2 &pos, const MT_Vector4 &color);
 
   void Flush(RAS_Rasterizer *rasty, RAS_ICanvas *canvas);
+  /// Remove all the shapes without drawing them.
+  void Clear();
 };
 
 #endif  // __RAS_DEBUG_DRAW_H__
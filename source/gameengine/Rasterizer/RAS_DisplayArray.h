@@ -116,6 +116,22 @@ template<class Vertex> class RAS_DisplayArray : public virtual RAS_IDisplayArray
     m_vertexes.push_back(*((Vertex *)vert));
   }
 
+  virtual unsigned int AddVertex(const MT_Vector3 &xyz,
+                                 const MT_Vector2 *const uvs,
+                                 const MT_Vector4 &tangent,
+                                 const unsigned int *rgba,
+                                 const MT_Vector3 &normal)
+  {
+    m_vertexes.emplace_back(xyz, uvs, tangent, rgba, normal);
+    return m_vertexes.size() - 1;
+  }
+
+  virtual void Reserve(unsigned int numVertices, unsigned int numIndices)
+  {
+    RAS_IDisplayArray::Reserve(numVertices, numIndices);
+    m_vertexes.reserve(numVertices);
+  }
+
   virtual unsigned int GetVertexCount() const
   {
     return m_vertexes.size();
@@ -97,6 +97,12 @@ int RAS_IDisplayArray::GetOpenGLPrimitiveType() const
   return 0;
 }
 
+void RAS_IDisplayArray::Reserve(unsigned int numVertices, unsigned int numIndices)
+{
+  m_vertexInfos.reserve(numVertices);
+  m_indices.reserve(numIndices);
+}
+
 void RAS_IDisplayArray::UpdateFrom(RAS_IDisplayArray *other, int flag)
 {
   if (flag & TANGENT_MODIFIED) {
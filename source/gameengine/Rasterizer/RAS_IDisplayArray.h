@@ -111,6 +111,21 @@ class RAS_IDisplayArray {
 
   virtual void AddVertex(RAS_IVertex *vert) = 0;
 
+  /** Construct a new vertex directly at the end of the vertex storage.
+   * \return The index of the new vertex.
+   */
+  virtual unsigned int AddVertex(const MT_Vector3 &xyz,
+                                 const MT_Vector2 *const uvs,
+                                 const MT_Vector4 &tangent,
+                                 const unsigned int *rgba,
+                                 const MT_Vector3 &normal) = 0;
+
+  /** Reserve memory for vertices and indices, used before a bulk conversion.
+   * \param numVertices The total number of vertices expected.
+   * \param numIndices The total number of indices expected.
+   */
+  virtual void Reserve(unsigned int numVertices, unsigned int numIndices);
+
   inline void AddIndex(const unsigned int index)
   {
     m_indices.push_back(index);
@@ -64,6 +64,13 @@ RAS_DisplayArrayBucket *RAS_MeshMaterial::GetDisplayArrayBucket() const
   return m_displayArrayBucket;
 }
 
+RAS_IDisplayArray *RAS_MeshMaterial::ReleaseDisplayArray()
+{
+  RAS_IDisplayArray *array = m_displayArray;
+  m_displayArray = nullptr;
+  return array;
+}
+
 void RAS_MeshMaterial::ReplaceMaterial(RAS_MaterialBucket *bucket)
 {
   // Avoid replacing the by the same material bucket.
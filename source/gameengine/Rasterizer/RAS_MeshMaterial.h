@@ -64,6 +64,8 @@ class RAS_MeshMaterial {
   RAS_MaterialBucket *GetBucket() const;
   RAS_IDisplayArray *GetDisplayArray() const;
   RAS_DisplayArrayBucket *GetDisplayArrayBucket() const;
+  /// Give the ownership of the display array to the caller, it is not deleted with the material.
+  RAS_IDisplayArray *ReleaseDisplayArray();
 
   void ReplaceMaterial(RAS_MaterialBucket *bucket);
 };
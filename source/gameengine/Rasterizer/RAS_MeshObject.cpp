@@ -177,6 +177,11 @@ RAS_Polygon *RAS_MeshObject::AddPolygon(RAS_MeshMaterial *meshmat,
   return &m_polygons.back();
 }
 
+void RAS_MeshObject::ReservePolygons(unsigned int numpolys)
+{
+  m_polygons.reserve(numpolys);
+}
+
 unsigned int RAS_MeshObject::AddVertex(RAS_MeshMaterial *meshmat,
                                        const MT_Vector3 &xyz,
                                        const MT_Vector2 *const uvs,
@@ -132,6 +132,8 @@ class RAS_MeshObject {
                                   bool visible,
                                   bool collider,
                                   bool twoside);
+  /// Reserve memory for polygons added by a bulk conversion.
+  void ReservePolygons(unsigned int numpolys);
   virtual unsigned int AddVertex(RAS_MeshMaterial *meshmat,
                                  const MT_Vector3 &xyz,
                                  const MT_Vector2 *const uvs,
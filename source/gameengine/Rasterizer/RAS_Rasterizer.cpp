@@ -167,7 +167,7 @@ RAS_Rasterizer::RAS_Rasterizer()
 {
   m_impl.reset(new RAS_OpenGLRasterizer(this));
 
-  m_numgllights = m_impl->GetNumLights();
+  m_numgllights = 0;
 }
 
 RAS_Rasterizer::~RAS_Rasterizer()
@@ -262,6 +262,9 @@ void RAS_Rasterizer::Init(RAS_ICanvas *canvas)
   //SetColorMask(true, true, true, true);
   GPU_color_mask(true, true, true, true);
 
+  // Queried here and not at construction as it needs a GL context.
+  m_numgllights = m_impl->GetNumLights();
+
   /* Here we set RAS_FrameBuffers width and height very early in ge launching process
    * Note that if we want to resize RAS_FrameBuffers, this method must be called
    * But other things would need to be resized too with eevee (GPUViewport and
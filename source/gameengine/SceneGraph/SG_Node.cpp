@@ -50,6 +50,7 @@ SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks &callbacks)
       m_worldPosition(0.0f, 0.0f, 0.0f),
       m_worldRotation(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f),
       m_worldScaling(1.0f, 1.0f, 1.0f),
+      m_prevWorldTransformValid(false),
       m_parent_relation(nullptr),
       m_familly(new SG_Familly()),
       m_modified(true),
@@ -70,6 +71,7 @@ SG_Node::SG_Node(const SG_Node &other)
       m_worldPosition(other.m_worldPosition),
       m_worldRotation(other.m_worldRotation),
       m_worldScaling(other.m_worldScaling),
+      m_prevWorldTransformValid(false),
       m_parent_relation(other.m_parent_relation->NewCopy()),
       m_familly(new SG_Familly()),
       m_dirty(DIRTY_NONE)
@@ -312,6 +314,28 @@ SG_Node *SG_Node::GetNextScheduled(SG_QList &head)
   return result;
 }
 
+void SG_Node::GetScheduledNodes(SG_QList &head, NodeList &nodes)
+{
+  scheduleMutex.Lock();
+  SG_DList::iterator<SG_Node> it(head);
+  for (it.begin(); !it.end(); ++it) {
+    nodes.push_back(*it);
+  }
+  scheduleMutex.Unlock();
+}
+
+void SG_Node::UpdateScheduledWorldData(double time)
+{
+  scheduleMutex.Lock();
+  // The node is removed from the list when its parent updates it.
+  const bool scheduled = !Empty();
+  scheduleMutex.Unlock();
+
+  if (scheduled) {
+    UpdateWorldDataThreadSchedule(time);
+  }
+}
+
 bool SG_Node::Reschedule(SG_QList &head)
 {
   scheduleMutex.Lock();
@@ -560,6 +584,42 @@ MT_Transform SG_Node::GetWorldTransform() const
       m_worldRotation.scaled(m_worldScaling[0], m_worldScaling[1], m_worldScaling[2]));
 }
 
+void SG_Node::StorePreviousWorldTransform()
+{
+  m_prevWorldPosition = m_worldPosition;
+  m_prevWorldRotation = m_worldRotation.getRotation();
+  m_prevWorldScaling = m_worldScaling;
+  m_prevWorldTransformValid = true;
+}
+
+MT_Vector3 SG_Node::GetInterpolatedWorldPosition(float factor) const
+{
+  if (!m_prevWorldTransformValid || factor >= 1.0f) {
+    return m_worldPosition;
+  }
+  return m_prevWorldPosition.lerp(m_worldPosition, factor);
+}
+
+MT_Matrix3x3 SG_Node::GetInterpolatedWorldOrientation(float factor) const
+{
+  if (!m_prevWorldTransformValid || factor >= 1.0f) {
+    return m_worldRotation;
+  }
+  return MT_Matrix3x3(m_prevWorldRotation.slerp(m_worldRotation.getRotation(), factor));
+}
+
+MT_Transform SG_Node::GetInterpolatedWorldTransform(float factor) const
+{
+  if (!m_prevWorldTransformValid || factor >= 1.0f) {
+    return GetWorldTransform();
+  }
+
+  const MT_Vector3 scale = m_prevWorldScaling.lerp(m_worldScaling, factor);
+  return MT_Transform(
+      GetInterpolatedWorldPosition(factor),
+      GetInterpolatedWorldOrientation(factor).scaled(scale[0], scale[1], scale[2]));
+}
+
 MT_Transform SG_Node::GetLocalTransform() const
 {
   return MT_Transform(
@@ -202,6 +202,17 @@ class SG_Node : public SG_QList {
    */
   static SG_Node *GetNextScheduled(SG_QList &head);
 
+  /**
+   * Append the scheduled nodes to a list without removing them from the head queue.
+   */
+  static void GetScheduledNodes(SG_QList &head, NodeList &nodes);
+
+  /**
+   * Update the world data of a node returned by GetScheduledNodes, unless it was
+   * already updated by one of its parents. Thread safe for nodes of different famillies.
+   */
+  void UpdateScheduledWorldData(double time);
+
   /**
    * Make this node ready for schedule on next update. This is needed for nodes
    * that must always be updated (slow parent, bone parent)
@@ -335,6 +346,16 @@ class SG_Node : public SG_QList {
   MT_Transform GetWorldTransform() const;
   MT_Transform GetLocalTransform() const;
 
+  /// Save the current world transform as the transform of the previous simulation step.
+  void StorePreviousWorldTransform();
+  /** Blend the previous and current world transforms, the current transform is returned when
+   * no previous transform was stored.
+   * \param factor The blend factor, 0 for the previous transform and 1 for the current one.
+   */
+  MT_Vector3 GetInterpolatedWorldPosition(float factor) const;
+  MT_Matrix3x3 GetInterpolatedWorldOrientation(float factor) const;
+  MT_Transform GetInterpolatedWorldTransform(float factor) const;
+
   bool ComputeWorldTransforms(const SG_Node *parent, bool &parentUpdated);
 
   const std::shared_ptr<SG_Familly> &GetFamilly() const;
@@ -390,6 +411,12 @@ class SG_Node : public SG_QList {
   MT_Matrix3x3 m_worldRotation;
   MT_Vector3 m_worldScaling;
 
+  /// World transform at the previous simulation step, used for interpolation.
+  MT_Vector3 m_prevWorldPosition;
+  MT_Quaternion m_prevWorldRotation;
+  MT_Vector3 m_prevWorldScaling;
+  bool m_prevWorldTransformValid;
+
   std::unique_ptr<SG_ParentRelation> m_parent_relation;
 
   std::shared_ptr<SG_Familly> m_familly;
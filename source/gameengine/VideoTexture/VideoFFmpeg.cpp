@@ -86,7 +86,12 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
       m_isThreaded(false),
       m_isStreaming(false),
       m_stopThread(false),
-      m_cacheStarted(false)
+      m_cacheStarted(false),
+      m_cacheSize(CACHE_FRAME_SIZE),
+      m_droppedFrames(0),
+      m_decodedFrames(0),
+      m_decodeTime(0.0),
+      m_queueTime(0.0)
 {
   // set video format
   m_format = RGB24;
@@ -94,17 +99,22 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
   setFlip(true);
   // construction is OK
   *hRslt = S_OK;
-  BLI_listbase_clear(&m_thread);
+  BLI_listbase_clear(&m_decodeThread);
+  BLI_listbase_clear(&m_convertThread);
   pthread_mutex_init(&m_cacheMutex, nullptr);
+  BLI_condition_init(&m_cacheCond);
   BLI_listbase_clear(&m_frameCacheFree);
   BLI_listbase_clear(&m_frameCacheBase);
-  BLI_listbase_clear(&m_packetCacheFree);
-  BLI_listbase_clear(&m_packetCacheBase);
+  BLI_listbase_clear(&m_decodedCacheFree);
+  BLI_listbase_clear(&m_decodedCacheBase);
 }
 
 // destructor
 VideoFFmpeg::~VideoFFmpeg()
 {
+  // the cache threads are stopped in release()
+  BLI_condition_end(&m_cacheCond);
+  pthread_mutex_destroy(&m_cacheMutex);
 }
 
 void VideoFFmpeg::refresh(void)
@@ -119,7 +129,7 @@ void VideoFFmpeg::refresh(void)
 bool VideoFFmpeg::release()
 {
   // release
-  stopCache();
+  freeCache();
   if (m_codecCtx) {
     avcodec_close(m_codecCtx);
     m_codecCtx = nullptr;
@@ -156,24 +166,12 @@ AVFrame *VideoFFmpeg::allocFrameRGB()
 {
   AVFrame *frame;
   frame = av_frame_alloc();
-  if (m_format == RGBA32) {
-    avpicture_fill((AVPicture *)frame,
-                   (uint8_t *)MEM_callocN(
-                       avpicture_get_size(AV_PIX_FMT_RGBA, m_codecCtx->width, m_codecCtx->height),
-                       "ffmpeg rgba"),
-                   AV_PIX_FMT_RGBA,
-                   m_codecCtx->width,
-                   m_codecCtx->height);
-  }
-  else {
-    avpicture_fill((AVPicture *)frame,
-                   (uint8_t *)MEM_callocN(
-                       avpicture_get_size(AV_PIX_FMT_RGB24, m_codecCtx->width, m_codecCtx->height),
-                       "ffmpeg rgb"),
-                   AV_PIX_FMT_RGB24,
-                   m_codecCtx->width,
-                   m_codecCtx->height);
-  }
+  const AVPixelFormat pixFormat = (m_format == RGBA32) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_RGB24;
+  const int size = avpicture_get_size(pixFormat, m_codecCtx->width, m_codecCtx->height);
+  // aligned buffer for the vectorized conversion of sws_scale and the copy in ImageBase
+  uint8_t *buffer = (uint8_t *)MEM_mallocN_aligned(size, 64, "ffmpeg rgb");
+  memset(buffer, 0, size);
+  avpicture_fill((AVPicture *)frame, buffer, pixFormat, m_codecCtx->width, m_codecCtx->height);
   return frame;
 }
 
@@ -227,6 +225,12 @@ int VideoFFmpeg::openStream(const char *filename,
     return -1;
   }
   codecCtx->workaround_bugs = 1;
+  // let the codec decode with several threads, never frame threading for capture devices
+  // and images because it delays the output of the frames
+  if (!m_isImage) {
+    codecCtx->thread_count = BLI_system_thread_count();
+    codecCtx->thread_type = (inputFormat) ? FF_THREAD_SLICE : (FF_THREAD_FRAME | FF_THREAD_SLICE);
+  }
   if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
     avformat_close_input(&formatCtx);
     return -1;
@@ -311,160 +315,262 @@ int VideoFFmpeg::openStream(const char *filename,
   return 0;
 }
 
+// timestamp of a decoded frame in stream time base
+static int64_t frame_timestamp(AVFrame *frame)
+{
+  // with frame threading, the frames are returned after several packets,
+  // the timestamp of the last packet is not the one of the frame
+  return (frame->best_effort_timestamp != AV_NOPTS_VALUE) ? frame->best_effort_timestamp :
+                                                            frame->pkt_dts;
+}
+
+// true if the decoded frame holds data
+static bool frame_valid(AVFrame *frame)
+{
+  return frame->data[0] != 0 || frame->data[1] != 0 || frame->data[2] != 0 ||
+         frame->data[3] != 0;
+}
+
+VideoFFmpeg::DecodeStatus VideoFFmpeg::decodeFrame(AVFrame *frame)
+{
+  AVPacket packet;
+  while (true) {
+    int ret = avcodec_receive_frame(m_codecCtx, frame);
+    if (ret == 0) {
+      return DecodeFrame;
+    }
+    if (ret != AVERROR(EAGAIN)) {
+      // the decoder is drained
+      return DecodeEnd;
+    }
+    // the decoder needs more packets
+    ret = av_read_frame(m_formatCtx, &packet);
+    if (ret < 0) {
+      if (ret == AVERROR(EAGAIN) || (!m_isFile && !m_isImage)) {
+        // non blocking read or network stream, more data can come later
+        return DecodeAgain;
+      }
+      // end of the file, get the frames buffered in the decoder
+      avcodec_send_packet(m_codecCtx, nullptr);
+      continue;
+    }
+    if (packet.stream_index == m_videoStream) {
+      avcodec_send_packet(m_codecCtx, &packet);
+    }
+    // Note: here we could handle sound packet
+    av_packet_unref(&packet);
+  }
+}
+
+void VideoFFmpeg::convertFrame(AVFrame *input, AVFrame *output)
+{
+  if (m_deinterlace) {
+    if (avpicture_deinterlace((AVPicture *)m_frameDeinterlaced,
+                              (const AVPicture *)input,
+                              m_codecCtx->pix_fmt,
+                              m_codecCtx->width,
+                              m_codecCtx->height) >= 0) {
+      input = m_frameDeinterlaced;
+    }
+  }
+  // convert to RGB24
+  sws_scale(m_imgConvertCtx,
+            input->data,
+            input->linesize,
+            0,
+            m_codecCtx->height,
+            output->data,
+            output->linesize);
+}
+
+long VideoFFmpeg::getFramePosition(AVFrame *frame)
+{
+  AVStream *stream = m_formatCtx->streams[m_videoStream];
+  double timeBase = av_q2d(stream->time_base);
+  int64_t startTs = stream->start_time;
+  if (startTs == AV_NOPTS_VALUE)
+    startTs = 0;
+
+  return (long)((frame_timestamp(frame) - startTs) * (m_baseFrameRate * timeBase) + 0.5);
+}
+
+double VideoFFmpeg::getDecodeLatency(void)
+{
+  pthread_mutex_lock(&m_cacheMutex);
+  const double latency = (m_decodedFrames > 0) ? m_decodeTime / m_decodedFrames : 0.0;
+  pthread_mutex_unlock(&m_cacheMutex);
+  return latency;
+}
+
+double VideoFFmpeg::getQueueLatency(void)
+{
+  pthread_mutex_lock(&m_cacheMutex);
+  const double latency = (m_decodedFrames > 0) ? m_queueTime / m_decodedFrames : 0.0;
+  pthread_mutex_unlock(&m_cacheMutex);
+  return latency;
+}
+
 /*
- * This thread is used to load video frame asynchronously.
- * It provides a frame caching service.
+ * These threads are used to load video frame asynchronously.
+ * They provide a frame caching service.
  * The main thread is responsible for positioning the frame pointer in the
- * file correctly before calling startCache() which starts this thread.
- * The cache is organized in two layers: 1) a cache of 20-30 undecoded packets to keep
- * memory and CPU low 2) a cache of 5 decoded frames.
+ * file correctly before calling startCache() which starts these threads.
+ * The cache is organized in two stages running in their own thread: 1) the decoding of the
+ * packets into a small cache of decoded frames, the codec itself decodes with several threads
+ * 2) the conversion to RGB into a cache of m_cacheSize frames read by the main thread.
  * If the main thread does not find the frame in the cache (because the video has restarted
  * or because the GE is lagging), it stops the cache with StopCache() (this is a synchronous
- * function: it sends a signal to stop the cache thread and wait for confirmation), then
- * change the position in the stream and restarts the cache thread.
+ * function: it sends a signal to stop the cache threads and wait for confirmation), then
+ * change the position in the stream and restarts the cache threads.
  */
-void *VideoFFmpeg::cacheThread(void *data)
+void *VideoFFmpeg::decodeThread(void *data)
 {
   VideoFFmpeg *video = (VideoFFmpeg *)data;
   // holds the frame that is being decoded
   CacheFrame *currentFrame = nullptr;
-  CachePacket *cachePacket;
-  bool endOfFile = false;
-  int frameFinished = 0;
-  double timeBase = av_q2d(video->m_formatCtx->streams[video->m_videoStream]->time_base);
-  int64_t startTs = video->m_formatCtx->streams[video->m_videoStream]->start_time;
-
-  if (startTs == AV_NOPTS_VALUE)
-    startTs = 0;
 
   while (!video->m_stopThread) {
-    // packet cache is used solely by this thread, no need to lock
-    // In case the stream/file contains other stream than the one we are looking for,
-    // allow a bit of cycling to get rid quickly of those frames
-    frameFinished = 0;
-    while (!endOfFile &&
-           (cachePacket = (CachePacket *)video->m_packetCacheFree.first) != nullptr &&
-           frameFinished < 25) {
-      // free packet => packet cache is not full yet, just read more
-      if (av_read_frame(video->m_formatCtx, &cachePacket->packet) >= 0) {
-        if (cachePacket->packet.stream_index == video->m_videoStream) {
-          // make sure fresh memory is allocated for the packet and move it to queue
-          av_dup_packet(&cachePacket->packet);
-          BLI_remlink(&video->m_packetCacheFree, cachePacket);
-          BLI_addtail(&video->m_packetCacheBase, cachePacket);
-          break;
-        }
-        else {
-          // this is not a good packet for us, just leave it on free queue
-          // Note: here we could handle sound packet
-          av_free_packet(&cachePacket->packet);
-          frameFinished++;
-        }
-      }
-      else {
-        if (video->m_isFile)
-          // this mark the end of the file
-          endOfFile = true;
-        // if we cannot read a packet, no need to continue
-        break;
-      }
-    }
-    // frame cache is also used by main thread, lock
     if (currentFrame == nullptr) {
-      // no current frame being decoded, take free one
+      // no current frame being decoded, wait for a free one
       pthread_mutex_lock(&video->m_cacheMutex);
-      if ((currentFrame = (CacheFrame *)video->m_frameCacheFree.first) != nullptr)
-        BLI_remlink(&video->m_frameCacheFree, currentFrame);
-      pthread_mutex_unlock(&video->m_cacheMutex);
-    }
-    if (currentFrame != nullptr) {
-      // this frame is out of free and busy queue, we can manipulate it without locking
-      frameFinished = 0;
-      while (!frameFinished &&
-             (cachePacket = (CachePacket *)video->m_packetCacheBase.first) != nullptr) {
-        BLI_remlink(&video->m_packetCacheBase, cachePacket);
-        // use m_frame because when caching, it is not used in main thread
-        // we can't use currentFrame directly because we need to convert to RGB first
-        avcodec_decode_video2(
-            video->m_codecCtx, video->m_frame, &frameFinished, &cachePacket->packet);
-        if (frameFinished) {
-          AVFrame *input = video->m_frame;
-
-          /* This means the data wasnt read properly, this check stops crashing */
-          if (input->data[0] != 0 || input->data[1] != 0 || input->data[2] != 0 ||
-              input->data[3] != 0) {
-            if (video->m_deinterlace) {
-              if (avpicture_deinterlace((AVPicture *)video->m_frameDeinterlaced,
-                                        (const AVPicture *)video->m_frame,
-                                        video->m_codecCtx->pix_fmt,
-                                        video->m_codecCtx->width,
-                                        video->m_codecCtx->height) >= 0) {
-                input = video->m_frameDeinterlaced;
-              }
-            }
-            // convert to RGB24
-            sws_scale(video->m_imgConvertCtx,
-                      input->data,
-                      input->linesize,
-                      0,
-                      video->m_codecCtx->height,
-                      currentFrame->frame->data,
-                      currentFrame->frame->linesize);
-            // move frame to queue, this frame is necessarily the next one
-            video->m_curPosition = (long)((cachePacket->packet.dts - startTs) *
-                                              (video->m_baseFrameRate * timeBase) +
-                                          0.5);
-            currentFrame->framePosition = video->m_curPosition;
-            pthread_mutex_lock(&video->m_cacheMutex);
-            BLI_addtail(&video->m_frameCacheBase, currentFrame);
-            pthread_mutex_unlock(&video->m_cacheMutex);
-            currentFrame = nullptr;
-          }
-        }
-        av_free_packet(&cachePacket->packet);
-        BLI_addtail(&video->m_packetCacheFree, cachePacket);
+      while (!video->m_stopThread &&
+             (currentFrame = (CacheFrame *)video->m_decodedCacheFree.first) == nullptr) {
+        BLI_condition_wait(&video->m_cacheCond, &video->m_cacheMutex);
       }
-      if (currentFrame && endOfFile) {
-        // no more packet and end of file => put a special frame that indicates that
-        currentFrame->framePosition = -1;
-        pthread_mutex_lock(&video->m_cacheMutex);
-        BLI_addtail(&video->m_frameCacheBase, currentFrame);
-        pthread_mutex_unlock(&video->m_cacheMutex);
-        currentFrame = nullptr;
-        // no need to stay any longer in this thread
+      if (currentFrame != nullptr)
+        BLI_remlink(&video->m_decodedCacheFree, currentFrame);
+      pthread_mutex_unlock(&video->m_cacheMutex);
+      if (currentFrame == nullptr)
         break;
+    }
+    // this frame is out of free and busy queue, we can manipulate it without locking
+    currentFrame->startTime = PIL_check_seconds_timer();
+    const DecodeStatus status = video->decodeFrame(currentFrame->frame);
+    if (status == DecodeAgain) {
+      // small sleep to avoid unnecessary looping
+      PIL_sleep_ms(5);
+      continue;
+    }
+    if (status == DecodeFrame) {
+      /* This means the data wasnt read properly, this check stops crashing */
+      if (!frame_valid(currentFrame->frame)) {
+        av_frame_unref(currentFrame->frame);
+        continue;
       }
+      // move frame to queue, this frame is necessarily the next one
+      video->m_curPosition = video->getFramePosition(currentFrame->frame);
+      currentFrame->framePosition = video->m_curPosition;
+    }
+    else {
+      // no more frame and end of file => put a special frame that indicates that
+      currentFrame->framePosition = -1;
+    }
+    currentFrame->decodedTime = PIL_check_seconds_timer();
+    pthread_mutex_lock(&video->m_cacheMutex);
+    BLI_addtail(&video->m_decodedCacheBase, currentFrame);
+    BLI_condition_notify_all(&video->m_cacheCond);
+    pthread_mutex_unlock(&video->m_cacheMutex);
+    currentFrame = nullptr;
+    if (status == DecodeEnd) {
+      // no need to stay any longer in this thread
+      break;
     }
-    // small sleep to avoid unnecessary looping
-    PIL_sleep_ms(10);
   }
   // before quitting, put back the current frame to queue to allow freeing
   if (currentFrame) {
+    av_frame_unref(currentFrame->frame);
+    pthread_mutex_lock(&video->m_cacheMutex);
+    BLI_addtail(&video->m_decodedCacheFree, currentFrame);
+    pthread_mutex_unlock(&video->m_cacheMutex);
+  }
+  return 0;
+}
+
+void *VideoFFmpeg::convertThread(void *data)
+{
+  VideoFFmpeg *video = (VideoFFmpeg *)data;
+
+  while (true) {
+    CacheFrame *decodedFrame = nullptr;
+    CacheFrame *currentFrame = nullptr;
+
+    // wait for a decoded frame and a free frame to convert it into
     pthread_mutex_lock(&video->m_cacheMutex);
-    BLI_addtail(&video->m_frameCacheFree, currentFrame);
+    while (!video->m_stopThread && (video->m_decodedCacheBase.first == nullptr ||
+                                    video->m_frameCacheFree.first == nullptr)) {
+      BLI_condition_wait(&video->m_cacheCond, &video->m_cacheMutex);
+    }
+    if (!video->m_stopThread) {
+      decodedFrame = (CacheFrame *)video->m_decodedCacheBase.first;
+      currentFrame = (CacheFrame *)video->m_frameCacheFree.first;
+      BLI_remlink(&video->m_decodedCacheBase, decodedFrame);
+      BLI_remlink(&video->m_frameCacheFree, currentFrame);
+    }
+    pthread_mutex_unlock(&video->m_cacheMutex);
+
+    if (decodedFrame == nullptr)
+      break;
+
+    // both frames are out of the queues, we can manipulate them without locking
+    const double convertStartTime = PIL_check_seconds_timer();
+    const bool endOfFile = (decodedFrame->framePosition == -1);
+    currentFrame->framePosition = decodedFrame->framePosition;
+    if (!endOfFile) {
+      video->convertFrame(decodedFrame->frame, currentFrame->frame);
+      av_frame_unref(decodedFrame->frame);
+    }
+    // the wait for a free converted frame is the back-pressure of the display, not decoding
+    const double decodeTime = (decodedFrame->decodedTime - decodedFrame->startTime) +
+                              (PIL_check_seconds_timer() - convertStartTime);
+    const double queueTime = convertStartTime - decodedFrame->decodedTime;
+
+    pthread_mutex_lock(&video->m_cacheMutex);
+    if (!endOfFile) {
+      video->m_decodeTime += decodeTime;
+      video->m_queueTime += queueTime;
+      ++video->m_decodedFrames;
+    }
+    BLI_addtail(&video->m_decodedCacheFree, decodedFrame);
+    BLI_addtail(&video->m_frameCacheBase, currentFrame);
+    BLI_condition_notify_all(&video->m_cacheCond);
     pthread_mutex_unlock(&video->m_cacheMutex);
+
+    if (endOfFile)
+      break;
   }
   return 0;
 }
 
-// start thread to cache video frame from file/capture/stream
+// start threads to cache video frame from file/capture/stream
 // this function should be called only when the position in the stream is set for the
 // first frame to cache
 bool VideoFFmpeg::startCache()
 {
   if (!m_cacheStarted && m_isThreaded) {
     m_stopThread = false;
-    for (int i = 0; i < CACHE_FRAME_SIZE; i++) {
-      CacheFrame *frame = new CacheFrame();
+    // the frames of the previous start are reused, only adjust their number
+    CacheFrame *frame;
+    for (int i = BLI_listbase_count(&m_frameCacheFree); i < m_cacheSize; i++) {
+      frame = new CacheFrame();
       frame->frame = allocFrameRGB();
       BLI_addtail(&m_frameCacheFree, frame);
     }
-    for (int i = 0; i < CACHE_PACKET_SIZE; i++) {
-      CachePacket *packet = new CachePacket();
-      BLI_addtail(&m_packetCacheFree, packet);
+    for (int i = BLI_listbase_count(&m_frameCacheFree); i > m_cacheSize; i--) {
+      frame = (CacheFrame *)m_frameCacheFree.last;
+      BLI_remlink(&m_frameCacheFree, frame);
+      MEM_freeN(frame->frame->data[0]);
+      av_free(frame->frame);
+      delete frame;
+    }
+    for (int i = BLI_listbase_count(&m_decodedCacheFree); i < CACHE_DECODED_SIZE; i++) {
+      frame = new CacheFrame();
+      frame->frame = av_frame_alloc();
+      BLI_addtail(&m_decodedCacheFree, frame);
     }
-    BLI_threadpool_init(&m_thread, cacheThread, 1);
-    BLI_threadpool_insert(&m_thread, this);
+    BLI_threadpool_init(&m_decodeThread, decodeThread, 1);
+    BLI_threadpool_insert(&m_decodeThread, this);
+    BLI_threadpool_init(&m_convertThread, convertThread, 1);
+    BLI_threadpool_insert(&m_convertThread, this);
     m_cacheStarted = true;
   }
   return m_cacheStarted;
@@ -473,36 +579,44 @@ bool VideoFFmpeg::startCache()
 void VideoFFmpeg::stopCache()
 {
   if (m_cacheStarted) {
+    pthread_mutex_lock(&m_cacheMutex);
     m_stopThread = true;
-    BLI_threadpool_end(&m_thread);
-    // now delete the cache
+    BLI_condition_notify_all(&m_cacheCond);
+    pthread_mutex_unlock(&m_cacheMutex);
+    BLI_threadpool_end(&m_decodeThread);
+    BLI_threadpool_end(&m_convertThread);
+    // now empty the cache, the frames are kept for the next start
     CacheFrame *frame;
-    CachePacket *packet;
     while ((frame = (CacheFrame *)m_frameCacheBase.first) != nullptr) {
       BLI_remlink(&m_frameCacheBase, frame);
-      MEM_freeN(frame->frame->data[0]);
-      av_free(frame->frame);
-      delete frame;
-    }
-    while ((frame = (CacheFrame *)m_frameCacheFree.first) != nullptr) {
-      BLI_remlink(&m_frameCacheFree, frame);
-      MEM_freeN(frame->frame->data[0]);
-      av_free(frame->frame);
-      delete frame;
-    }
-    while ((packet = (CachePacket *)m_packetCacheBase.first) != nullptr) {
-      BLI_remlink(&m_packetCacheBase, packet);
-      av_free_packet(&packet->packet);
-      delete packet;
+      BLI_addtail(&m_frameCacheFree, frame);
     }
-    while ((packet = (CachePacket *)m_packetCacheFree.first) != nullptr) {
-      BLI_remlink(&m_packetCacheFree, packet);
-      delete packet;
+    while ((frame = (CacheFrame *)m_decodedCacheBase.first) != nullptr) {
+      BLI_remlink(&m_decodedCacheBase, frame);
+      av_frame_unref(frame->frame);
+      BLI_addtail(&m_decodedCacheFree, frame);
     }
     m_cacheStarted = false;
   }
 }
 
+void VideoFFmpeg::freeCache()
+{
+  stopCache();
+  CacheFrame *frame;
+  while ((frame = (CacheFrame *)m_frameCacheFree.first) != nullptr) {
+    BLI_remlink(&m_frameCacheFree, frame);
+    MEM_freeN(frame->frame->data[0]);
+    av_free(frame->frame);
+    delete frame;
+  }
+  while ((frame = (CacheFrame *)m_decodedCacheFree.first) != nullptr) {
+    BLI_remlink(&m_decodedCacheFree, frame);
+    av_frame_free(&frame->frame);
+    delete frame;
+  }
+}
+
 void VideoFFmpeg::releaseFrame(AVFrame *frame)
 {
   if (frame == m_frameRGB) {
@@ -515,6 +629,7 @@ void VideoFFmpeg::releaseFrame(AVFrame *frame)
   assert(cacheFrame != nullptr && cacheFrame->frame == frame);
   BLI_remlink(&m_frameCacheBase, cacheFrame);
   BLI_addtail(&m_frameCacheFree, cacheFrame);
+  BLI_condition_notify_all(&m_cacheCond);
   pthread_mutex_unlock(&m_cacheMutex);
 }
 
@@ -832,13 +947,10 @@ void VideoFFmpeg::setPositions(void)
 // position pointer in file, position in second
 AVFrame *VideoFFmpeg::grabFrame(long position)
 {
-  AVPacket packet;
-  int frameFinished;
   int posFound = 1;
   bool frameLoaded = false;
   int64_t targetTs = 0;
   CacheFrame *frame;
-  int64_t dts = 0;
 
   if (m_cacheStarted) {
     // when cache is active, we must not read the file directly
@@ -879,7 +991,9 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
       pthread_mutex_lock(&m_cacheMutex);
       BLI_remlink(&m_frameCacheBase, frame);
       BLI_addtail(&m_frameCacheFree, frame);
+      BLI_condition_notify_all(&m_cacheCond);
       pthread_mutex_unlock(&m_cacheMutex);
+      ++m_droppedFrames;
     } while (true);
   }
   double timeBase = av_q2d(m_formatCtx->streams[m_videoStream]->time_base);
@@ -893,14 +1007,8 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
     // first check if the position that we are looking for is in the preseek range
     // if so, just read the frame until we get there
     if (position > m_curPosition + 1 && m_preseek && position - (m_curPosition + 1) < m_preseek) {
-      while (av_read_frame(m_formatCtx, &packet) >= 0) {
-        if (packet.stream_index == m_videoStream) {
-          avcodec_decode_video2(m_codecCtx, m_frame, &frameFinished, &packet);
-          if (frameFinished) {
-            m_curPosition = (long)((packet.dts - startTs) * (m_baseFrameRate * timeBase) + 0.5);
-          }
-        }
-        av_free_packet(&packet);
+      while (decodeFrame(m_frame) == DecodeFrame) {
+        m_curPosition = getFramePosition(m_frame);
         if (position == m_curPosition + 1)
           break;
       }
@@ -959,66 +1067,26 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
 
   // find the correct frame, in case of streaming and no cache, it means just
   // return the next frame. This is not quite correct, may need more work
-  while (av_read_frame(m_formatCtx, &packet) >= 0) {
-    if (packet.stream_index == m_videoStream) {
-      AVFrame *input = m_frame;
-      short counter = 0;
-
-      /* If m_isImage, while the data is not read properly (png, tiffs, etc formats may need
-       * several pass), else don't need while loop*/
-      do {
-        avcodec_decode_video2(m_codecCtx, m_frame, &frameFinished, &packet);
-        counter++;
-      } while ((input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 &&
-                input->data[3] == 0) &&
-               counter < 10 && m_isImage);
-
-      // remember dts to compute exact frame number
-      dts = packet.dts;
-      if (frameFinished && !posFound) {
-        if (dts >= targetTs) {
-          posFound = 1;
-        }
-      }
-
-      if (frameFinished && posFound == 1) {
-        AVFrame *input = m_frame;
-
-        /* This means the data wasnt read properly,
-         * this check stops crashing */
-        if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 &&
-            input->data[3] == 0) {
-          av_free_packet(&packet);
-          break;
-        }
+  while (decodeFrame(m_frame) == DecodeFrame) {
+    if (!posFound && frame_timestamp(m_frame) >= targetTs) {
+      posFound = 1;
+    }
 
-        if (m_deinterlace) {
-          if (avpicture_deinterlace((AVPicture *)m_frameDeinterlaced,
-                                    (const AVPicture *)m_frame,
-                                    m_codecCtx->pix_fmt,
-                                    m_codecCtx->width,
-                                    m_codecCtx->height) >= 0) {
-            input = m_frameDeinterlaced;
-          }
-        }
-        // convert to RGB24
-        sws_scale(m_imgConvertCtx,
-                  input->data,
-                  input->linesize,
-                  0,
-                  m_codecCtx->height,
-                  m_frameRGB->data,
-                  m_frameRGB->linesize);
-        av_free_packet(&packet);
-        frameLoaded = true;
+    if (posFound == 1) {
+      /* This means the data wasnt read properly,
+       * this check stops crashing */
+      if (!frame_valid(m_frame)) {
         break;
       }
+
+      convertFrame(m_frame, m_frameRGB);
+      frameLoaded = true;
+      break;
     }
-    av_free_packet(&packet);
   }
   m_eof = m_isFile && !frameLoaded;
   if (frameLoaded) {
-    m_curPosition = (long)((dts - startTs) * (m_baseFrameRate * timeBase) + 0.5);
+    m_curPosition = getFramePosition(m_frame);
     if (m_isThreaded) {
       // normal case for file: first locate, then start cache
       if (!startCache()) {
@@ -1122,6 +1190,44 @@ static int VideoFFmpeg_setDeinterlace(PyImage *self, PyObject *value, void *clos
   return 0;
 }
 
+// get cache size
+static PyObject *VideoFFmpeg_getCacheSize(PyImage *self, void *closure)
+{
+  return Py_BuildValue("i", getFFmpeg(self)->getCacheSize());
+}
+
+// set cache size
+static int VideoFFmpeg_setCacheSize(PyImage *self, PyObject *value, void *closure)
+{
+  // check validity of parameter
+  if (value == nullptr || !PyLong_Check(value) || PyLong_AsLong(value) < 1) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a positive integer");
+    return -1;
+  }
+  // set cache size
+  getFFmpeg(self)->setCacheSize(PyLong_AsLong(value));
+  // success
+  return 0;
+}
+
+// get dropped frames
+static PyObject *VideoFFmpeg_getDroppedFrames(PyImage *self, void *closure)
+{
+  return PyLong_FromUnsignedLong(getFFmpeg(self)->getDroppedFrames());
+}
+
+// get decode latency
+static PyObject *VideoFFmpeg_getDecodeLatency(PyImage *self, void *closure)
+{
+  return PyFloat_FromDouble(getFFmpeg(self)->getDecodeLatency());
+}
+
+// get queue latency
+static PyObject *VideoFFmpeg_getQueueLatency(PyImage *self, void *closure)
+{
+  return PyFloat_FromDouble(getFFmpeg(self)->getQueueLatency());
+}
+
 // methods structure
 static PyMethodDef videoMethods[] = {  // methods from VideoBase class
     {"play", (PyCFunction)Video_play, METH_NOARGS, "Play (restart) video"},
@@ -1180,6 +1286,26 @@ static PyGetSetDef videoGetSets[] = {  // methods from VideoBase class
      (setter)VideoFFmpeg_setDeinterlace,
      (char *)"deinterlace image",
      nullptr},
+    {(char *)"cacheSize",
+     (getter)VideoFFmpeg_getCacheSize,
+     (setter)VideoFFmpeg_setCacheSize,
+     (char *)"nb of decoded frames in cache",
+     nullptr},
+    {(char *)"droppedFrames",
+     (getter)VideoFFmpeg_getDroppedFrames,
+     nullptr,
+     (char *)"nb of frames skipped because decoded too late",
+     nullptr},
+    {(char *)"decodeLatency",
+     (getter)VideoFFmpeg_getDecodeLatency,
+     nullptr,
+     (char *)"average time in seconds to decode and convert a frame",
+     nullptr},
+    {(char *)"queueLatency",
+     (getter)VideoFFmpeg_getQueueLatency,
+     nullptr,
+     (char *)"average time in seconds a decoded frame waits for its conversion",
+     nullptr},
     {nullptr}};
 
 // python type declaration
@@ -64,8 +64,10 @@ static inline AVCodecContext *get_codec_from_stream(AVStream *stream)
 
 #  include "VideoBase.h"
 
+/// default number of converted frames in cache
 #  define CACHE_FRAME_SIZE 10
-#  define CACHE_PACKET_SIZE 30
+/// number of decoded frames waiting for the conversion
+#  define CACHE_DECODED_SIZE 4
 
 // type VideoFFmpeg declaration
 class VideoFFmpeg : public VideoBase {
@@ -118,6 +120,25 @@ class VideoFFmpeg : public VideoBase {
   {
     return (m_isImage) ? (char *)m_imageName.c_str() : nullptr;
   }
+  int getCacheSize(void)
+  {
+    return m_cacheSize;
+  }
+  /// set the number of converted frames in cache, used at the next start of the cache
+  void setCacheSize(int size)
+  {
+    if (size > 0)
+      m_cacheSize = size;
+  }
+  /// number of frames skipped because they were decoded too late
+  unsigned int getDroppedFrames(void)
+  {
+    return m_droppedFrames;
+  }
+  /// average time in seconds spent to decode and convert a frame
+  double getDecodeLatency(void);
+  /// average time in seconds a decoded frame waits for its conversion
+  double getQueueLatency(void);
 
  protected:
   // format and codec information
@@ -197,35 +218,67 @@ class VideoFFmpeg : public VideoBase {
   /// retrieved
   AVFrame *grabFrame(long frame);
 
+  enum DecodeStatus {
+    /// a frame was decoded
+    DecodeFrame,
+    /// no data is available yet from the stream or capture
+    DecodeAgain,
+    /// end of the stream, all the frames were decoded
+    DecodeEnd
+  };
+
+  /// read packets and decode them until the next frame of the video stream is decoded
+  DecodeStatus decodeFrame(AVFrame *frame);
+  /// deinterlace if needed and convert a decoded frame to RGB
+  void convertFrame(AVFrame *input, AVFrame *output);
+  /// position of a decoded frame expressed in frame number
+  long getFramePosition(AVFrame *frame);
+
   /// in case of caching, put the frame back in free queue
   void releaseFrame(AVFrame *frame);
 
-  /// start thread to load the video file/capture/stream
+  /// start threads to load the video file/capture/stream
   bool startCache();
   void stopCache();
+  /// stop the cache and free its frames
+  void freeCache();
 
  private:
   typedef struct {
     Link link;
     long framePosition;
     AVFrame *frame;
+    // time at which the decoding of the frame started
+    double startTime;
+    // time at which the frame was queued for conversion
+    double decodedTime;
   } CacheFrame;
-  typedef struct {
-    Link link;
-    AVPacket packet;
-  } CachePacket;
 
   bool m_stopThread;
   bool m_cacheStarted;
-  ListBase m_thread;
-  ListBase m_frameCacheBase;   // list of frames that are ready
-  ListBase m_frameCacheFree;   // list of frames that are unused
-  ListBase m_packetCacheBase;  // list of packets that are ready for decoding
-  ListBase m_packetCacheFree;  // list of packets that are unused
+  // number of converted frames allocated when starting the cache
+  int m_cacheSize;
+  ListBase m_decodeThread;
+  ListBase m_convertThread;
+  ListBase m_frameCacheBase;    // list of frames that are ready
+  ListBase m_frameCacheFree;    // list of frames that are unused
+  ListBase m_decodedCacheBase;  // list of decoded frames that are ready for conversion
+  ListBase m_decodedCacheFree;  // list of decoded frames that are unused
   pthread_mutex_t m_cacheMutex;
+  // signaled when a cache list changed or the threads must stop
+  ThreadCondition m_cacheCond;
+
+  // statistics
+  unsigned int m_droppedFrames;
+  unsigned int m_decodedFrames;
+  double m_decodeTime;
+  double m_queueTime;
 
   AVFrame *allocFrameRGB();
-  static void *cacheThread(void *);
+  // read and decode the frames into the decoded cache
+  static void *decodeThread(void *);
+  // convert the decoded frames into the frame cache
+  static void *convertThread(void *);
 };
 
 inline VideoFFmpeg *getFFmpeg(PyImage *self)